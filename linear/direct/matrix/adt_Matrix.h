@@ -6,75 +6,322 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(MATRIX_NO_SIMD)
+#include <immintrin.h>
+#define MATRIX_SIMD
+#endif
+
+/**
+ * @brief Byte alignment of a matrix's element storage.
+ * @note 64 bytes is one cache line and a multiple of every SIMD register width.
+ * @note Define this before including the header to override the default.
+ */
+#ifndef MATRIX_ALIGNMENT
+#define MATRIX_ALIGNMENT 64
+#endif
+
+/**
+ * @brief Header of an allocation that did not fit in a MatrixArena's block.
+ * @note This is a private helper type. The allocation follows the header.
+ */
+typedef struct __ArenaChunk__
+{
+    struct __ArenaChunk__ *next;
+} __ArenaChunk__;
+
+/**
+ * @struct MatrixArena
+ * @brief A bump allocator from which matrices can be allocated and then released all at once.
+ * @var block The main block, MATRIX_ALIGNMENT-aligned.
+ * @var size The size of the block in bytes.
+ * @var used The number of bytes of the block handed out since the last reset.
+ * @var overflow The allocations that did not fit in the block, most recent first.
+ * @var spilled The total size of the overflow allocations.
+ * @note An arena is not thread-safe: use one arena per thread.
+ */
+typedef struct
+{
+    char *block;
+    size_t size;
+    size_t used;
+    __ArenaChunk__ *overflow;
+    size_t spilled;
+} MatrixArena;
 
 /**
  * @struct Matrix
  * @brief Represents a two-dimensional matrix of double-precision floating-point numbers.
- * @var grid A double pointer to the 2D array holding the matrix elements.
+ * @var grid Row pointers into `data`, so that `grid[i][j]` addresses element (i, j).
+ * @var data The elements in row-major order, `stride` doubles apart from one row to the next.
  * @var rows The number of rows in the matrix.
  * @var columns The number of columns in the matrix.
+ * @var stride The leading dimension: the distance in elements between the starts of two rows.
+ * It equals `columns` unless spare column capacity has been reserved.
+ * @var capacity The number of rows that fit in the storage, at least `rows`.
+ * @var storage The separate allocation that holds `grid` and `data` once a matrix has grown past
+ * its initial allocation (see reserve), or NULL while they share the matrix's own block.
+ * @var mapping The file mapping that holds `data` for a matrix returned by mmapLoad, or NULL
+ * when the matrix owns its elements.
+ * @var mappedSize The size in bytes of `mapping`.
+ * @var arena The arena the matrix was allocated from, or NULL if it was allocated with calloc.
  */
 typedef struct
 {
     double **grid;
+    double *data;
     int rows;
     int columns;
+    int stride;
+    int capacity;
+    void *storage;
+    void *mapping;
+    size_t mappedSize;
+    MatrixArena *arena;
 } Matrix;
 
 /**
- * @brief Initializes and allocates memory for a new matrix.
- * @param rows The number of rows for the new matrix. Must be greater than 0.
- * @param columns The number of columns for the new matrix. Must be greater than 0.
- * @return A pointer to the newly created Matrix, or NULL if allocation fails or dimensions are invalid.
+ * @struct MatrixView
+ * @brief A non-owning, strided window onto the elements of a matrix.
+ * @var data The address of element (0, 0) of the view, or NULL for an empty (invalid) view.
+ * @var rows The number of rows in the view.
+ * @var columns The number of columns in the view.
+ * @var rowStride The distance in elements between two consecutive rows.
+ * @var columnStride The distance in elements between two consecutive columns.
+ * @note Element (i, j) of a view lives at `data[i * rowStride + j * columnStride]`. A view never
+ * owns memory: it is only valid while the matrix it was taken from is alive, and writes through
+ * a view modify that matrix.
  */
-Matrix *init(const int rows, const int columns)
+typedef struct
 {
-    if (rows <= 0 || columns <= 0)
-        return NULL;
+    double *data;
+    int rows;
+    int columns;
+    int rowStride;
+    int columnStride;
+} MatrixView;
 
-    Matrix *matrix = (Matrix *)malloc(sizeof(Matrix));
-    if (matrix == NULL)
+/**
+ * @brief Rounds a size up to a multiple of MATRIX_ALIGNMENT.
+ * @param bytes The size.
+ * @return The rounded size.
+ * @note This is a private helper function.
+ */
+size_t __alignSize__(const size_t bytes)
+{
+    return (bytes + MATRIX_ALIGNMENT - 1) & ~(size_t)(MATRIX_ALIGNMENT - 1);
+}
+
+/**
+ * @brief Initializes a matrix arena.
+ * @param capacity The size in bytes of the arena's block. It grows at the next reset if a round
+ * of allocations overflows it.
+ * @return A pointer to the new arena, or NULL if allocation fails or capacity is 0.
+ */
+MatrixArena *arenaInit(const size_t capacity)
+{
+    if (capacity == 0)
         return NULL;
 
-    matrix->grid = (double **)malloc(rows * sizeof(double *));
-    if (matrix->grid == NULL)
+    MatrixArena *arena = (MatrixArena *)malloc(sizeof(MatrixArena));
+    if (arena == NULL)
+        return NULL;
+    arena->size = __alignSize__(capacity);
+    arena->block = (char *)aligned_alloc(MATRIX_ALIGNMENT, arena->size);
+    if (arena->block == NULL)
     {
-        free(matrix);
+        free(arena);
         return NULL;
     }
+    arena->used = 0;
+    arena->overflow = NULL;
+    arena->spilled = 0;
+    return arena;
+}
 
-    for (int i = 0; i < rows; i++)
+/**
+ * @brief Releases every allocation made from an arena since the last reset, at once.
+ * @param arena The arena. If NULL, the function does nothing.
+ * @note Matrices allocated from the arena must not be used afterwards. If the last round of
+ * allocations overflowed the block, the block is enlarged to hold all of it, so that a steady
+ * workload stops calling malloc after its first round.
+ */
+void arenaReset(MatrixArena *arena)
+{
+    if (arena == NULL)
+        return;
+
+    while (arena->overflow != NULL)
+    {
+        __ArenaChunk__ *next = arena->overflow->next;
+        free(arena->overflow);
+        arena->overflow = next;
+    }
+    if (arena->spilled > 0)
     {
-        matrix->grid[i] = (double *)calloc(columns, sizeof(double));
-        if (matrix->grid[i] == NULL)
+        size_t size = __alignSize__(arena->size + arena->spilled);
+        char *block = (char *)aligned_alloc(MATRIX_ALIGNMENT, size);
+        if (block != NULL)
         {
-            for (int j = 0; j < i; j++)
-                free(matrix->grid[j]);
-            free(matrix->grid);
-            free(matrix);
-            return NULL;
+            free(arena->block);
+            arena->block = block;
+            arena->size = size;
         }
     }
+    arena->used = 0;
+    arena->spilled = 0;
+}
+
+/**
+ * @brief Frees an arena and everything allocated from it.
+ * @param arena The arena. If NULL, the function does nothing.
+ * @note The arena must not be in use (see useArena) by any thread.
+ */
+void arenaDestroy(MatrixArena *arena)
+{
+    if (arena == NULL)
+        return;
+    arenaReset(arena);
+    free(arena->block);
+    free(arena);
+}
+
+/**
+ * @brief Allocates zero-filled, MATRIX_ALIGNMENT-aligned memory from an arena.
+ * @param arena The arena.
+ * @param bytes The number of bytes.
+ * @return A pointer to the memory, or NULL if an overflow allocation fails.
+ * @note This is a private helper function. Requests that do not fit in the block are served by
+ * malloc and recorded, so they are freed at the next reset.
+ */
+void *__arenaAlloc__(MatrixArena *arena, const size_t bytes)
+{
+    size_t size = __alignSize__(bytes);
+    char *memory;
+    if (arena->size - arena->used >= size)
+    {
+        memory = arena->block + arena->used;
+        arena->used += size;
+    }
+    else
+    {
+        size_t header = __alignSize__(sizeof(__ArenaChunk__));
+        __ArenaChunk__ *chunk = (__ArenaChunk__ *)aligned_alloc(MATRIX_ALIGNMENT, header + size);
+        if (chunk == NULL)
+            return NULL;
+        chunk->next = arena->overflow;
+        arena->overflow = chunk;
+        arena->spilled += header + size;
+        memory = (char *)chunk + header;
+    }
+    memset(memory, 0, bytes);
+    return memory;
+}
+
+/**
+ * @brief Returns the calling thread's current arena.
+ * @return A pointer to the thread-local slot that holds the arena, or NULL when none is in use.
+ * @note This is a private helper function.
+ */
+MatrixArena **__arenaCurrent__()
+{
+    static _Thread_local MatrixArena *current = NULL;
+    return &current;
+}
 
+/**
+ * @brief Makes init, and therefore every function that returns a new Matrix, allocate from an arena.
+ * @param arena The arena to use on the calling thread, or NULL to go back to calloc.
+ * @return The arena that was in use before, so that calls can be nested.
+ * @note The setting is per thread. destroy does nothing for a matrix allocated from an arena;
+ * its memory comes back with arenaReset. Temporaries that functions such as inverse or strassen
+ * create and destroy internally therefore also stay in the arena until the reset.
+ * @note Only Matrix structs come from the arena; arrays returned by functions such as flatten and
+ * getField are still allocated with malloc and must be freed.
+ */
+MatrixArena *useArena(MatrixArena *arena)
+{
+    MatrixArena *previous = *__arenaCurrent__();
+    *__arenaCurrent__() = arena;
+    return previous;
+}
+
+/**
+ * @brief Initializes and allocates memory for a new matrix.
+ * @param rows The number of rows for the new matrix. Must be greater than 0.
+ * @param columns The number of columns for the new matrix. Must be greater than 0.
+ * @return A pointer to the newly created Matrix, or NULL if allocation fails or dimensions are invalid.
+ * @note The struct, the row pointer table and the zero-filled elements share a single allocation.
+ * The elements are contiguous (`stride == columns`) and start on a MATRIX_ALIGNMENT boundary.
+ * @note The allocation comes from the calling thread's arena if one is in use (see useArena).
+ */
+Matrix *init(const int rows, const int columns)
+{
+    if (rows <= 0 || columns <= 0)
+        return NULL;
+
+    size_t header = sizeof(Matrix) + (size_t)rows * sizeof(double *);
+    size_t elements = (size_t)rows * (size_t)columns * sizeof(double);
+    MatrixArena *arena = *__arenaCurrent__();
+    char *block = arena != NULL ? (char *)__arenaAlloc__(arena, header + MATRIX_ALIGNMENT - 1 + elements)
+                                : (char *)calloc(1, header + MATRIX_ALIGNMENT - 1 + elements);
+    if (block == NULL)
+        return NULL;
+
+    Matrix *matrix = (Matrix *)block;
+    matrix->arena = arena;
+    matrix->grid = (double **)(block + sizeof(Matrix));
+    matrix->data = (double *)(((uintptr_t)(block + header) + MATRIX_ALIGNMENT - 1) & ~(uintptr_t)(MATRIX_ALIGNMENT - 1));
     matrix->rows = rows;
     matrix->columns = columns;
+    matrix->stride = columns;
+    matrix->capacity = rows;
+    for (int i = 0; i < rows; i++)
+        matrix->grid[i] = matrix->data + (size_t)i * columns;
     return matrix;
 }
 
 /**
  * @brief Frees the memory allocated for a matrix.
  * @param matrix The matrix to be destroyed. If NULL, the function does nothing.
+ * @note A matrix returned by mmapLoad is unmapped from its file instead, and a matrix allocated
+ * from an arena is left for arenaReset to release.
  */
 void destroy(Matrix *matrix)
 {
-    if (matrix == NULL)
+    if (matrix == NULL || matrix->arena != NULL)
         return;
-    for (int i = 0; i < matrix->rows; i++)
-        free(matrix->grid[i]);
-    free(matrix->grid);
+    if (matrix->mapping != NULL)
+        munmap(matrix->mapping, matrix->mappedSize);
+    free(matrix->storage);
     free(matrix);
 }
 
+/**
+ * @brief Copies the elements of a matrix into an existing matrix of the same shape.
+ * @param destination The matrix that receives the copy.
+ * @param matrix The source matrix.
+ * @return true on success, false if either matrix is NULL or their shapes differ.
+ */
+bool copyInto(Matrix *destination, const Matrix *matrix)
+{
+    if (destination == NULL || matrix == NULL || destination->rows != matrix->rows || destination->columns != matrix->columns)
+        return false;
+
+    if (destination != matrix)
+        for (int i = 0; i < matrix->rows; i++)
+            memcpy(destination->grid[i], matrix->grid[i], matrix->columns * sizeof(double));
+    return true;
+}
+
 /**
  * @brief Creates a deep copy of an existing matrix.
  * @param matrix The source matrix to copy.
@@ -89,13 +336,29 @@ Matrix *copy(const Matrix *matrix)
     if (copied == NULL)
         return NULL;
 
-    for (int i = 0; i < matrix->rows; i++)
-        for (int j = 0; j < matrix->columns; j++)
-            copied->grid[i][j] = matrix->grid[i][j];
-
+    copyInto(copied, matrix);
     return copied;
 }
 
+/**
+ * @brief Copies a submatrix of a larger matrix into an existing matrix.
+ * @param destination The matrix that receives the submatrix; its shape selects the submatrix's size.
+ * @param matrix The source matrix. Must not be the destination.
+ * @param fromRow The first row of the submatrix.
+ * @param fromColumn The first column of the submatrix.
+ * @return true on success, false if a matrix is NULL or the submatrix does not fit in the source.
+ */
+bool sliceInto(Matrix *destination, const Matrix *matrix, const int fromRow, const int fromColumn)
+{
+    if (destination == NULL || matrix == NULL || destination == matrix || fromRow < 0 || fromColumn < 0 ||
+        fromRow + destination->rows > matrix->rows || fromColumn + destination->columns > matrix->columns)
+        return false;
+
+    for (int i = 0; i < destination->rows; i++)
+        memcpy(destination->grid[i], matrix->grid[fromRow + i] + fromColumn, destination->columns * sizeof(double));
+    return true;
+}
+
 /**
  * @brief Extracts a submatrix from a larger matrix.
  * @param matrix The source matrix to slice.
@@ -114,63 +377,65 @@ Matrix *slice(const Matrix *matrix, const int fromRow, const int toRow, const in
     if (sliced == NULL)
         return NULL;
 
-    for (int i = fromRow; i < toRow; i++)
-        for (int j = fromColumn; j < toColumn; j++)
-            sliced->grid[i - fromRow][j - fromColumn] = matrix->grid[i][j];
-
+    sliceInto(sliced, matrix, fromRow, fromColumn);
     return sliced;
 }
 
 /**
- * @brief Joins two matrices either horizontally (column-wise) or vertically (row-wise).
+ * @brief Joins two matrices into an existing matrix, either horizontally or vertically.
+ * @param destination The matrix that receives the join. Must not be either source.
  * @param matrix1 The first matrix.
  * @param matrix2 The second matrix.
  * @param axis A boolean flag: true for horizontal join, false for vertical join.
- * @return A pointer to the new joined matrix, or NULL if matrices are incompatible or allocation fails.
+ * @return true on success, false if a matrix is NULL or the shapes are incompatible.
  */
-Matrix *join(const Matrix *matrix1, const Matrix *matrix2, const bool axis)
+bool joinInto(Matrix *destination, const Matrix *matrix1, const Matrix *matrix2, const bool axis)
 {
-    if (matrix1 == NULL || matrix2 == NULL)
-        return NULL;
+    if (destination == NULL || matrix1 == NULL || matrix2 == NULL || destination == matrix1 || destination == matrix2)
+        return false;
 
     if (axis) // join horizontally
     {
-        if (matrix1->rows != matrix2->rows)
-            return NULL;
-
-        Matrix *joined = init(matrix1->rows, matrix1->columns + matrix2->columns);
-        if (joined == NULL)
-            return NULL;
+        if (matrix1->rows != matrix2->rows || destination->rows != matrix1->rows || destination->columns != matrix1->columns + matrix2->columns)
+            return false;
 
         for (int i = 0; i < matrix1->rows; i++)
         {
-            for (int j = 0; j < matrix1->columns; j++)
-                joined->grid[i][j] = matrix1->grid[i][j];
-            for (int j = 0; j < matrix2->columns; j++)
-                joined->grid[i][matrix1->columns + j] = matrix2->grid[i][j];
+            memcpy(destination->grid[i], matrix1->grid[i], matrix1->columns * sizeof(double));
+            memcpy(destination->grid[i] + matrix1->columns, matrix2->grid[i], matrix2->columns * sizeof(double));
         }
-
-        return joined;
     }
     else // join vertically
     {
-        if (matrix1->columns != matrix2->columns)
-            return NULL;
+        if (matrix1->columns != matrix2->columns || destination->columns != matrix1->columns || destination->rows != matrix1->rows + matrix2->rows)
+            return false;
 
-        Matrix *joined = init(matrix1->rows + matrix2->rows, matrix1->columns);
-        if (joined == NULL)
-            return NULL;
+        for (int i = 0; i < matrix1->rows; i++)
+            memcpy(destination->grid[i], matrix1->grid[i], matrix1->columns * sizeof(double));
+        for (int i = 0; i < matrix2->rows; i++)
+            memcpy(destination->grid[matrix1->rows + i], matrix2->grid[i], matrix2->columns * sizeof(double));
+    }
+    return true;
+}
 
-        for (int j = 0; j < matrix1->columns; j++)
-        {
-            for (int i = 0; i < matrix1->rows; i++)
-                joined->grid[i][j] = matrix1->grid[i][j];
-            for (int i = 0; i < matrix2->rows; i++)
-                joined->grid[matrix1->rows + i][j] = matrix2->grid[i][j];
-        }
+/**
+ * @brief Joins two matrices either horizontally (column-wise) or vertically (row-wise).
+ * @param matrix1 The first matrix.
+ * @param matrix2 The second matrix.
+ * @param axis A boolean flag: true for horizontal join, false for vertical join.
+ * @return A pointer to the new joined matrix, or NULL if matrices are incompatible or allocation fails.
+ */
+Matrix *join(const Matrix *matrix1, const Matrix *matrix2, const bool axis)
+{
+    if (matrix1 == NULL || matrix2 == NULL || (axis ? matrix1->rows != matrix2->rows : matrix1->columns != matrix2->columns))
+        return NULL;
 
-        return joined;
-    }
+    Matrix *joined = axis ? init(matrix1->rows, matrix1->columns + matrix2->columns) : init(matrix1->rows + matrix2->rows, matrix1->columns);
+    if (joined == NULL)
+        return NULL;
+
+    joinInto(joined, matrix1, matrix2, axis);
+    return joined;
 }
 
 /**
@@ -189,9 +454,7 @@ Matrix *populate(const int rows, const int columns, const double *array)
     if (matrix == NULL)
         return NULL;
 
-    for (int i = 0; i < rows; i++)
-        for (int j = 0; j < columns; j++)
-            matrix->grid[i][j] = array[i * columns + j];
+    memcpy(matrix->data, array, (size_t)rows * columns * sizeof(double));
 
     return matrix;
 }
@@ -205,12 +468,11 @@ double *flatten(const Matrix *matrix)
 {
     if (matrix == NULL)
         return NULL;
-    double *array = (double *)malloc(matrix->rows * matrix->columns * sizeof(double));
+    double *array = (double *)malloc((size_t)matrix->rows * matrix->columns * sizeof(double));
     if (array == NULL)
         return NULL;
     for (int i = 0; i < matrix->rows; i++)
-        for (int j = 0; j < matrix->columns; j++)
-            array[i * matrix->columns + j] = matrix->grid[i][j];
+        memcpy(array + (size_t)i * matrix->columns, matrix->grid[i], matrix->columns * sizeof(double));
     return array;
 }
 
@@ -231,13 +493,7 @@ Matrix *reshape(const Matrix *matrix, const int newRows, const int newColumns)
         return NULL;
 
     for (int i = 0; i < matrix->rows; i++)
-        for (int j = 0; j < matrix->columns; j++)
-        {
-            int index = i * matrix->columns + j;
-            int newRow = index / newColumns;
-            int newCol = index % newColumns;
-            reshaped->grid[newRow][newCol] = matrix->grid[i][j];
-        }
+        memcpy(reshaped->data + (size_t)i * matrix->columns, matrix->grid[i], matrix->columns * sizeof(double));
 
     return reshaped;
 }
@@ -277,9 +533,9 @@ Matrix *fill(const int rows, const int columns, const double value)
     if (matrix == NULL)
         return NULL;
 
-    for (int i = 0; i < rows; i++)
-        for (int j = 0; j < columns; j++)
-            matrix->grid[i][j] = value;
+    size_t length = (size_t)rows * columns;
+    for (size_t i = 0; i < length; i++)
+        matrix->data[i] = value;
 
     return matrix;
 }
@@ -412,8 +668,7 @@ double *getField(const Matrix *matrix, const int index, const bool axis)
         if (array == NULL)
             return NULL;
 
-        for (int j = 0; j < matrix->columns; j++)
-            array[j] = matrix->grid[index][j];
+        memcpy(array, matrix->grid[index], matrix->columns * sizeof(double));
     }
     return array;
 }
@@ -463,6 +718,18 @@ void setField(Matrix *matrix, const int index, const bool axis, const double *ar
     }
 }
 
+/**
+ * @brief Swaps the values of two double-precision floating-point numbers.
+ * @param a Pointer to the first number.
+ * @param b Pointer to the second number.
+ */
+void __swap__(double *a, double *b)
+{
+    double temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
 /**
  * @brief Swaps two entire rows or columns within a matrix.
  * @param matrix The matrix to modify.
@@ -494,485 +761,4350 @@ void swapField(Matrix *matrix, const int index1, const int index2, const bool ax
 }
 
 /**
- * @brief Inserts a new row or column into a matrix at a specified index.
+ * @brief Inserts a new row or column into a copy of a matrix, written to an existing matrix.
+ * @param destination The matrix that receives the result: one row (or column) larger than the source. Must not be the source.
  * @param matrix The source matrix.
- * @param index The index at which to insert the new field.
+ * @param index The index at which to insert the new field, clamped to the valid range.
  * @param axis A boolean flag: true to insert a column, false to insert a row.
  * @param array The 1D array of values for the new field.
- * @return A pointer to the new matrix with the inserted field, or NULL on failure. The original matrix is not modified.
+ * @return true on success, false if an argument is NULL, the destination is the source, or the shapes do not match.
  */
-Matrix *insertField(const Matrix *matrix, int index, const bool axis, const double *array)
+bool insertFieldInto(Matrix *destination, const Matrix *matrix, int index, const bool axis, const double *array)
 {
-    if (matrix == NULL || array == NULL)
-        return NULL;
+    if (destination == NULL || matrix == NULL || array == NULL || destination == matrix ||
+        destination->rows != matrix->rows + !axis || destination->columns != matrix->columns + axis)
+        return false;
 
-    Matrix *expanded;
     if (axis) // insert column
     {
         index = index < 0 ? 0 : index;
         index = index > matrix->columns ? matrix->columns : index;
-
-        expanded = init(matrix->rows, matrix->columns + 1);
         for (int i = 0; i < matrix->rows; i++)
         {
-            for (int j = 0; j < index; j++)
-                expanded->grid[i][j] = matrix->grid[i][j];
-
-            expanded->grid[i][index] = array[i];
-
-            for (int j = index; j < matrix->columns; j++)
-                expanded->grid[i][j + 1] = matrix->grid[i][j];
+            memcpy(destination->grid[i], matrix->grid[i], index * sizeof(double));
+            destination->grid[i][index] = array[i];
+            memcpy(destination->grid[i] + index + 1, matrix->grid[i] + index, (matrix->columns - index) * sizeof(double));
         }
     }
     else // insert row
     {
         index = index < 0 ? 0 : index;
         index = index > matrix->rows ? matrix->rows : index;
+        for (int i = 0; i < index; i++)
+            memcpy(destination->grid[i], matrix->grid[i], matrix->columns * sizeof(double));
+        memcpy(destination->grid[index], array, matrix->columns * sizeof(double));
+        for (int i = index; i < matrix->rows; i++)
+            memcpy(destination->grid[i + 1], matrix->grid[i], matrix->columns * sizeof(double));
+    }
+    return true;
+}
 
-        expanded = init(matrix->rows + 1, matrix->columns);
-        for (int j = 0; j < matrix->columns; j++)
-        {
-            for (int i = 0; i < index; i++)
-                expanded->grid[i][j] = matrix->grid[i][j];
+/**
+ * @brief Inserts a new row or column into a matrix at a specified index.
+ * @param matrix The source matrix.
+ * @param index The index at which to insert the new field.
+ * @param axis A boolean flag: true to insert a column, false to insert a row.
+ * @param array The 1D array of values for the new field.
+ * @return A pointer to the new matrix with the inserted field, or NULL on failure. The original matrix is not modified.
+ */
+Matrix *insertField(const Matrix *matrix, int index, const bool axis, const double *array)
+{
+    if (matrix == NULL || array == NULL)
+        return NULL;
 
-            expanded->grid[index][j] = array[j];
+    Matrix *expanded = init(matrix->rows + !axis, matrix->columns + axis);
+    if (expanded == NULL)
+        return NULL;
 
-            for (int i = index; i < matrix->rows; i++)
-                expanded->grid[i + 1][j] = matrix->grid[i][j];
-        }
-    }
+    insertFieldInto(expanded, matrix, index, axis, array);
     return expanded;
 }
 
 /**
- * @brief Discards a row or column from a matrix at a specified index.
+ * @brief Discards a row or column from a copy of a matrix, written to an existing matrix.
+ * @param destination The matrix that receives the result: one row (or column) smaller than the source. Must not be the source.
  * @param matrix The source matrix.
- * @param index The index of the row or column to discard.
+ * @param index The index of the row or column to discard, clamped to the valid range.
  * @param axis A boolean flag: true to discard a column, false to discard a row.
- * @return A pointer to the new, smaller matrix, or NULL on failure. The original matrix is not modified.
+ * @return true on success, false if a matrix is NULL, the destination is the source, or the shapes do not match.
  */
-Matrix *discardField(const Matrix *matrix, int index, const bool axis)
+bool discardFieldInto(Matrix *destination, const Matrix *matrix, int index, const bool axis)
 {
-    if (matrix == NULL)
-        return NULL;
+    if (destination == NULL || matrix == NULL || destination == matrix ||
+        destination->rows != matrix->rows - !axis || destination->columns != matrix->columns - axis)
+        return false;
 
-    Matrix *reduced;
     if (axis) // discard column
     {
         index = index < 0 ? 0 : index;
         index = index >= matrix->columns ? matrix->columns - 1 : index;
-
-        reduced = init(matrix->rows, matrix->columns - 1);
         for (int i = 0; i < matrix->rows; i++)
         {
-            for (int j = 0; j < index; j++)
-                reduced->grid[i][j] = matrix->grid[i][j];
-
-            for (int j = index + 1; j < matrix->columns; j++)
-                reduced->grid[i][j - 1] = matrix->grid[i][j];
+            memcpy(destination->grid[i], matrix->grid[i], index * sizeof(double));
+            memcpy(destination->grid[i] + index, matrix->grid[i] + index + 1, (matrix->columns - index - 1) * sizeof(double));
         }
     }
     else // discard row
     {
         index = index < 0 ? 0 : index;
         index = index >= matrix->rows ? matrix->rows - 1 : index;
-
-        reduced = init(matrix->rows - 1, matrix->columns);
-        for (int j = 0; j < matrix->columns; j++)
-        {
-            for (int i = 0; i < index; i++)
-                reduced->grid[i][j] = matrix->grid[i][j];
-
-            for (int i = index + 1; i < matrix->rows; i++)
-                reduced->grid[i - 1][j] = matrix->grid[i][j];
-        }
+        for (int i = 0; i < index; i++)
+            memcpy(destination->grid[i], matrix->grid[i], matrix->columns * sizeof(double));
+        for (int i = index + 1; i < matrix->rows; i++)
+            memcpy(destination->grid[i - 1], matrix->grid[i], matrix->columns * sizeof(double));
     }
-    return reduced;
+    return true;
 }
 
 /**
- * @brief Transposes a matrix. The rows become columns and the columns become rows.
- * @param matrix The matrix to transpose.
- * @return A pointer to the new transposed matrix, or NULL on failure.
+ * @brief Discards a row or column from a matrix at a specified index.
+ * @param matrix The source matrix.
+ * @param index The index of the row or column to discard.
+ * @param axis A boolean flag: true to discard a column, false to discard a row.
+ * @return A pointer to the new, smaller matrix, or NULL on failure. The original matrix is not modified.
  */
-Matrix *transpose(const Matrix *matrix)
+Matrix *discardField(const Matrix *matrix, int index, const bool axis)
 {
     if (matrix == NULL)
         return NULL;
 
-    Matrix *transposed = init(matrix->columns, matrix->rows);
-    if (transposed == NULL)
+    Matrix *reduced = init(matrix->rows - !axis, matrix->columns - axis);
+    if (reduced == NULL)
         return NULL;
 
-    for (int i = 0; i < matrix->rows; i++)
-        for (int j = 0; j < matrix->columns; j++)
-            transposed->grid[j][i] = matrix->grid[i][j];
-
-    return transposed;
+    discardFieldInto(reduced, matrix, index, axis);
+    return reduced;
 }
 
 /**
- * @brief Swaps the values of two double-precision floating-point numbers.
- * @param a Pointer to the first number.
- * @param b Pointer to the second number.
+ * @brief Moves a matrix's elements into a new allocation with room for more rows and columns.
+ * @param matrix The matrix.
+ * @param capacity The number of rows the new storage holds, at least `rows`.
+ * @param stride The number of columns the new storage holds, at least `columns`.
+ * @return true on success, false if allocation fails (the matrix is then unchanged).
+ * @note This is a private helper function. The row pointer table and the elements share the new
+ * allocation, which comes from the matrix's arena if it has one. Spare elements are zero.
+ * @note Arenas are not synchronized, so a matrix allocated from an arena may only be grown on the
+ * thread that allocates from that arena (the thread that passed it to useArena).
  */
-void __swap__(double *a, double *b)
+bool __regrow__(Matrix *matrix, const int capacity, const int stride)
 {
-    double temp = *a;
-    *a = *b;
-    *b = temp;
+    size_t header = (size_t)capacity * sizeof(double *);
+    size_t bytes = header + MATRIX_ALIGNMENT - 1 + (size_t)capacity * stride * sizeof(double);
+    char *block = matrix->arena != NULL ? (char *)__arenaAlloc__(matrix->arena, bytes) : (char *)calloc(1, bytes);
+    if (block == NULL)
+        return false;
+
+    double **grid = (double **)block;
+    double *data = (double *)(((uintptr_t)(block + header) + MATRIX_ALIGNMENT - 1) & ~(uintptr_t)(MATRIX_ALIGNMENT - 1));
+    for (int i = 0; i < capacity; i++)
+        grid[i] = data + (size_t)i * stride;
+    for (int i = 0; i < matrix->rows; i++)
+        memcpy(grid[i], matrix->grid[i], matrix->columns * sizeof(double));
+
+    if (matrix->arena == NULL)
+        free(matrix->storage);
+    matrix->storage = matrix->arena == NULL ? block : NULL;
+    matrix->grid = grid;
+    matrix->data = data;
+    matrix->stride = stride;
+    matrix->capacity = capacity;
+    return true;
 }
 
 /**
- * @brief Creates a new matrix with its elements randomly shuffled.
- * @param matrix The matrix to shuffle.
- * @return A pointer to the new shuffled matrix, or NULL on failure.
+ * @brief Ensures a matrix can grow to the given size without reallocating.
+ * @param matrix The matrix.
+ * @param rows The number of rows to make room for.
+ * @param columns The number of columns to make room for.
+ * @return true on success, false if the matrix is NULL or read-only (mmapLoad), or allocation fails.
+ * @note Does nothing if the matrix already has the room. Otherwise the elements move to a new
+ * allocation with `capacity >= rows` and `stride >= columns`; the Matrix pointer stays valid, but
+ * row pointers and views taken earlier do not.
+ * @note A matrix allocated from an arena grows within that arena, which is not synchronized: only
+ * the thread using the arena (see useArena) may grow it, here or through the InPlace functions.
  */
-Matrix *shuffle(const Matrix *matrix)
+bool reserve(Matrix *matrix, const int rows, const int columns)
 {
-    if (matrix == NULL)
-        return NULL;
-
-    Matrix *shuffled = copy(matrix);
-    if (matrix == NULL || matrix->rows * matrix->columns <= 1)
-        return shuffled;
-
-    __seeding__();
-
-    for (int i = shuffled->rows * shuffled->columns - 1; i > 0; i--)
-    {
-        int j = rand() % (i + 1);
-        int row1 = i / shuffled->columns;
-        int col1 = i % shuffled->columns;
-        int row2 = j / shuffled->columns;
-        int col2 = j % shuffled->columns;
-        __swap__(&shuffled->grid[row1][col1], &shuffled->grid[row2][col2]);
-    }
-
-    return shuffled;
+    if (matrix == NULL || matrix->mapping != NULL)
+        return false;
+    if (rows <= matrix->capacity && columns <= matrix->stride)
+        return true;
+    return __regrow__(matrix, rows > matrix->capacity ? rows : matrix->capacity, columns > matrix->stride ? columns : matrix->stride);
 }
 
 /**
- * @brief Applies a unary function to every element of a matrix and returns a new matrix with the results.
- * @param matrix The source matrix.
- * @param func A function pointer that takes one double and returns a double.
- * @return A pointer to the new result matrix, or NULL on failure.
+ * @brief Grows a matrix's capacity geometrically until it fits the given size.
+ * @param matrix The matrix.
+ * @param rows The number of rows that must fit.
+ * @param columns The number of columns that must fit.
+ * @return true on success, false if the matrix is read-only or allocation fails.
+ * @note This is a private helper function. Doubling whichever dimension is short, like Vector's
+ * __expand__, makes a sequence of appends cost amortized O(1) reallocations per element.
  */
-Matrix *scalar(const Matrix *matrix, double (*func)(double))
+bool __expandMatrix__(Matrix *matrix, const int rows, const int columns)
 {
-    if (matrix == NULL || func == NULL)
-        return NULL;
-
-    Matrix *result = init(matrix->rows, matrix->columns);
-    for (int i = 0; i < matrix->rows; i++)
-        for (int j = 0; j < matrix->columns; j++)
-            result->grid[i][j] = func(matrix->grid[i][j]);
-
-    return result;
+    int capacity = matrix->capacity, stride = matrix->stride;
+    while (capacity < rows)
+        capacity *= 2;
+    while (stride < columns)
+        stride *= 2;
+    return reserve(matrix, capacity, stride);
 }
 
 /**
- * @brief Applies a unary function to a specific row or column and returns the result as a new 1D array.
- * @param matrix The source matrix.
+ * @brief Inserts a new row or column into a matrix in place.
+ * @param matrix The matrix to modify.
+ * @param index The index at which to insert, clamped to [0, rows] or [0, columns].
+ * @param axis false to insert a row, true to insert a column.
+ * @param array The values of the new row (columns values) or column (rows values).
+ * @return true on success, false if an argument is NULL, the matrix is read-only, or allocation fails.
+ * @note Spare capacity doubles when it runs out, so appending a row costs amortized O(columns)
+ * and inserting one costs O(columns) per row moved, instead of copying the whole matrix.
+ * @note `array` may point into the matrix itself (e.g. `matrix->grid[1]` to duplicate a row): it is
+ * then copied before the matrix grows or shifts.
+ */
+bool insertFieldInPlace(Matrix *matrix, int index, const bool axis, const double *array)
+{
+    if (matrix == NULL || array == NULL || matrix->mapping != NULL)
+        return false;
+    int count = axis ? matrix->rows : matrix->columns;
+    double *source = (double *)array;
+    bool aliased = array >= matrix->data && array < matrix->data + (size_t)matrix->capacity * matrix->stride;
+    if (aliased)
+    {
+        source = (double *)malloc(count * sizeof(double));
+        if (source == NULL)
+            return false;
+        memcpy(source, array, count * sizeof(double));
+    }
+    if (!__expandMatrix__(matrix, matrix->rows + !axis, matrix->columns + axis))
+    {
+        if (aliased)
+            free(source);
+        return false;
+    }
+
+    if (axis) // insert column
+    {
+        index = index < 0 ? 0 : index;
+        index = index > matrix->columns ? matrix->columns : index;
+        for (int i = 0; i < matrix->rows; i++)
+        {
+            memmove(matrix->grid[i] + index + 1, matrix->grid[i] + index, (matrix->columns - index) * sizeof(double));
+            matrix->grid[i][index] = source[i];
+        }
+        matrix->columns++;
+    }
+    else // insert row
+    {
+        index = index < 0 ? 0 : index;
+        index = index > matrix->rows ? matrix->rows : index;
+        for (int i = matrix->rows; i > index; i--)
+            memcpy(matrix->grid[i], matrix->grid[i - 1], matrix->columns * sizeof(double));
+        memcpy(matrix->grid[index], source, matrix->columns * sizeof(double));
+        matrix->rows++;
+    }
+
+    if (aliased)
+        free(source);
+    return true;
+}
+
+/**
+ * @brief Removes a row or column from a matrix in place.
+ * @param matrix The matrix to modify.
+ * @param index The index of the field to remove, clamped to the valid range.
+ * @param axis false to remove a row, true to remove a column.
+ * @return true on success, false if the matrix is NULL or read-only, or the field is the last one.
+ * @note The freed row or column is kept as spare capacity. Removing the last row costs O(1).
+ */
+bool discardFieldInPlace(Matrix *matrix, int index, const bool axis)
+{
+    if (matrix == NULL || matrix->mapping != NULL || (axis ? matrix->columns : matrix->rows) <= 1)
+        return false;
+
+    if (axis) // discard column
+    {
+        index = index < 0 ? 0 : index;
+        index = index >= matrix->columns ? matrix->columns - 1 : index;
+        for (int i = 0; i < matrix->rows; i++)
+        {
+            memmove(matrix->grid[i] + index, matrix->grid[i] + index + 1, (matrix->columns - index - 1) * sizeof(double));
+            matrix->grid[i][matrix->columns - 1] = 0.0;
+        }
+        matrix->columns--;
+    }
+    else // discard row
+    {
+        index = index < 0 ? 0 : index;
+        index = index >= matrix->rows ? matrix->rows - 1 : index;
+        for (int i = index + 1; i < matrix->rows; i++)
+            memcpy(matrix->grid[i - 1], matrix->grid[i], matrix->columns * sizeof(double));
+        memset(matrix->grid[matrix->rows - 1], 0, matrix->columns * sizeof(double));
+        matrix->rows--;
+    }
+    return true;
+}
+
+/**
+ * @brief Appends the rows or columns of another matrix to a matrix in place.
+ * @param matrix The matrix to extend.
+ * @param other The matrix to append. May be the same matrix.
+ * @param axis A boolean flag: true for horizontal join (append columns), false for vertical join (append rows).
+ * @return true on success, false if an argument is NULL, the shapes are incompatible, the matrix
+ * is read-only, or allocation fails.
+ * @note Capacity grows geometrically, so repeatedly appending blocks of rows costs time proportional
+ * to the appended elements only.
+ */
+bool joinInPlace(Matrix *matrix, const Matrix *other, const bool axis)
+{
+    if (matrix == NULL || other == NULL || (axis ? matrix->rows != other->rows : matrix->columns != other->columns))
+        return false;
+
+    int rows = other->rows, columns = other->columns;
+    if (!__expandMatrix__(matrix, axis ? matrix->rows : matrix->rows + rows, axis ? matrix->columns + columns : matrix->columns))
+        return false;
+
+    if (axis) // join horizontally
+    {
+        for (int i = 0; i < rows; i++)
+            memcpy(matrix->grid[i] + matrix->columns, other->grid[i], columns * sizeof(double));
+        matrix->columns += columns;
+    }
+    else // join vertically
+    {
+        for (int i = 0; i < rows; i++)
+            memcpy(matrix->grid[matrix->rows + i], other->grid[i], columns * sizeof(double));
+        matrix->rows += rows;
+    }
+    return true;
+}
+
+/**
+ * @brief Creates a view of a whole matrix.
+ * @param matrix The matrix to view.
+ * @return A view of every element of the matrix, or an empty view (data NULL) if the matrix is NULL.
+ */
+MatrixView view(const Matrix *matrix)
+{
+    MatrixView result = {NULL, 0, 0, 0, 0};
+    if (matrix == NULL)
+        return result;
+
+    result.data = matrix->data;
+    result.rows = matrix->rows;
+    result.columns = matrix->columns;
+    result.rowStride = matrix->stride;
+    result.columnStride = 1;
+    return result;
+}
+
+/**
+ * @brief Creates a zero-copy view of a rectangular block of another view.
+ * @param view The view to slice.
+ * @param fromRow The starting row index (inclusive).
+ * @param toRow The ending row index (exclusive).
+ * @param fromColumn The starting column index (inclusive).
+ * @param toColumn The ending column index (exclusive).
+ * @return A view sharing the elements of the block, or an empty view (data NULL) if parameters are invalid.
+ * @note The zero-copy counterpart of slice().
+ */
+MatrixView sliceView(const MatrixView view, const int fromRow, const int toRow, const int fromColumn, const int toColumn)
+{
+    MatrixView result = {NULL, 0, 0, 0, 0};
+    if (view.data == NULL || fromRow < 0 || toRow > view.rows || fromColumn < 0 || toColumn > view.columns || fromRow >= toRow || fromColumn >= toColumn)
+        return result;
+
+    result.data = view.data + (ptrdiff_t)fromRow * view.rowStride + (ptrdiff_t)fromColumn * view.columnStride;
+    result.rows = toRow - fromRow;
+    result.columns = toColumn - fromColumn;
+    result.rowStride = view.rowStride;
+    result.columnStride = view.columnStride;
+    return result;
+}
+
+/**
+ * @brief Creates a zero-copy view of a single row or column of another view.
+ * @param view The view to take the field from.
  * @param index The index of the row or column.
- * @param axis A boolean flag: true for a column, false for a row.
- * @param func A function pointer that takes one double and returns a double.
- * @return A pointer to the new result array, or NULL on failure. The caller is responsible for freeing this memory.
+ * @param axis A boolean flag: true for a column (an n x 1 view), false for a row (a 1 x n view).
+ * @return A view sharing the elements of the field, or an empty view (data NULL) if parameters are invalid.
+ * @note The zero-copy counterpart of getField().
  */
-double *scalarField(const Matrix *matrix, const int index, const bool axis, double (*func)(double))
+MatrixView fieldView(const MatrixView view, const int index, const bool axis)
 {
-    if (matrix == NULL || func == NULL)
+    if (axis) // view column
+        return sliceView(view, 0, view.rows, index, index + 1);
+    else // view row
+        return sliceView(view, index, index + 1, 0, view.columns);
+}
+
+/**
+ * @brief Creates a zero-copy transposed view by swapping the dimensions and strides.
+ * @param view The view to transpose.
+ * @return The transposed view, or an empty view (data NULL) if the input view is empty.
+ * @note The zero-copy counterpart of transpose().
+ */
+MatrixView transposeView(const MatrixView view)
+{
+    MatrixView result = {NULL, 0, 0, 0, 0};
+    if (view.data == NULL)
+        return result;
+
+    result.data = view.data;
+    result.rows = view.columns;
+    result.columns = view.rows;
+    result.rowStride = view.columnStride;
+    result.columnStride = view.rowStride;
+    return result;
+}
+
+/**
+ * @brief Retrieves the value of an element of a view.
+ * @param view The view to read.
+ * @param row The row index within the view.
+ * @param column The column index within the view.
+ * @return The value of the element, or -1 if indices are invalid or the view is empty.
+ */
+double viewGet(const MatrixView view, const int row, const int column)
+{
+    if (view.data == NULL || row < 0 || row >= view.rows || column < 0 || column >= view.columns)
+        return -1;
+
+    return view.data[(ptrdiff_t)row * view.rowStride + (ptrdiff_t)column * view.columnStride];
+}
+
+/**
+ * @brief Sets the value of an element of a view, writing through to the underlying matrix.
+ * @param view The view to modify.
+ * @param row The row index within the view.
+ * @param column The column index within the view.
+ * @param value The new value to set.
+ */
+void viewSet(const MatrixView view, const int row, const int column, const double value)
+{
+    if (view.data == NULL || row < 0 || row >= view.rows || column < 0 || column >= view.columns)
+        return;
+
+    view.data[(ptrdiff_t)row * view.rowStride + (ptrdiff_t)column * view.columnStride] = value;
+}
+
+/**
+ * @brief Copies the elements of a view into a new, contiguous matrix.
+ * @param view The view to copy.
+ * @return A pointer to the new matrix, or NULL if the view is empty or allocation fails.
+ */
+Matrix *materialize(const MatrixView view)
+{
+    if (view.data == NULL)
         return NULL;
 
-    double *array;
-    if (axis) // apply to column
+    Matrix *result = init(view.rows, view.columns);
+    if (result == NULL)
+        return NULL;
+
+    for (int i = 0; i < view.rows; i++)
     {
-        if (index < 0 || index >= matrix->columns)
-            return NULL;
+        const double *row = view.data + (ptrdiff_t)i * view.rowStride;
+        if (view.columnStride == 1)
+            memcpy(result->grid[i], row, view.columns * sizeof(double));
+        else
+            for (int j = 0; j < view.columns; j++)
+                result->grid[i][j] = row[(ptrdiff_t)j * view.columnStride];
+    }
+    return result;
+}
 
-        array = (double *)malloc(matrix->rows * sizeof(double));
-        if (array == NULL)
-            return NULL;
+/**
+ * @brief Minimum number of elements for which scalar(), elementwise(), determinant() and inverse()
+ * split their work across the thread pool.
+ * @note Define this before including the header to override the default.
+ */
+#ifndef MATRIX_PARALLEL_CUTOFF
+#define MATRIX_PARALLEL_CUTOFF 65536
+#endif
 
-        for (int i = 0; i < matrix->rows; i++)
-            array[i] = func(matrix->grid[i][index]);
+/**
+ * @brief Shared state of the persistent thread pool used by the Matrix module.
+ * @details Helper threads sleep on `wake` until `generation` changes, then pull task indices
+ * from `next` until `tasks` is reached. The calling thread works as worker 0 and waits on
+ * `done` until every helper has finished. All fields are protected by `lock`.
+ * @note This is a private helper type.
+ */
+typedef struct
+{
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    pthread_t *handles;
+    int threads;
+    int spawned;
+    int ready;
+    int pending;
+    unsigned long generation;
+    bool busy;
+    bool stopping;
+    void (*func)(void *, int, int);
+    void *context;
+    int tasks;
+    int next;
+} __MatrixPool__;
+
+/**
+ * @brief Returns the single thread pool shared by every Matrix operation.
+ * @return A pointer to the pool.
+ * @note This is a private helper function.
+ */
+__MatrixPool__ *__pool__()
+{
+    static __MatrixPool__ pool = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER,
+                                  NULL, 0, 0, 0, 0, 0, false, false, NULL, NULL, 0, 0};
+    return &pool;
+}
+
+/**
+ * @brief Returns the number of online processors.
+ * @return The processor count, or 1 if it cannot be determined.
+ * @note This is a private helper function.
+ */
+int __processorCount__()
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+}
+
+/**
+ * @brief Runs tasks of the current job until none are left.
+ * @param pool The pool, unlocked on entry and on return.
+ * @param worker The index of the calling worker.
+ * @note This is a private helper function.
+ */
+void __poolDrain__(__MatrixPool__ *pool, const int worker)
+{
+    pthread_mutex_lock(&pool->lock);
+    while (pool->next < pool->tasks)
+    {
+        int task = pool->next++;
+        void (*func)(void *, int, int) = pool->func;
+        void *context = pool->context;
+        pthread_mutex_unlock(&pool->lock);
+        func(context, task, worker);
+        pthread_mutex_lock(&pool->lock);
     }
-    else // apply to row
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief Main loop of a helper thread: sleeps until a job is posted, helps finish it, and repeats.
+ * @param arg The worker index, cast to a pointer.
+ * @return Always NULL.
+ * @note This is a private helper function.
+ */
+void *__poolWorker__(void *arg)
+{
+    __MatrixPool__ *pool = __pool__();
+    int worker = (int)(intptr_t)arg;
+
+    pthread_mutex_lock(&pool->lock);
+    unsigned long seen = pool->generation;
+    pool->ready++;
+    pthread_cond_broadcast(&pool->done);
+    while (true)
     {
-        if (index < 0 || index >= matrix->rows)
-            return NULL;
+        while (!pool->stopping && pool->generation == seen)
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        if (pool->stopping)
+            break;
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+        __poolDrain__(pool, worker);
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0)
+            pthread_cond_signal(&pool->done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/**
+ * @brief Starts the helper threads of the pool and waits until each of them is listening.
+ * @param pool The pool, locked by the caller.
+ * @note This is a private helper function. If a thread cannot be created the pool simply runs
+ * with fewer helpers.
+ */
+void __poolStart__(__MatrixPool__ *pool)
+{
+    pool->handles = (pthread_t *)malloc((pool->threads - 1) * sizeof(pthread_t));
+    if (pool->handles == NULL)
+        return;
+    while (pool->spawned < pool->threads - 1 &&
+           pthread_create(&pool->handles[pool->spawned], NULL, __poolWorker__, (void *)(intptr_t)(pool->spawned + 1)) == 0)
+        pool->spawned++;
+    while (pool->ready < pool->spawned)
+        pthread_cond_wait(&pool->done, &pool->lock);
+}
+
+/**
+ * @brief Runs `func(context, task, worker)` for every task in [0, tasks) on the thread pool and waits for all of them.
+ * @param tasks The number of tasks.
+ * @param func The function to run; `worker` is in [0, getThreads()) and no two tasks run on the same worker at once.
+ * @param context The shared context passed to every task.
+ * @note This is a private helper function. The calling thread takes part as worker 0. Runs
+ * everything on the calling thread when the pool has one thread, when there is a single task,
+ * or when the pool is already busy (a nested call, or a call from another application thread).
+ */
+void __poolRun__(const int tasks, void (*func)(void *, int, int), void *context)
+{
+    __MatrixPool__ *pool = __pool__();
+    pthread_mutex_lock(&pool->lock);
+    if (pool->threads == 0)
+        pool->threads = __processorCount__();
+    if (pool->busy || pool->threads == 1 || tasks <= 1)
+    {
+        pthread_mutex_unlock(&pool->lock);
+        for (int task = 0; task < tasks; task++)
+            func(context, task, 0);
+        return;
+    }
+
+    pool->busy = true;
+    if (pool->handles == NULL)
+        __poolStart__(pool);
+    pool->func = func;
+    pool->context = context;
+    pool->tasks = tasks;
+    pool->next = 0;
+    pool->pending = pool->spawned;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    __poolDrain__(pool, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0)
+        pthread_cond_wait(&pool->done, &pool->lock);
+    pool->busy = false;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief Sets the number of threads used by parallel Matrix operations.
+ * @param threads The number of threads, including the calling thread; 0 or less selects the number of online processors.
+ * @note The default is the number of online processors; 1 makes every operation serial. Stops
+ * any running helper threads; new ones are started lazily by the next parallel operation.
+ * Must not be called while a Matrix operation is running on another thread.
+ */
+void setThreads(const int threads)
+{
+    __MatrixPool__ *pool = __pool__();
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    for (int t = 0; t < pool->spawned; t++)
+        pthread_join(pool->handles[t], NULL);
+
+    pthread_mutex_lock(&pool->lock);
+    free(pool->handles);
+    pool->handles = NULL;
+    pool->spawned = 0;
+    pool->ready = 0;
+    pool->stopping = false;
+    pool->threads = threads <= 0 ? __processorCount__() : threads;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief Returns the number of threads used by parallel Matrix operations.
+ * @return The configured thread count, including the calling thread.
+ */
+int getThreads()
+{
+    __MatrixPool__ *pool = __pool__();
+    pthread_mutex_lock(&pool->lock);
+    if (pool->threads == 0)
+        pool->threads = __processorCount__();
+    int threads = pool->threads;
+    pthread_mutex_unlock(&pool->lock);
+    return threads;
+}
+
+/**
+ * @brief Chooses how many row blocks to split an operation into.
+ * @param rows The number of rows to split.
+ * @param work The number of elements the operation touches.
+ * @return 1 when the work is below MATRIX_PARALLEL_CUTOFF, otherwise a few blocks per thread.
+ * @note This is a private helper function.
+ */
+int __rowBlocks__(const int rows, const double work)
+{
+    if (work < MATRIX_PARALLEL_CUTOFF)
+        return 1;
+    int blocks = 4 * getThreads();
+    return blocks < rows ? blocks : rows;
+}
+
+/**
+ * @brief Shared state of a parallel scalar() or elementwise() call.
+ * @note This is a private helper type.
+ */
+typedef struct
+{
+    const Matrix *matrix1;
+    const Matrix *matrix2;
+    Matrix *result;
+    double (*unary)(double);
+    double (*binary)(double, double);
+    int blocks;
+} __MapJob__;
+
+/**
+ * @brief Applies the unary or binary function of a __MapJob__ to one block of rows.
+ * @param context The __MapJob__.
+ * @param block The index of the row block.
+ * @param worker Unused.
+ * @note This is a private helper function.
+ */
+void __mapRows__(void *context, const int block, const int worker)
+{
+    (void)worker;
+    __MapJob__ *job = (__MapJob__ *)context;
+    int rows = job->result->rows, columns = job->result->columns;
+    int from = (int)((long long)rows * block / job->blocks);
+    int to = (int)((long long)rows * (block + 1) / job->blocks);
+    for (int i = from; i < to; i++)
+    {
+        const double *source1 = job->matrix1->grid[i];
+        double *target = job->result->grid[i];
+        if (job->unary != NULL)
+            for (int j = 0; j < columns; j++)
+                target[j] = job->unary(source1[j]);
+        else
+        {
+            const double *source2 = job->matrix2->grid[i];
+            for (int j = 0; j < columns; j++)
+                target[j] = job->binary(source1[j], source2[j]);
+        }
+    }
+}
+
+/**
+ * @brief Edge length, in elements, of the square tiles that transpose and transposeInPlace work on.
+ * @note Two 32 x 32 tiles of doubles take 16 KiB, so a source tile and its target stay in the
+ * L1 cache while every element is read along a row and written along a column.
+ * @note Define this before including the header to override the default.
+ */
+#ifndef TRANSPOSE_BLOCK
+#define TRANSPOSE_BLOCK 32
+#endif
+
+/**
+ * @brief Shared state of a parallel transpose() or transposeInPlace() call.
+ * @note This is a private helper type.
+ */
+typedef struct
+{
+    const Matrix *source;
+    Matrix *target;
+    int blocks;
+} __TransposeJob__;
+
+/**
+ * @brief Transposes one block of the target's rows, tile by tile.
+ * @param context The __TransposeJob__.
+ * @param block The index of the block of target rows, i.e. of source columns.
+ * @param worker Unused.
+ * @note This is a private helper function. Blocks start on tile boundaries, so every tile is
+ * written by exactly one block.
+ */
+void __transposeRows__(void *context, const int block, const int worker)
+{
+    (void)worker;
+    __TransposeJob__ *job = (__TransposeJob__ *)context;
+    const Matrix *source = job->source;
+    Matrix *target = job->target;
+    int tiles = (source->columns + TRANSPOSE_BLOCK - 1) / TRANSPOSE_BLOCK;
+    int from = (int)((long long)tiles * block / job->blocks) * TRANSPOSE_BLOCK;
+    int to = (int)((long long)tiles * (block + 1) / job->blocks) * TRANSPOSE_BLOCK;
+    if (to > source->columns)
+        to = source->columns;
+    for (int jj = from; jj < to; jj += TRANSPOSE_BLOCK)
+    {
+        int jEnd = jj + TRANSPOSE_BLOCK < to ? jj + TRANSPOSE_BLOCK : to;
+        for (int ii = 0; ii < source->rows; ii += TRANSPOSE_BLOCK)
+        {
+            int iEnd = ii + TRANSPOSE_BLOCK < source->rows ? ii + TRANSPOSE_BLOCK : source->rows;
+            for (int j = jj; j < jEnd; j++)
+            {
+                double *row = target->data + (size_t)j * target->stride;
+                for (int i = ii; i < iEnd; i++)
+                    row[i] = source->data[(size_t)i * source->stride + j];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Transposes a matrix into an existing matrix.
+ * @param destination The matrix that receives the transpose, columns x rows of the source. Must
+ * not be the source; use transposeInPlace for that.
+ * @param matrix The matrix to transpose.
+ * @return true on success, false if a matrix is NULL, they are the same matrix or the shapes do not match.
+ * @note Uses the same tiled, multithreaded copy as transpose.
+ */
+bool transposeInto(Matrix *destination, const Matrix *matrix)
+{
+    if (destination == NULL || matrix == NULL || destination == matrix || destination->rows != matrix->columns || destination->columns != matrix->rows)
+        return false;
+
+    int tiles = (matrix->columns + TRANSPOSE_BLOCK - 1) / TRANSPOSE_BLOCK;
+    __TransposeJob__ job = {matrix, destination, __rowBlocks__(tiles, (double)matrix->rows * matrix->columns)};
+    __poolRun__(job.blocks, __transposeRows__, &job);
+    return true;
+}
+
+/**
+ * @brief Transposes a matrix. The rows become columns and the columns become rows.
+ * @param matrix The matrix to transpose.
+ * @return A pointer to the new transposed matrix, or NULL on failure.
+ * @note Copies TRANSPOSE_BLOCK x TRANSPOSE_BLOCK tiles, so neither the reads nor the writes walk
+ * a whole column at a time. Large matrices are split into bands of whole tiles across the thread
+ * pool (setThreads(1) keeps it serial).
+ */
+Matrix *transpose(const Matrix *matrix)
+{
+    if (matrix == NULL)
+        return NULL;
+
+    Matrix *transposed = init(matrix->columns, matrix->rows);
+    if (transposed == NULL)
+        return NULL;
+
+    transposeInto(transposed, matrix);
+    return transposed;
+}
+
+/**
+ * @brief Swaps the tiles of one band of tile rows of a square matrix with their mirror images.
+ * @param context The __TransposeJob__, whose target is the matrix.
+ * @param block The index of the task; it handles tile rows block, block + blocks, block + 2 * blocks, ...
+ * @param worker Unused.
+ * @note This is a private helper function. Tile row t swaps tiles (t, u) and (u, t) for every
+ * u > t and transposes the diagonal tile (t, t), so no two tasks touch the same element.
+ */
+void __transposeSquare__(void *context, const int block, const int worker)
+{
+    (void)worker;
+    __TransposeJob__ *job = (__TransposeJob__ *)context;
+    Matrix *matrix = job->target;
+    int n = matrix->rows, stride = matrix->stride;
+    double *data = matrix->data;
+    for (int ii = block * TRANSPOSE_BLOCK; ii < n; ii += job->blocks * TRANSPOSE_BLOCK)
+    {
+        int iEnd = ii + TRANSPOSE_BLOCK < n ? ii + TRANSPOSE_BLOCK : n;
+        for (int jj = ii; jj < n; jj += TRANSPOSE_BLOCK)
+        {
+            int jEnd = jj + TRANSPOSE_BLOCK < n ? jj + TRANSPOSE_BLOCK : n;
+            for (int i = ii; i < iEnd; i++)
+                for (int j = jj == ii ? i + 1 : jj; j < jEnd; j++)
+                {
+                    double temp = data[(size_t)i * stride + j];
+                    data[(size_t)i * stride + j] = data[(size_t)j * stride + i];
+                    data[(size_t)j * stride + i] = temp;
+                }
+        }
+    }
+}
+
+/**
+ * @brief Transposes a square matrix in place, without allocating.
+ * @param matrix The square matrix to transpose.
+ * @return true on success, or false if the matrix is NULL or not square.
+ * @note Swaps each TRANSPOSE_BLOCK x TRANSPOSE_BLOCK tile above the diagonal with the transpose
+ * of its mirror below it. Large matrices spread the tile rows across the thread pool.
+ */
+bool transposeInPlace(Matrix *matrix)
+{
+    if (matrix == NULL || matrix->rows != matrix->columns)
+        return false;
+
+    int tiles = (matrix->rows + TRANSPOSE_BLOCK - 1) / TRANSPOSE_BLOCK;
+    __TransposeJob__ job = {NULL, matrix, __rowBlocks__(tiles, (double)matrix->rows * matrix->columns)};
+    __poolRun__(job.blocks, __transposeSquare__, &job);
+    return true;
+}
+
+/**
+ * @brief Creates a new matrix with its elements randomly shuffled.
+ * @param matrix The matrix to shuffle.
+ * @return A pointer to the new shuffled matrix, or NULL on failure.
+ */
+Matrix *shuffle(const Matrix *matrix)
+{
+    if (matrix == NULL)
+        return NULL;
+
+    Matrix *shuffled = copy(matrix);
+    if (matrix == NULL || matrix->rows * matrix->columns <= 1)
+        return shuffled;
+
+    __seeding__();
+
+    for (int i = shuffled->rows * shuffled->columns - 1; i > 0; i--)
+    {
+        int j = rand() % (i + 1);
+        int row1 = i / shuffled->columns;
+        int col1 = i % shuffled->columns;
+        int row2 = j / shuffled->columns;
+        int col2 = j % shuffled->columns;
+        __swap__(&shuffled->grid[row1][col1], &shuffled->grid[row2][col2]);
+    }
+
+    return shuffled;
+}
+
+/**
+ * @brief Applies a unary function to every element of a matrix, writing the results into an existing matrix.
+ * @param destination The matrix that receives the results. May be the source itself.
+ * @param matrix The source matrix.
+ * @param func A function pointer that takes one double and returns a double.
+ * @return true on success, false if an argument is NULL or the shapes differ.
+ * @note Large matrices are split into row blocks across the thread pool, so `func` must be thread-safe.
+ */
+bool scalarInto(Matrix *destination, const Matrix *matrix, double (*func)(double))
+{
+    if (destination == NULL || matrix == NULL || func == NULL || destination->rows != matrix->rows || destination->columns != matrix->columns)
+        return false;
+
+    __MapJob__ job = {matrix, NULL, destination, func, NULL, __rowBlocks__(matrix->rows, (double)matrix->rows * matrix->columns)};
+    __poolRun__(job.blocks, __mapRows__, &job);
+    return true;
+}
+
+/**
+ * @brief Applies a unary function to every element of a matrix and returns a new matrix with the results.
+ * @param matrix The source matrix.
+ * @param func A function pointer that takes one double and returns a double.
+ * @return A pointer to the new result matrix, or NULL on failure.
+ * @note Large matrices are split into row blocks across the thread pool, so `func` must be thread-safe.
+ */
+Matrix *scalar(const Matrix *matrix, double (*func)(double))
+{
+    if (matrix == NULL || func == NULL)
+        return NULL;
+
+    Matrix *result = init(matrix->rows, matrix->columns);
+    if (result == NULL)
+        return NULL;
+
+    scalarInto(result, matrix, func);
+    return result;
+}
+
+/**
+ * @brief Applies a unary function to a specific row or column and returns the result as a new 1D array.
+ * @param matrix The source matrix.
+ * @param index The index of the row or column.
+ * @param axis A boolean flag: true for a column, false for a row.
+ * @param func A function pointer that takes one double and returns a double.
+ * @return A pointer to the new result array, or NULL on failure. The caller is responsible for freeing this memory.
+ */
+double *scalarField(const Matrix *matrix, const int index, const bool axis, double (*func)(double))
+{
+    if (matrix == NULL || func == NULL)
+        return NULL;
+
+    double *array;
+    if (axis) // apply to column
+    {
+        if (index < 0 || index >= matrix->columns)
+            return NULL;
+
+        array = (double *)malloc(matrix->rows * sizeof(double));
+        if (array == NULL)
+            return NULL;
+
+        for (int i = 0; i < matrix->rows; i++)
+            array[i] = func(matrix->grid[i][index]);
+    }
+    else // apply to row
+    {
+        if (index < 0 || index >= matrix->rows)
+            return NULL;
+
+        array = (double *)malloc(matrix->columns * sizeof(double));
+        if (array == NULL)
+            return NULL;
+
+        for (int j = 0; j < matrix->columns; j++)
+            array[j] = func(matrix->grid[index][j]);
+    }
+    return array;
+}
+
+/**
+ * @brief Applies a binary function to corresponding elements of two matrices, writing the results into an existing matrix.
+ * @param destination The matrix that receives the results. May be either source.
+ * @param matrix1 The first source matrix.
+ * @param matrix2 The second source matrix.
+ * @param func A function pointer that takes two doubles and returns a double.
+ * @return true on success, false if an argument is NULL or the shapes differ.
+ * @note Large matrices are split into row blocks across the thread pool, so `func` must be thread-safe.
+ */
+bool elementwiseInto(Matrix *destination, const Matrix *matrix1, const Matrix *matrix2, double (*func)(double, double))
+{
+    if (destination == NULL || matrix1 == NULL || matrix2 == NULL || func == NULL || matrix1->rows != matrix2->rows || matrix1->columns != matrix2->columns ||
+        destination->rows != matrix1->rows || destination->columns != matrix1->columns)
+        return false;
+
+    __MapJob__ job = {matrix1, matrix2, destination, NULL, func, __rowBlocks__(matrix1->rows, (double)matrix1->rows * matrix1->columns)};
+    __poolRun__(job.blocks, __mapRows__, &job);
+    return true;
+}
+
+/**
+ * @brief Applies a binary function to corresponding elements of two matrices and returns a new matrix with the results.
+ * @param matrix1 The first source matrix.
+ * @param matrix2 The second source matrix.
+ * @param func A function pointer that takes two doubles and returns a double.
+ * @return A pointer to the new result matrix, or NULL if matrices are incompatible or allocation fails.
+ * @note Large matrices are split into row blocks across the thread pool, so `func` must be thread-safe.
+ */
+Matrix *elementwise(const Matrix *matrix1, const Matrix *matrix2, double (*func)(double, double))
+{
+    if (matrix1 == NULL || matrix2 == NULL || func == NULL || matrix1->rows != matrix2->rows || matrix1->columns != matrix2->columns)
+        return NULL;
+
+    Matrix *result = init(matrix1->rows, matrix1->columns);
+    if (result == NULL)
+        return NULL;
+
+    elementwiseInto(result, matrix1, matrix2, func);
+    return result;
+}
+
+/**
+ * @brief Applies a binary function to a row or column of a matrix and a 1D array, returning the result as a new 1D array.
+ * @param matrix The source matrix.
+ * @param index The index of the row or column.
+ * @param axis A boolean flag: true for a column, false for a row.
+ * @param array The 1D array of values.
+ * @param func A function pointer that takes two doubles and returns a double.
+ * @return A pointer to the new result array, or NULL on failure. The caller is responsible for freeing this memory.
+ */
+double *elementwiseField(const Matrix *matrix, const int index, const bool axis, const double *array, double (*func)(double, double))
+{
+    if (matrix == NULL || array == NULL || func == NULL)
+        return NULL;
+
+    double *result;
+    if (axis) // apply to column
+    {
+        if (index < 0 || index >= matrix->columns)
+            return NULL;
+
+        result = (double *)malloc(matrix->rows * sizeof(double));
+        if (result == NULL)
+            return NULL;
+
+        for (int i = 0; i < matrix->rows; i++)
+            result[i] = func(matrix->grid[i][index], array[i]);
+    }
+    else // apply to row
+    {
+        if (index < 0 || index >= matrix->rows)
+            return NULL;
+
+        result = (double *)malloc(matrix->columns * sizeof(double));
+        if (result == NULL)
+            return NULL;
+
+        for (int j = 0; j < matrix->columns; j++)
+            result[j] = func(matrix->grid[index][j], array[j]);
+    }
+    return result;
+}
+
+/**
+ * @brief Rows of the register tile computed by one GEMM micro-kernel call.
+ * @note Six rows by eight columns keep twelve 4-wide AVX2 accumulators in registers.
+ */
+#define GEMM_MR 6
+
+/**
+ * @brief Columns of the register tile computed by one GEMM micro-kernel call.
+ */
+#define GEMM_NR 8
+
+/**
+ * @brief Rows of A packed per block; an MC x KC block of A is sized to stay in the L2 cache.
+ * @note Must be a multiple of GEMM_MR. Define this before including the header to override the default.
+ */
+#ifndef GEMM_MC
+#define GEMM_MC 96
+#endif
+
+/**
+ * @brief Depth of the packed panels; a KC x NR sliver of B is sized to stay in the L1 cache.
+ * @note Define this before including the header to override the default.
+ */
+#ifndef GEMM_KC
+#define GEMM_KC 256
+#endif
+
+/**
+ * @brief Columns of B packed per block; a KC x NC block of B is sized to stay in the L3 cache.
+ * @note Must be a multiple of GEMM_NR. Define this before including the header to override the default.
+ */
+#ifndef GEMM_NC
+#define GEMM_NC 2048
+#endif
+
+/**
+ * @brief Holds the result of __simdDetect__.
+ * @return A pointer to the cached SIMD level.
+ * @note This is a private helper function.
+ */
+int *__simdCache__()
+{
+    static int level = 0;
+    return &level;
+}
+
+/**
+ * @brief Detects AVX2 and FMA support and stores the answer in __simdCache__.
+ * @note This is a private helper function. Run exactly once, through pthread_once.
+ */
+void __simdDetect__()
+{
+#ifdef MATRIX_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        *__simdCache__() = 1;
+#endif
+}
+
+/**
+ * @brief Detects whether the GEMM micro-kernel can use AVX2 and FMA on this CPU.
+ * @return 1 for the AVX2/FMA kernel, or 0 for the portable scalar kernel.
+ * @note This is a private helper function. The answer is computed once and cached; the
+ * detection goes through pthread_once because the kernels also run on pool threads.
+ * @note Define MATRIX_NO_SIMD before including the header to always use the scalar kernel.
+ */
+int __simdLevel__()
+{
+    static pthread_once_t once = PTHREAD_ONCE_INIT;
+    pthread_once(&once, __simdDetect__);
+    return *__simdCache__();
+}
+
+/**
+ * @brief Computes one GEMM_MR x GEMM_NR tile of the product of two packed panels.
+ * @param depth The shared dimension of the panels.
+ * @param a A packed panel of A: `depth` groups of GEMM_MR values, one column of the block each.
+ * @param b A packed panel of B: `depth` groups of GEMM_NR values, one row of the block each.
+ * @param tile Receives the GEMM_MR x GEMM_NR product in row-major order.
+ * @note This is a private helper function.
+ */
+void __gemmKernelScalar__(const int depth, const double *a, const double *b, double *tile)
+{
+    double accumulator[GEMM_MR * GEMM_NR] = {0.0};
+    for (int p = 0; p < depth; p++, a += GEMM_MR, b += GEMM_NR)
+        for (int i = 0; i < GEMM_MR; i++)
+            for (int j = 0; j < GEMM_NR; j++)
+                accumulator[i * GEMM_NR + j] += a[i] * b[j];
+    memcpy(tile, accumulator, sizeof(accumulator));
+}
+
+#ifdef MATRIX_SIMD
+/**
+ * @brief AVX2/FMA variant of __gemmKernelScalar__.
+ * @param depth The shared dimension of the panels.
+ * @param a A packed panel of A.
+ * @param b A packed panel of B, aligned to 32 bytes.
+ * @param tile Receives the GEMM_MR x GEMM_NR product in row-major order.
+ * @note This is a private helper function. Only called after __simdLevel__ reports AVX2 and FMA.
+ * @note Keeps the whole 6 x 8 tile in twelve registers; each step broadcasts six values of A
+ * and issues twelve fused multiply-adds against two vectors of B.
+ */
+__attribute__((target("avx2,fma"))) void __gemmKernelAVX2__(const int depth, const double *a, const double *b, double *tile)
+{
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+    __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+    __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+    for (int p = 0; p < depth; p++, a += GEMM_MR, b += GEMM_NR)
+    {
+        __m256d b0 = _mm256_load_pd(b), b1 = _mm256_load_pd(b + 4);
+        __m256d ai = _mm256_broadcast_sd(a);
+        c00 = _mm256_fmadd_pd(ai, b0, c00);
+        c01 = _mm256_fmadd_pd(ai, b1, c01);
+        ai = _mm256_broadcast_sd(a + 1);
+        c10 = _mm256_fmadd_pd(ai, b0, c10);
+        c11 = _mm256_fmadd_pd(ai, b1, c11);
+        ai = _mm256_broadcast_sd(a + 2);
+        c20 = _mm256_fmadd_pd(ai, b0, c20);
+        c21 = _mm256_fmadd_pd(ai, b1, c21);
+        ai = _mm256_broadcast_sd(a + 3);
+        c30 = _mm256_fmadd_pd(ai, b0, c30);
+        c31 = _mm256_fmadd_pd(ai, b1, c31);
+        ai = _mm256_broadcast_sd(a + 4);
+        c40 = _mm256_fmadd_pd(ai, b0, c40);
+        c41 = _mm256_fmadd_pd(ai, b1, c41);
+        ai = _mm256_broadcast_sd(a + 5);
+        c50 = _mm256_fmadd_pd(ai, b0, c50);
+        c51 = _mm256_fmadd_pd(ai, b1, c51);
+    }
+    _mm256_storeu_pd(tile + 0, c00);
+    _mm256_storeu_pd(tile + 4, c01);
+    _mm256_storeu_pd(tile + 8, c10);
+    _mm256_storeu_pd(tile + 12, c11);
+    _mm256_storeu_pd(tile + 16, c20);
+    _mm256_storeu_pd(tile + 20, c21);
+    _mm256_storeu_pd(tile + 24, c30);
+    _mm256_storeu_pd(tile + 28, c31);
+    _mm256_storeu_pd(tile + 32, c40);
+    _mm256_storeu_pd(tile + 36, c41);
+    _mm256_storeu_pd(tile + 40, c50);
+    _mm256_storeu_pd(tile + 44, c51);
+}
+#endif
+
+/**
+ * @brief Runs the AVX2/FMA or scalar GEMM micro-kernel, whichever the CPU supports.
+ * @param depth The shared dimension of the panels.
+ * @param a A packed panel of A.
+ * @param b A packed panel of B.
+ * @param tile Receives the GEMM_MR x GEMM_NR product in row-major order.
+ * @note This is a private helper function.
+ */
+void __gemmKernel__(const int depth, const double *a, const double *b, double *tile)
+{
+#ifdef MATRIX_SIMD
+    if (__simdLevel__())
+    {
+        __gemmKernelAVX2__(depth, a, b, tile);
+        return;
+    }
+#endif
+    __gemmKernelScalar__(depth, a, b, tile);
+}
+
+/**
+ * @brief Packs a block of A into row panels of GEMM_MR rows, zero-padding the last panel.
+ * @param a The view to pack from.
+ * @param fromRow The first row of the block.
+ * @param rows The number of rows in the block.
+ * @param fromColumn The first column of the block.
+ * @param depth The number of columns in the block.
+ * @param packed The destination buffer.
+ * @note This is a private helper function. Panel p holds `depth` groups of GEMM_MR values.
+ */
+void __packA__(const MatrixView a, const int fromRow, const int rows, const int fromColumn, const int depth, double *packed)
+{
+    for (int panel = 0; panel < rows; panel += GEMM_MR)
+    {
+        int height = rows - panel < GEMM_MR ? rows - panel : GEMM_MR;
+        for (int p = 0; p < depth; p++, packed += GEMM_MR)
+        {
+            const double *source = a.data + (ptrdiff_t)(fromRow + panel) * a.rowStride + (ptrdiff_t)(fromColumn + p) * a.columnStride;
+            int i = 0;
+            for (; i < height; i++)
+                packed[i] = source[(ptrdiff_t)i * a.rowStride];
+            for (; i < GEMM_MR; i++)
+                packed[i] = 0.0;
+        }
+    }
+}
+
+/**
+ * @brief Packs a block of B into column panels of GEMM_NR columns, zero-padding the last panel.
+ * @param b The view to pack from.
+ * @param fromRow The first row of the block.
+ * @param depth The number of rows in the block.
+ * @param fromColumn The first column of the block.
+ * @param columns The number of columns in the block.
+ * @param packed The destination buffer.
+ * @note This is a private helper function. Panel p holds `depth` groups of GEMM_NR values.
+ */
+void __packB__(const MatrixView b, const int fromRow, const int depth, const int fromColumn, const int columns, double *packed)
+{
+    for (int panel = 0; panel < columns; panel += GEMM_NR)
+    {
+        int width = columns - panel < GEMM_NR ? columns - panel : GEMM_NR;
+        for (int p = 0; p < depth; p++, packed += GEMM_NR)
+        {
+            const double *source = b.data + (ptrdiff_t)(fromRow + p) * b.rowStride + (ptrdiff_t)(fromColumn + panel) * b.columnStride;
+            int j = 0;
+            if (b.columnStride == 1)
+                for (; j < width; j++)
+                    packed[j] = source[j];
+            else
+                for (; j < width; j++)
+                    packed[j] = source[(ptrdiff_t)j * b.columnStride];
+            for (; j < GEMM_NR; j++)
+                packed[j] = 0.0;
+        }
+    }
+}
+
+/**
+ * @brief Adds a scaled micro-kernel tile into a block of C.
+ * @param c The view to update.
+ * @param row The row of C where the tile starts.
+ * @param column The column of C where the tile starts.
+ * @param rows The number of valid rows in the tile.
+ * @param columns The number of valid columns in the tile.
+ * @param alpha The scale factor applied to the tile.
+ * @param tile The GEMM_MR x GEMM_NR tile.
+ * @note This is a private helper function.
+ */
+void __gemmUpdate__(const MatrixView c, const int row, const int column, const int rows, const int columns, const double alpha, const double *tile)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        double *target = c.data + (ptrdiff_t)(row + i) * c.rowStride + (ptrdiff_t)column * c.columnStride;
+        if (c.columnStride == 1)
+            for (int j = 0; j < columns; j++)
+                target[j] += alpha * tile[i * GEMM_NR + j];
+        else
+            for (int j = 0; j < columns; j++)
+                target[(ptrdiff_t)j * c.columnStride] += alpha * tile[i * GEMM_NR + j];
+    }
+}
+
+/**
+ * @brief Number of doubles in the packed B panels of a GEMM on an m x k by k x n block.
+ * @param n The number of columns of B.
+ * @param k The shared dimension.
+ * @return The size of the B part of the packing buffer.
+ * @note This is a private helper function.
+ */
+size_t __gemmPackedB__(const int n, const int k)
+{
+    int columns = n < GEMM_NC ? (n + GEMM_NR - 1) / GEMM_NR * GEMM_NR : GEMM_NC;
+    return (size_t)(k < GEMM_KC ? k : GEMM_KC) * columns;
+}
+
+/**
+ * @brief Allocates the aligned buffer that holds the packed A and B panels of a GEMM block.
+ * @param m The number of rows of A.
+ * @param n The number of columns of B.
+ * @param k The shared dimension.
+ * @return The buffer, or NULL if allocation fails. The caller frees it.
+ * @note This is a private helper function. B comes first so its panels stay 32-byte aligned.
+ */
+double *__gemmBuffer__(const int m, const int n, const int k)
+{
+    int rows = m < GEMM_MC ? (m + GEMM_MR - 1) / GEMM_MR * GEMM_MR : GEMM_MC;
+    size_t doubles = __gemmPackedB__(n, k) + (size_t)rows * (k < GEMM_KC ? k : GEMM_KC);
+    size_t bytes = (doubles * sizeof(double) + MATRIX_ALIGNMENT - 1) / MATRIX_ALIGNMENT * MATRIX_ALIGNMENT;
+    return (double *)aligned_alloc(MATRIX_ALIGNMENT, bytes);
+}
+
+/**
+ * @brief Computes C = alpha * A * B + beta * C on the calling thread.
+ * @param alpha The scale factor of the product.
+ * @param a The left operand, an m x k view.
+ * @param b The right operand, a k x n view.
+ * @param beta The scale factor of the existing contents of C.
+ * @param c The m x n destination view.
+ * @param buffer A packing buffer from __gemmBuffer__(m, n, k).
+ * @note This is a private helper function. The dimensions are assumed to be valid.
+ */
+void __gemmBlock__(const double alpha, const MatrixView a, const MatrixView b, const double beta, const MatrixView c, double *buffer)
+{
+    int m = c.rows, n = c.columns, k = a.columns;
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < n; j++)
+        {
+            double *target = c.data + (ptrdiff_t)i * c.rowStride + (ptrdiff_t)j * c.columnStride;
+            *target = beta == 0.0 ? 0.0 : beta * *target;
+        }
+    if (alpha == 0.0)
+        return;
+
+    double *packedB = buffer;
+    double *packedA = buffer + __gemmPackedB__(n, k);
+    double tile[GEMM_MR * GEMM_NR];
+    for (int jc = 0; jc < n; jc += GEMM_NC)
+    {
+        int nc = n - jc < GEMM_NC ? n - jc : GEMM_NC;
+        for (int pc = 0; pc < k; pc += GEMM_KC)
+        {
+            int kc = k - pc < GEMM_KC ? k - pc : GEMM_KC;
+            __packB__(b, pc, kc, jc, nc, packedB);
+            for (int ic = 0; ic < m; ic += GEMM_MC)
+            {
+                int mc = m - ic < GEMM_MC ? m - ic : GEMM_MC;
+                __packA__(a, ic, mc, pc, kc, packedA);
+                for (int jr = 0; jr < nc; jr += GEMM_NR)
+                    for (int ir = 0; ir < mc; ir += GEMM_MR)
+                    {
+                        __gemmKernel__(kc, packedA + (size_t)ir * kc, packedB + (size_t)jr * kc, tile);
+                        __gemmUpdate__(c, ic + ir, jc + jr, mc - ir < GEMM_MR ? mc - ir : GEMM_MR,
+                                       nc - jr < GEMM_NR ? nc - jr : GEMM_NR, alpha, tile);
+                    }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Work (m * n * k) from which gemm() splits C into tiles across the thread pool.
+ * @note Define this before including the header to override the default.
+ */
+#ifndef GEMM_PARALLEL_WORK
+#define GEMM_PARALLEL_WORK 2097152
+#endif
+
+/**
+ * @brief Widest tile of C computed by one parallel GEMM task.
+ * @note Must be a multiple of GEMM_NR. Define this before including the header to override the default.
+ */
+#ifndef GEMM_TILE_NC
+#define GEMM_TILE_NC 512
+#endif
+
+/**
+ * @brief Shared state of a parallel gemm() call.
+ * @details C is cut into a grid of tileRows x tileColumns tiles; each task computes one tile
+ * with the packing buffer of the worker that runs it, allocated on first use.
+ * @note This is a private helper type.
+ */
+typedef struct
+{
+    double alpha;
+    double beta;
+    MatrixView a;
+    MatrixView b;
+    MatrixView c;
+    int tileRows;
+    int tileColumns;
+    int columnTiles;
+    double **buffers;
+    bool *failed;
+} __GemmJob__;
+
+/**
+ * @brief Computes one tile of C for a __GemmJob__.
+ * @param context The __GemmJob__.
+ * @param task The index of the tile, row-major over the tile grid.
+ * @param worker The index of the worker, which selects the packing buffer.
+ * @note This is a private helper function.
+ */
+void __gemmTile__(void *context, const int task, const int worker)
+{
+    __GemmJob__ *job = (__GemmJob__ *)context;
+    if (job->buffers[worker] == NULL)
+    {
+        job->buffers[worker] = __gemmBuffer__(job->tileRows, job->tileColumns, job->a.columns);
+        if (job->buffers[worker] == NULL)
+        {
+            job->failed[worker] = true;
+            return;
+        }
+    }
+
+    int fromRow = task / job->columnTiles * job->tileRows;
+    int fromColumn = task % job->columnTiles * job->tileColumns;
+    int toRow = fromRow + job->tileRows < job->c.rows ? fromRow + job->tileRows : job->c.rows;
+    int toColumn = fromColumn + job->tileColumns < job->c.columns ? fromColumn + job->tileColumns : job->c.columns;
+    __gemmBlock__(job->alpha, sliceView(job->a, fromRow, toRow, 0, job->a.columns),
+                  sliceView(job->b, 0, job->b.rows, fromColumn, toColumn), job->beta,
+                  sliceView(job->c, fromRow, toRow, fromColumn, toColumn), job->buffers[worker]);
+}
+
+/**
+ * @brief Computes C = alpha * A * B + beta * C for arbitrary strided views (general matrix multiply).
+ * @param alpha The scale factor of the product.
+ * @param a The left operand, an m x k view.
+ * @param b The right operand, a k x n view.
+ * @param beta The scale factor of the existing contents of C; 0 ignores them, even if they are NaN.
+ * @param c The m x n destination view. It must not overlap A or B.
+ * @return true on success, or false if a view is empty, the dimensions do not match, or allocation fails.
+ * @note Follows the BLIS/GotoBLAS blocking: B is packed in KC x NC blocks (L3), A in MC x KC
+ * blocks (L2), and a register-blocked GEMM_MR x GEMM_NR micro-kernel (AVX2/FMA when available)
+ * streams through KC x NR slivers of B that stay in L1. Any view layout, including transposed
+ * views, is handled by the packing step.
+ * @note Products of at least GEMM_PARALLEL_WORK multiply-adds are split into 2D tiles of C
+ * that the thread pool computes independently.
+ */
+bool gemm(const double alpha, const MatrixView a, const MatrixView b, const double beta, const MatrixView c)
+{
+    if (a.data == NULL || b.data == NULL || c.data == NULL || a.columns != b.rows || a.rows != c.rows || b.columns != c.columns)
+        return false;
+
+    int m = c.rows, n = c.columns, k = a.columns;
+    int threads = (double)m * n * k < GEMM_PARALLEL_WORK ? 1 : getThreads();
+    if (threads == 1)
+    {
+        double *buffer = __gemmBuffer__(m, n, k);
+        if (buffer == NULL)
+            return false;
+        __gemmBlock__(alpha, a, b, beta, c, buffer);
+        free(buffer);
+        return true;
+    }
+
+    // Aim for at least two tiles per thread, cutting columns only as finely as needed.
+    int rowTiles = (m + GEMM_MC - 1) / GEMM_MC;
+    int columnTiles = (2 * threads + rowTiles - 1) / rowTiles;
+    int tileColumns = ((n + columnTiles - 1) / columnTiles + GEMM_NR - 1) / GEMM_NR * GEMM_NR;
+    if (tileColumns > GEMM_TILE_NC)
+        tileColumns = GEMM_TILE_NC;
+    __GemmJob__ job = {alpha, beta, a, b, c, GEMM_MC, tileColumns, (n + tileColumns - 1) / tileColumns, NULL, NULL};
+    job.buffers = (double **)calloc(threads, sizeof(double *));
+    job.failed = (bool *)calloc(threads, sizeof(bool));
+    bool success = job.buffers != NULL && job.failed != NULL;
+    if (success)
+        __poolRun__(rowTiles * job.columnTiles, __gemmTile__, &job);
+
+    for (int t = 0; success && t < threads; t++)
+        if (job.failed[t])
+            success = false;
+    for (int t = 0; job.buffers != NULL && t < threads; t++)
+        free(job.buffers[t]);
+    free(job.buffers);
+    free(job.failed);
+    return success;
+}
+
+/**
+ * @brief Work (m * n * k) below which dot() uses a simple loop instead of the packed GEMM.
+ * @note Define this before including the header to override the default.
+ */
+#ifndef GEMM_SMALL_WORK
+#define GEMM_SMALL_WORK 32768
+#endif
+
+/**
+ * @brief Computes the product of two matrices into an existing matrix.
+ * @param destination The matrix that receives the product. Must not be either source.
+ * @param matrix1 The left matrix.
+ * @param matrix2 The right matrix.
+ * @return true on success, false if a matrix is NULL, the shapes do not match, the destination
+ * aliases a source, or gemm() fails to allocate its packing buffers.
+ * @note Small products use a simple loop and larger ones gemm(), as in dot.
+ */
+bool dotInto(Matrix *destination, const Matrix *matrix1, const Matrix *matrix2)
+{
+    if (destination == NULL || matrix1 == NULL || matrix2 == NULL || destination == matrix1 || destination == matrix2 ||
+        matrix1->columns != matrix2->rows || destination->rows != matrix1->rows || destination->columns != matrix2->columns)
+        return false;
+
+    if ((double)destination->rows * destination->columns * matrix1->columns <= GEMM_SMALL_WORK)
+    {
+        // i-k-j order streams rows of matrix2 and the destination instead of walking matrix2 by column.
+        for (int i = 0; i < destination->rows; i++)
+        {
+            double *target = destination->grid[i];
+            memset(target, 0, destination->columns * sizeof(double));
+            for (int k = 0; k < matrix1->columns; k++)
+            {
+                double factor = matrix1->grid[i][k];
+                for (int j = 0; j < destination->columns; j++)
+                    target[j] += factor * matrix2->grid[k][j];
+            }
+        }
+        return true;
+    }
+
+    return gemm(1.0, view(matrix1), view(matrix2), 0.0, view(destination));
+}
+
+/**
+ * @brief Performs matrix multiplication (dot product) of two matrices.
+ * @param matrix1 The first matrix.
+ * @param matrix2 The second matrix.
+ * @return A pointer to the resulting matrix, or NULL if the matrices are not compatible for multiplication.
+ * @note Small products use a simple loop; larger ones use the blocked, packed gemm() engine.
+ */
+Matrix *dot(const Matrix *matrix1, const Matrix *matrix2)
+{
+    if (matrix1 == NULL || matrix2 == NULL || matrix1->columns != matrix2->rows)
+        return NULL;
+
+    Matrix *result = init(matrix1->rows, matrix2->columns);
+    if (result == NULL)
+        return NULL;
+
+    if (!dotInto(result, matrix1, matrix2))
+    {
+        destroy(result);
+        return NULL;
+    }
+    return result;
+}
+
+/**
+ * @brief Default size at or below which strassen() stops recursing and calls gemm().
+ * @note Each level of recursion saves one multiplication in eight but adds 15 additions of
+ * quarter-sized matrices and loses some precision, so the crossover should be well above the
+ * point where gemm() reaches full speed. Run the 'strassen' benchmark to find it on a machine.
+ * @note Define this before including the header to override the default.
+ */
+#ifndef STRASSEN_CROSSOVER
+#define STRASSEN_CROSSOVER 1024
+#endif
+
+/**
+ * @brief Computes the workspace strassen() needs for an n x n product.
+ * @param n The size of the product.
+ * @param crossover The size at or below which the recursion stops.
+ * @return The number of doubles of workspace.
+ * @note This is a private helper function. Every level needs two h x h temporaries, where h is half
+ * its (even) size, followed by the workspace of the level below it.
+ */
+size_t __strassenWorkspace__(const int n, const int crossover)
+{
+    if (n <= crossover)
+        return 0;
+    if (n % 2 != 0)
+        return __strassenWorkspace__(n - 1, crossover);
+    int h = n / 2;
+    return 2 * (size_t)h * h + __strassenWorkspace__(h, crossover);
+}
+
+/**
+ * @brief Computes c = a + sign * b element by element on views of the same shape.
+ * @param a The first operand.
+ * @param b The second operand.
+ * @param sign 1.0 to add or -1.0 to subtract.
+ * @param c The destination, which may be a or b.
+ * @note This is a private helper function.
+ */
+void __strassenAdd__(const MatrixView a, const MatrixView b, const double sign, const MatrixView c)
+{
+    for (int i = 0; i < c.rows; i++)
+    {
+        const double *x = a.data + (ptrdiff_t)i * a.rowStride;
+        const double *y = b.data + (ptrdiff_t)i * b.rowStride;
+        double *z = c.data + (ptrdiff_t)i * c.rowStride;
+        for (int j = 0; j < c.columns; j++)
+            z[j] = x[j] + sign * y[j];
+    }
+}
+
+/**
+ * @brief Computes c = a * b for square row-major views with the Strassen-Winograd recursion.
+ * @param a The left operand, n x n.
+ * @param b The right operand, n x n.
+ * @param c The destination, n x n. Must not overlap a, b or the workspace.
+ * @param workspace At least __strassenWorkspace__(n, crossover) doubles.
+ * @param crossover The size at or below which gemm() is called instead.
+ * @return true on success, false if gemm() fails to allocate its packing buffers.
+ * @note This is a private helper function. It follows the schedule of Boyer, Dumas, Pernet and
+ * Zhou: seven half-sized products and fifteen additions, with the quadrants of c doubling as
+ * storage so that only two temporaries, X and Y, are needed per level. An odd size peels off the
+ * last row and column and fixes them up with three thin gemm() calls.
+ */
+bool __strassen__(const MatrixView a, const MatrixView b, const MatrixView c, double *workspace, const int crossover)
+{
+    int n = c.rows;
+    if (n <= crossover)
+        return gemm(1.0, a, b, 0.0, c);
+    if (n % 2 != 0)
+    {
+        int m = n - 1;
+        MatrixView c11 = sliceView(c, 0, m, 0, m);
+        return __strassen__(sliceView(a, 0, m, 0, m), sliceView(b, 0, m, 0, m), c11, workspace, crossover) &&
+               gemm(1.0, sliceView(a, 0, m, m, n), sliceView(b, m, n, 0, m), 1.0, c11) &&
+               gemm(1.0, a, sliceView(b, 0, n, m, n), 0.0, sliceView(c, 0, n, m, n)) &&
+               gemm(1.0, sliceView(a, m, n, 0, n), sliceView(b, 0, n, 0, m), 0.0, sliceView(c, m, n, 0, m));
+    }
+
+    int h = n / 2;
+    MatrixView a11 = sliceView(a, 0, h, 0, h), a12 = sliceView(a, 0, h, h, n);
+    MatrixView a21 = sliceView(a, h, n, 0, h), a22 = sliceView(a, h, n, h, n);
+    MatrixView b11 = sliceView(b, 0, h, 0, h), b12 = sliceView(b, 0, h, h, n);
+    MatrixView b21 = sliceView(b, h, n, 0, h), b22 = sliceView(b, h, n, h, n);
+    MatrixView c11 = sliceView(c, 0, h, 0, h), c12 = sliceView(c, 0, h, h, n);
+    MatrixView c21 = sliceView(c, h, n, 0, h), c22 = sliceView(c, h, n, h, n);
+    MatrixView x = {workspace, h, h, h, 1};
+    MatrixView y = {workspace + (size_t)h * h, h, h, h, 1};
+    double *next = workspace + 2 * (size_t)h * h;
+
+    __strassenAdd__(a11, a21, -1.0, x);                        // S3 = A11 - A21
+    __strassenAdd__(b22, b12, -1.0, y);                        // T3 = B22 - B12
+    if (!__strassen__(x, y, c21, next, crossover))             // P7 = S3 T3
+        return false;
+    __strassenAdd__(a21, a22, 1.0, x);                         // S1 = A21 + A22
+    __strassenAdd__(b12, b11, -1.0, y);                        // T1 = B12 - B11
+    if (!__strassen__(x, y, c22, next, crossover))             // P5 = S1 T1
+        return false;
+    __strassenAdd__(x, a11, -1.0, x);                          // S2 = S1 - A11
+    __strassenAdd__(b22, y, -1.0, y);                          // T2 = B22 - T1
+    if (!__strassen__(x, y, c12, next, crossover))             // P6 = S2 T2
+        return false;
+    __strassenAdd__(a12, x, -1.0, x);                          // S4 = A12 - S2
+    if (!__strassen__(x, b22, c11, next, crossover))           // P3 = S4 B22
+        return false;
+    if (!__strassen__(a11, b11, x, next, crossover))           // P1 = A11 B11
+        return false;
+    __strassenAdd__(x, c12, 1.0, c12);                         // U2 = P1 + P6
+    __strassenAdd__(c12, c21, 1.0, c21);                       // U3 = U2 + P7
+    __strassenAdd__(c12, c22, 1.0, c12);                       // U4 = U2 + P5
+    __strassenAdd__(c21, c22, 1.0, c22);                       // U7 = U3 + P5 = C22
+    __strassenAdd__(c12, c11, 1.0, c12);                       // U5 = U4 + P3 = C12
+    __strassenAdd__(y, b21, -1.0, y);                          // T4 = T2 - B21
+    if (!__strassen__(a22, y, c11, next, crossover))           // P4 = A22 T4
+        return false;
+    __strassenAdd__(c21, c11, -1.0, c21);                      // U6 = U3 - P4 = C21
+    if (!__strassen__(a12, b21, c11, next, crossover))         // P2 = A12 B21
+        return false;
+    __strassenAdd__(x, c11, 1.0, c11);                         // U1 = P1 + P2 = C11
+    return true;
+}
+
+/**
+ * @brief Multiplies two matrices with the Strassen-Winograd algorithm.
+ * @param matrix1 The left matrix.
+ * @param matrix2 The right matrix.
+ * @param crossover The size at or below which the recursion hands over to gemm(), or 0 for
+ * STRASSEN_CROSSOVER.
+ * @return A pointer to the new resulting matrix, or NULL if the dimensions are incompatible or allocation fails.
+ * @note Square products larger than the crossover are split recursively into seven half-sized
+ * products instead of eight, for O(n^2.81) work. The temporaries of every level come from one
+ * workspace of about (2/3) n^2 doubles, allocated once per call. Non-square products are
+ * computed by dot().
+ * @note The result is less accurate than dot(): the error bound grows by a small constant factor
+ * with every level of recursion. Raise the crossover to trade speed for precision.
+ */
+Matrix *strassen(const Matrix *matrix1, const Matrix *matrix2, const int crossover)
+{
+    if (matrix1 == NULL || matrix2 == NULL || matrix1->columns != matrix2->rows || crossover < 0)
+        return NULL;
+    if (matrix1->rows != matrix1->columns || matrix2->rows != matrix2->columns)
+        return dot(matrix1, matrix2);
+
+    int n = matrix1->rows, limit = crossover > 0 ? crossover : STRASSEN_CROSSOVER;
+    Matrix *result = init(n, n);
+    if (result == NULL)
+        return NULL;
+    size_t size = __strassenWorkspace__(n, limit);
+    double *workspace = size > 0 ? (double *)malloc(size * sizeof(double)) : NULL;
+    if ((size > 0 && workspace == NULL) || !__strassen__(view(matrix1), view(matrix2), view(result), workspace, limit))
+    {
+        free(workspace);
+        destroy(result);
+        return NULL;
+    }
+    free(workspace);
+    return result;
+}
+
+/**
+ * @brief Width of the column panels factorized at a time by factorize().
+ * @note Define this before including the header to override the default.
+ */
+#ifndef LU_BLOCK
+#define LU_BLOCK 96
+#endif
+
+/**
+ * @struct LUFactor
+ * @brief The LU factorization with partial pivoting, P * A = L * U, of a square matrix.
+ * @var lu L below the diagonal (its unit diagonal is implied) and U on and above it.
+ * @var pivot Row i of `lu` comes from row `pivot[i]` of the original matrix.
+ * @var sign The sign of the permutation, +1 or -1.
+ * @var singular Whether a pivot smaller than 1e-12 was met; a singular factor cannot solve systems.
+ */
+typedef struct
+{
+    Matrix *lu;
+    int *pivot;
+    int sign;
+    bool singular;
+} LUFactor;
+
+/**
+ * @brief Deallocates a factorization.
+ * @param factor The factorization to destroy. Can be NULL.
+ */
+void destroyFactor(LUFactor *factor)
+{
+    if (factor == NULL)
+        return;
+    destroy(factor->lu);
+    free(factor->pivot);
+    free(factor);
+}
+
+/**
+ * @brief Swaps the contents of two rows of a matrix.
+ * @param matrix The matrix.
+ * @param row1 The first row.
+ * @param row2 The second row.
+ * @note This is a private helper function. Swapping elements, not row pointers, keeps the rows
+ * at their place in `data`, so views of the matrix stay consistent.
+ */
+void __swapRows__(Matrix *matrix, const int row1, const int row2)
+{
+    double *first = matrix->grid[row1], *second = matrix->grid[row2];
+    for (int j = 0; j < matrix->columns; j++)
+    {
+        double temp = first[j];
+        first[j] = second[j];
+        second[j] = temp;
+    }
+}
+
+/**
+ * @brief Factorizes one column panel with the unblocked algorithm, applying row swaps across the whole matrix.
+ * @param factor The factorization in progress.
+ * @param from The first column of the panel.
+ * @param width The number of columns in the panel.
+ * @note This is a private helper function. Only the columns of the panel are updated; the
+ * columns to its right are brought up to date by factorize().
+ */
+void __factorPanel__(LUFactor *factor, const int from, const int width)
+{
+    Matrix *a = factor->lu;
+    int n = a->rows;
+    for (int col = from; col < from + width; col++)
+    {
+        int best = col;
+        for (int r = col + 1; r < n; r++)
+            if (fabs(a->grid[r][col]) > fabs(a->grid[best][col]))
+                best = r;
+        if (best != col)
+        {
+            __swapRows__(a, col, best);
+            int temp = factor->pivot[col];
+            factor->pivot[col] = factor->pivot[best];
+            factor->pivot[best] = temp;
+            factor->sign = -factor->sign;
+        }
+
+        if (fabs(a->grid[col][col]) < 1e-12)
+        {
+            factor->singular = true;
+            continue;
+        }
+
+        const double *pivotRow = a->grid[col];
+        for (int r = col + 1; r < n; r++)
+        {
+            double *row = a->grid[r];
+            double multiplier = row[col] /= pivotRow[col];
+            for (int j = col + 1; j < from + width; j++)
+                row[j] -= multiplier * pivotRow[j];
+        }
+    }
+}
+
+/**
+ * @brief Computes the LU factorization with partial pivoting of a square matrix.
+ * @param matrix The square matrix to factorize. It is not modified.
+ * @return A pointer to the new factorization, or NULL if the matrix is not square or allocation fails.
+ * A singular matrix still yields a factorization, with `singular` set.
+ * @note Blocked, right-looking algorithm: each LU_BLOCK-wide panel is factorized unblocked,
+ * the block row to its right is solved against the panel's unit lower triangle, and the
+ * trailing matrix is updated with a single gemm() call, which does almost all of the work and
+ * runs on the thread pool for large matrices.
+ */
+LUFactor *factorize(const Matrix *matrix)
+{
+    if (matrix == NULL || matrix->rows != matrix->columns)
+        return NULL;
+
+    LUFactor *factor = (LUFactor *)malloc(sizeof(LUFactor));
+    if (factor == NULL)
+        return NULL;
+    int n = matrix->rows;
+    factor->lu = copy(matrix);
+    factor->pivot = (int *)malloc(n * sizeof(int));
+    factor->sign = 1;
+    factor->singular = false;
+    if (factor->lu == NULL || factor->pivot == NULL)
+    {
+        destroyFactor(factor);
+        return NULL;
+    }
+    for (int i = 0; i < n; i++)
+        factor->pivot[i] = i;
+
+    double **grid = factor->lu->grid;
+    MatrixView whole = view(factor->lu);
+    for (int from = 0; from < n; from += LU_BLOCK)
+    {
+        int width = n - from < LU_BLOCK ? n - from : LU_BLOCK;
+        int next = from + width;
+        __factorPanel__(factor, from, width);
+        if (next == n)
+            break;
+
+        // U12 = inverse(L11) * A12
+        for (int i = from + 1; i < next; i++)
+            for (int p = from; p < i; p++)
+            {
+                double multiplier = grid[i][p];
+                for (int j = next; j < n; j++)
+                    grid[i][j] -= multiplier * grid[p][j];
+            }
+
+        // A22 -= L21 * U12
+        if (!gemm(-1.0, sliceView(whole, next, n, from, next), sliceView(whole, from, next, next, n), 1.0,
+                  sliceView(whole, next, n, next, n)))
+        {
+            destroyFactor(factor);
+            return NULL;
+        }
+    }
+    return factor;
+}
+
+/**
+ * @brief Solves the system A * x = b using a factorization of A.
+ * @param factor The factorization of A.
+ * @param b The right-hand side, an array of n values.
+ * @return A pointer to the new solution array, or NULL if the factor is singular or allocation fails.
+ * The caller is responsible for freeing this memory.
+ * @note Costs two triangular solves, O(n^2), rather than an inverse.
+ */
+double *solve(const LUFactor *factor, const double *b)
+{
+    if (factor == NULL || b == NULL || factor->singular)
+        return NULL;
+
+    int n = factor->lu->rows;
+    double **lu = factor->lu->grid;
+    double *x = (double *)malloc(n * sizeof(double));
+    if (x == NULL)
+        return NULL;
+
+    // Forward substitution (L * y = P * b)
+    for (int i = 0; i < n; i++)
+    {
+        x[i] = b[factor->pivot[i]];
+        for (int j = 0; j < i; j++)
+            x[i] -= lu[i][j] * x[j];
+    }
+
+    // Back substitution (U * x = y)
+    for (int i = n - 1; i >= 0; i--)
+    {
+        for (int j = i + 1; j < n; j++)
+            x[i] -= lu[i][j] * x[j];
+        x[i] /= lu[i][i];
+    }
+    return x;
+}
+
+/**
+ * @brief Shared state of the parallel triangular solves of solveMany() and factorInverse().
+ * @note This is a private helper type.
+ */
+typedef struct
+{
+    const Matrix *factors;
+    Matrix *solution;
+    int blocks;
+} __SolveJob__;
+
+/**
+ * @brief Solves L * U * X = Y in place for one block of columns, where X holds Y on entry.
+ * @param context The __SolveJob__.
+ * @param block The index of the column block.
+ * @param worker Unused.
+ * @note This is a private helper function. Works on whole row segments of the block so the
+ * inner loops run over contiguous memory.
+ */
+void __solveColumns__(void *context, const int block, const int worker)
+{
+    (void)worker;
+    __SolveJob__ *job = (__SolveJob__ *)context;
+    double **lu = job->factors->grid, **x = job->solution->grid;
+    int n = job->solution->rows, columns = job->solution->columns;
+    int from = (int)((long long)columns * block / job->blocks);
+    int to = (int)((long long)columns * (block + 1) / job->blocks);
+
+    // Forward substitution (L * Y = P * B)
+    for (int i = 1; i < n; i++)
+        for (int j = 0; j < i; j++)
+            for (int col = from; col < to; col++)
+                x[i][col] -= lu[i][j] * x[j][col];
+
+    // Back substitution (U * X = Y)
+    for (int i = n - 1; i >= 0; i--)
+    {
+        for (int j = i + 1; j < n; j++)
+            for (int col = from; col < to; col++)
+                x[i][col] -= lu[i][j] * x[j][col];
+        for (int col = from; col < to; col++)
+            x[i][col] /= lu[i][i];
+    }
+}
+
+/**
+ * @brief Solves the system A * X = B in place, where X holds the permuted right-hand sides P * B on entry.
+ * @param factor The factorization of A.
+ * @param solution The permuted right-hand sides, overwritten with the solution.
+ * @note This is a private helper function. Blocks of columns are solved in parallel for large systems.
+ */
+void __solveInPlace__(const LUFactor *factor, Matrix *solution)
+{
+    __SolveJob__ job = {factor->lu, solution, __rowBlocks__(solution->columns, (double)solution->rows * solution->columns)};
+    __poolRun__(job.blocks, __solveColumns__, &job);
+}
+
+/**
+ * @brief Solves the system A * X = B for several right-hand sides at once using a factorization of A.
+ * @param factor The factorization of A.
+ * @param b The right-hand sides, one per column, with as many rows as A.
+ * @return A pointer to the new solution matrix, or NULL if the factor is singular, the dimensions do not match, or allocation fails.
+ */
+Matrix *solveMany(const LUFactor *factor, const Matrix *b)
+{
+    if (factor == NULL || b == NULL || factor->singular || b->rows != factor->lu->rows)
+        return NULL;
+
+    Matrix *x = init(b->rows, b->columns);
+    if (x == NULL)
+        return NULL;
+    for (int i = 0; i < x->rows; i++)
+        memcpy(x->grid[i], b->grid[factor->pivot[i]], x->columns * sizeof(double));
+    __solveInPlace__(factor, x);
+    return x;
+}
+
+/**
+ * @brief Returns the determinant of the factorized matrix.
+ * @param factor The factorization.
+ * @return The determinant, or 0.0 if the factor is NULL or singular.
+ */
+double factorDeterminant(const LUFactor *factor)
+{
+    if (factor == NULL || factor->singular)
+        return 0.0;
+
+    double det = factor->sign;
+    for (int i = 0; i < factor->lu->rows; i++)
+        det *= factor->lu->grid[i][i]; // product of U diagonal
+    return det;
+}
+
+/**
+ * @brief Computes the inverse of the factorized matrix.
+ * @param factor The factorization.
+ * @return A pointer to the inverse matrix, or NULL if the factor is NULL or singular, or allocation fails.
+ * @note Prefer solve() or solveMany() when the inverse is only needed to solve systems.
+ */
+Matrix *factorInverse(const LUFactor *factor)
+{
+    if (factor == NULL || factor->singular)
+        return NULL;
+
+    int n = factor->lu->rows;
+    Matrix *x = init(n, n);
+    if (x == NULL)
+        return NULL;
+    for (int i = 0; i < n; i++)
+        x->grid[i][factor->pivot[i]] = 1.0;
+    __solveInPlace__(factor, x);
+    return x;
+}
+
+/**
+ * @brief Calculates the determinant of a square matrix.
+ * @param matrix The square matrix.
+ * @return The determinant value, or 0.0 if the matrix is not square or a singular matrix.
+ * @note Factorizes the matrix with factorize(); keep the LUFactor instead when it is needed again.
+ */
+double determinant(const Matrix *matrix)
+{
+    LUFactor *factor = factorize(matrix);
+    double det = factorDeterminant(factor);
+    destroyFactor(factor);
+    return det;
+}
+
+/**
+ * @brief Calculates the inverse of a square matrix.
+ * @param matrix The square matrix to invert.
+ * @return A pointer to the inverse matrix, or NULL if the matrix is singular or not square.
+ * @note Factorizes the matrix with factorize(); keep the LUFactor instead when it is needed again.
+ */
+Matrix *inverse(const Matrix *matrix)
+{
+    LUFactor *factor = factorize(matrix);
+    Matrix *result = factorInverse(factor);
+    destroyFactor(factor);
+    return result;
+}
+
+/**
+ * @brief Number of elements of each row that an expression is evaluated on at a time.
+ * @note Every node of the tree gets one chunk-sized scratch buffer, so the working set stays in
+ * the L1/L2 cache. Define this before including the header to override the default.
+ */
+#ifndef EXPR_CHUNK
+#define EXPR_CHUNK 256
+#endif
+
+/**
+ * @brief The operation performed by an expression node.
+ */
+typedef enum
+{
+    EXPR_LEAF,
+    EXPR_CONSTANT,
+    EXPR_ADD,
+    EXPR_MUL,
+    EXPR_FMA,
+    EXPR_SCALE,
+    EXPR_RELU,
+    EXPR_EXP
+} ExprOp;
+
+/**
+ * @struct Expr
+ * @brief A node of a lazily evaluated, elementwise matrix expression.
+ * @var op The operation of the node.
+ * @var matrix The matrix read by an EXPR_LEAF node; it is not owned by the expression.
+ * @var value The value of an EXPR_CONSTANT node, or the factor of an EXPR_SCALE node.
+ * @var operands The child nodes, owned by this node; unused entries are NULL.
+ * @var rows The number of rows of the result, or 0 for a constant, which broadcasts to any shape.
+ * @var columns The number of columns of the result, or 0 for a constant.
+ * @note Every builder takes ownership of its operands, and destroys them if it fails, so a whole
+ * tree can be built in one nested expression and released with a single destroyExpr(). A node
+ * must not be used as an operand twice.
+ */
+typedef struct Expr
+{
+    ExprOp op;
+    const Matrix *matrix;
+    double value;
+    struct Expr *operands[3];
+    int rows;
+    int columns;
+} Expr;
+
+/**
+ * @brief Deallocates an expression tree. The matrices read by its leaves are not touched.
+ * @param expr The root of the tree. Can be NULL.
+ */
+void destroyExpr(Expr *expr)
+{
+    if (expr == NULL)
+        return;
+    for (int i = 0; i < 3; i++)
+        destroyExpr(expr->operands[i]);
+    free(expr);
+}
+
+/**
+ * @brief Allocates an expression node over up to three operands, checking that their shapes agree.
+ * @param op The operation.
+ * @param value The constant or scale factor.
+ * @param a The first operand, or NULL if the node has none.
+ * @param b The second operand, or NULL.
+ * @param c The third operand, or NULL.
+ * @param count The number of operands the operation needs.
+ * @return The new node, or NULL if an operand is missing, the shapes differ, or allocation fails;
+ * on failure every operand is destroyed.
+ * @note This is a private helper function.
+ */
+Expr *__exprNode__(const ExprOp op, const double value, Expr *a, Expr *b, Expr *c, const int count)
+{
+    Expr *operands[3] = {a, b, c};
+    int rows = 0, columns = 0;
+    bool valid = true;
+    for (int i = 0; i < count; i++)
+    {
+        if (operands[i] == NULL)
+            valid = false;
+        else if (operands[i]->rows != 0)
+        {
+            if (rows != 0 && (operands[i]->rows != rows || operands[i]->columns != columns))
+                valid = false;
+            rows = operands[i]->rows;
+            columns = operands[i]->columns;
+        }
+    }
+
+    Expr *node = valid ? (Expr *)malloc(sizeof(Expr)) : NULL;
+    if (node == NULL)
+    {
+        for (int i = 0; i < 3; i++)
+            destroyExpr(operands[i]);
+        return NULL;
+    }
+    node->op = op;
+    node->matrix = NULL;
+    node->value = value;
+    for (int i = 0; i < 3; i++)
+        node->operands[i] = operands[i];
+    node->rows = rows;
+    node->columns = columns;
+    return node;
+}
+
+/**
+ * @brief Creates an expression that reads the elements of a matrix.
+ * @param matrix The matrix. It must stay alive, unchanged in shape, until the expression is evaluated.
+ * @return A new leaf node, or NULL on failure.
+ */
+Expr *exprLeaf(const Matrix *matrix)
+{
+    if (matrix == NULL)
+        return NULL;
+    Expr *node = __exprNode__(EXPR_LEAF, 0.0, NULL, NULL, NULL, 0);
+    if (node == NULL)
+        return NULL;
+    node->matrix = matrix;
+    node->rows = matrix->rows;
+    node->columns = matrix->columns;
+    return node;
+}
+
+/**
+ * @brief Creates an expression whose every element is the same value.
+ * @param value The value, broadcast to the shape of the other operands.
+ * @return A new constant node, or NULL on failure.
+ */
+Expr *exprConstant(const double value)
+{
+    return __exprNode__(EXPR_CONSTANT, value, NULL, NULL, NULL, 0);
+}
+
+/**
+ * @brief Creates the elementwise sum a + b.
+ * @param a The first operand, consumed.
+ * @param b The second operand, consumed.
+ * @return A new node, or NULL if an operand is NULL or the shapes differ.
+ */
+Expr *exprAdd(Expr *a, Expr *b)
+{
+    return __exprNode__(EXPR_ADD, 0.0, a, b, NULL, 2);
+}
+
+/**
+ * @brief Creates the elementwise (Hadamard) product a * b.
+ * @param a The first operand, consumed.
+ * @param b The second operand, consumed.
+ * @return A new node, or NULL if an operand is NULL or the shapes differ.
+ */
+Expr *exprMul(Expr *a, Expr *b)
+{
+    return __exprNode__(EXPR_MUL, 0.0, a, b, NULL, 2);
+}
+
+/**
+ * @brief Creates the elementwise fused multiply-add a * b + c.
+ * @param a The first factor, consumed.
+ * @param b The second factor, consumed.
+ * @param c The addend, consumed.
+ * @return A new node, or NULL if an operand is NULL or the shapes differ.
+ */
+Expr *exprFma(Expr *a, Expr *b, Expr *c)
+{
+    return __exprNode__(EXPR_FMA, 0.0, a, b, c, 3);
+}
+
+/**
+ * @brief Creates the product of an expression and a scalar, factor * a.
+ * @param a The operand, consumed.
+ * @param factor The scale factor.
+ * @return A new node, or NULL if the operand is NULL.
+ */
+Expr *exprScale(Expr *a, const double factor)
+{
+    return __exprNode__(EXPR_SCALE, factor, a, NULL, NULL, 1);
+}
+
+/**
+ * @brief Creates the elementwise rectified linear unit max(a, 0).
+ * @param a The operand, consumed.
+ * @return A new node, or NULL if the operand is NULL.
+ */
+Expr *exprRelu(Expr *a)
+{
+    return __exprNode__(EXPR_RELU, 0.0, a, NULL, NULL, 1);
+}
+
+/**
+ * @brief Creates the elementwise exponential e^a.
+ * @param a The operand, consumed.
+ * @return A new node, or NULL if the operand is NULL.
+ */
+Expr *exprExp(Expr *a)
+{
+    return __exprNode__(EXPR_EXP, 0.0, a, NULL, NULL, 1);
+}
+
+/**
+ * @brief Applies the operation of an expression node to elements [from, count) of its operand chunks.
+ * @param node The node.
+ * @param out The output chunk.
+ * @param a The chunk of the first operand.
+ * @param b The chunk of the second operand, or NULL.
+ * @param c The chunk of the third operand, or NULL.
+ * @param from The first element to compute.
+ * @param count The number of elements in the chunk.
+ * @note This is a private helper function. `out` may alias an operand: every element is read
+ * before the same element is written.
+ */
+void __exprKernelScalar__(const Expr *node, double *out, const double *a, const double *b, const double *c, const int from, const int count)
+{
+    switch (node->op)
+    {
+    case EXPR_ADD:
+        for (int k = from; k < count; k++)
+            out[k] = a[k] + b[k];
+        break;
+    case EXPR_MUL:
+        for (int k = from; k < count; k++)
+            out[k] = a[k] * b[k];
+        break;
+    case EXPR_FMA:
+        for (int k = from; k < count; k++)
+            out[k] = fma(a[k], b[k], c[k]);
+        break;
+    case EXPR_SCALE:
+        for (int k = from; k < count; k++)
+            out[k] = node->value * a[k];
+        break;
+    case EXPR_RELU:
+        for (int k = from; k < count; k++)
+            out[k] = a[k] > 0.0 ? a[k] : 0.0;
+        break;
+    case EXPR_EXP:
+        for (int k = from; k < count; k++)
+            out[k] = exp(a[k]);
+        break;
+    default:
+        break;
+    }
+}
+
+#ifdef MATRIX_SIMD
+/**
+ * @brief AVX2/FMA variant of __exprKernelScalar__ for a whole chunk.
+ * @param node The node.
+ * @param out The output chunk.
+ * @param a The chunk of the first operand.
+ * @param b The chunk of the second operand, or NULL.
+ * @param c The chunk of the third operand, or NULL.
+ * @param count The number of elements in the chunk.
+ * @note This is a private helper function. Only called after __simdLevel__ reports AVX2 and FMA.
+ * EXPR_EXP has no vector form and is left entirely to the scalar kernel.
+ */
+__attribute__((target("avx2,fma"))) void __exprKernelAVX2__(const Expr *node, double *out, const double *a, const double *b, const double *c, const int count)
+{
+    int k = 0;
+    __m256d zero = _mm256_setzero_pd(), factor = _mm256_set1_pd(node->value);
+    switch (node->op)
+    {
+    case EXPR_ADD:
+        for (; k + 4 <= count; k += 4)
+            _mm256_storeu_pd(out + k, _mm256_add_pd(_mm256_loadu_pd(a + k), _mm256_loadu_pd(b + k)));
+        break;
+    case EXPR_MUL:
+        for (; k + 4 <= count; k += 4)
+            _mm256_storeu_pd(out + k, _mm256_mul_pd(_mm256_loadu_pd(a + k), _mm256_loadu_pd(b + k)));
+        break;
+    case EXPR_FMA:
+        for (; k + 4 <= count; k += 4)
+            _mm256_storeu_pd(out + k, _mm256_fmadd_pd(_mm256_loadu_pd(a + k), _mm256_loadu_pd(b + k), _mm256_loadu_pd(c + k)));
+        break;
+    case EXPR_SCALE:
+        for (; k + 4 <= count; k += 4)
+            _mm256_storeu_pd(out + k, _mm256_mul_pd(factor, _mm256_loadu_pd(a + k)));
+        break;
+    case EXPR_RELU:
+        for (; k + 4 <= count; k += 4)
+            _mm256_storeu_pd(out + k, _mm256_max_pd(_mm256_loadu_pd(a + k), zero));
+        break;
+    default:
+        break;
+    }
+    __exprKernelScalar__(node, out, a, b, c, k, count);
+}
+#endif
+
+/**
+ * @brief Evaluates one chunk of an expression tree.
+ * @param node The node to evaluate.
+ * @param row The row of the chunk.
+ * @param column The first column of the chunk.
+ * @param count The number of elements in the chunk.
+ * @param scratch The chunk buffers, one per node of the tree.
+ * @param next The index of the next free buffer in `scratch`.
+ * @param out Where to write the result, or NULL to use a scratch buffer.
+ * @return A pointer to the chunk's values: the leaf matrix itself for leaves, `out` otherwise.
+ * @note This is a private helper function.
+ */
+const double *__exprChunk__(const Expr *node, const int row, const int column, const int count, double *scratch, int *next, double *out)
+{
+    if (node->op == EXPR_LEAF)
+    {
+        const double *source = node->matrix->grid[row] + column;
+        if (out != NULL && out != source)
+            memcpy(out, source, count * sizeof(double));
+        return out != NULL ? out : source;
+    }
+    if (out == NULL)
+        out = scratch + (size_t)(*next)++ * EXPR_CHUNK;
+    if (node->op == EXPR_CONSTANT)
+    {
+        for (int k = 0; k < count; k++)
+            out[k] = node->value;
+        return out;
+    }
+
+    const double *operands[3] = {NULL, NULL, NULL};
+    for (int i = 0; i < 3; i++)
+        if (node->operands[i] != NULL)
+            operands[i] = __exprChunk__(node->operands[i], row, column, count, scratch, next, NULL);
+#ifdef MATRIX_SIMD
+    if (__simdLevel__())
+    {
+        __exprKernelAVX2__(node, out, operands[0], operands[1], operands[2], count);
+        return out;
+    }
+#endif
+    __exprKernelScalar__(node, out, operands[0], operands[1], operands[2], 0, count);
+    return out;
+}
+
+/**
+ * @brief Counts the nodes of an expression tree.
+ * @param expr The root of the tree.
+ * @return The number of nodes.
+ * @note This is a private helper function.
+ */
+int __exprSize__(const Expr *expr)
+{
+    if (expr == NULL)
+        return 0;
+    return 1 + __exprSize__(expr->operands[0]) + __exprSize__(expr->operands[1]) + __exprSize__(expr->operands[2]);
+}
+
+/**
+ * @brief Shared state of a parallel evaluate() call.
+ * @note This is a private helper type.
+ */
+typedef struct
+{
+    const Expr *expr;
+    Matrix *destination;
+    double *scratch;
+    int nodes;
+    int blocks;
+} __ExprJob__;
+
+/**
+ * @brief Evaluates an expression for one block of rows of the destination.
+ * @param context The __ExprJob__.
+ * @param block The index of the row block.
+ * @param worker The index of the worker, which selects its scratch buffers.
+ * @note This is a private helper function.
+ */
+void __exprRows__(void *context, const int block, const int worker)
+{
+    __ExprJob__ *job = (__ExprJob__ *)context;
+    double *scratch = job->scratch + (size_t)worker * job->nodes * EXPR_CHUNK;
+
+    int rows = job->destination->rows, columns = job->destination->columns;
+    int from = (int)((long long)rows * block / job->blocks);
+    int to = (int)((long long)rows * (block + 1) / job->blocks);
+    for (int i = from; i < to; i++)
+        for (int j = 0; j < columns; j += EXPR_CHUNK)
+        {
+            int next = 0;
+            __exprChunk__(job->expr, i, j, columns - j < EXPR_CHUNK ? columns - j : EXPR_CHUNK, scratch, &next,
+                          job->destination->grid[i] + j);
+        }
+}
+
+/**
+ * @brief Evaluates an expression tree into a destination matrix in a single pass, without temporaries.
+ * @param expr The expression. It is not consumed and can be evaluated again.
+ * @param destination The matrix to write; it must have the shape of the expression and may be one of its leaves.
+ * @return true on success, or false if an argument is NULL, the shapes differ, or allocation fails.
+ * @note Rows are processed in chunks of EXPR_CHUNK elements: every node computes its chunk into
+ * a small cache-resident buffer and the root writes straight into the destination, so
+ * `(A * B + C) * 0.5` touches each element of A, B, C and the destination exactly once. Built-in
+ * operations use AVX2/FMA kernels when available. Large destinations are split into row blocks
+ * across the thread pool.
+ * @note Evaluating in place is safe: an element of the destination is only written after every
+ * leaf has read the same element. Leaves must not be other, overlapping views of the destination.
+ */
+bool evaluate(const Expr *expr, Matrix *destination)
+{
+    if (expr == NULL || destination == NULL || (expr->rows != 0 && (expr->rows != destination->rows || expr->columns != destination->columns)))
+        return false;
+
+    __ExprJob__ job = {expr, destination, NULL, __exprSize__(expr), __rowBlocks__(destination->rows, (double)destination->rows * destination->columns)};
+    job.scratch = (double *)malloc((size_t)(job.blocks > 1 ? getThreads() : 1) * job.nodes * EXPR_CHUNK * sizeof(double));
+    if (job.scratch == NULL)
+        return false;
+    __poolRun__(job.blocks, __exprRows__, &job);
+    free(job.scratch);
+    return true;
+}
+
+/**
+ * @struct SparseMatrix
+ * @brief A sparse matrix in compressed sparse row (CSR) or compressed sparse column (CSC) form.
+ * @var values The nonzero values, grouped by row (CSR) or by column (CSC).
+ * @var indices The column (CSR) or row (CSC) index of each value, ascending within a group.
+ * @var offsets The group boundaries: group g occupies positions [offsets[g], offsets[g + 1]).
+ * @var rows The number of rows in the matrix.
+ * @var columns The number of columns in the matrix.
+ * @var nonzeros The number of stored values.
+ * @var axis The compressed axis: false for CSR (groups are rows), true for CSC (groups are columns).
+ * @note Memory and the cost of every operation grow with `nonzeros`, not with rows * columns.
+ */
+typedef struct
+{
+    double *values;
+    int *indices;
+    int *offsets;
+    int rows;
+    int columns;
+    int nonzeros;
+    bool axis;
+} SparseMatrix;
+
+/**
+ * @brief Deallocates a sparse matrix.
+ * @param sparse The sparse matrix to destroy. Can be NULL.
+ */
+void destroySparse(SparseMatrix *sparse)
+{
+    if (sparse == NULL)
+        return;
+    free(sparse->values);
+    free(sparse->indices);
+    free(sparse->offsets);
+    free(sparse);
+}
+
+/**
+ * @brief Allocates an empty sparse matrix with room for a given number of nonzeros.
+ * @param rows The number of rows.
+ * @param columns The number of columns.
+ * @param nonzeros The number of values to allocate.
+ * @param axis false for CSR, true for CSC.
+ * @return A pointer to the new sparse matrix with zeroed offsets, or NULL on failure.
+ * @note This is a private helper function.
+ */
+SparseMatrix *__sparseInit__(const int rows, const int columns, const int nonzeros, const bool axis)
+{
+    if (rows <= 0 || columns <= 0 || nonzeros < 0)
+        return NULL;
+
+    SparseMatrix *sparse = (SparseMatrix *)malloc(sizeof(SparseMatrix));
+    if (sparse == NULL)
+        return NULL;
+    int groups = axis ? columns : rows;
+    sparse->values = (double *)malloc((nonzeros > 0 ? nonzeros : 1) * sizeof(double));
+    sparse->indices = (int *)malloc((nonzeros > 0 ? nonzeros : 1) * sizeof(int));
+    sparse->offsets = (int *)calloc(groups + 1, sizeof(int));
+    sparse->rows = rows;
+    sparse->columns = columns;
+    sparse->nonzeros = nonzeros;
+    sparse->axis = axis;
+    if (sparse->values == NULL || sparse->indices == NULL || sparse->offsets == NULL)
+    {
+        destroySparse(sparse);
+        return NULL;
+    }
+    return sparse;
+}
+
+/**
+ * @brief Creates a sparse matrix holding the nonzero elements of a dense matrix.
+ * @param matrix The dense matrix.
+ * @param axis false for CSR (row-compressed), true for CSC (column-compressed).
+ * @return A pointer to the new sparse matrix, or NULL on failure.
+ */
+SparseMatrix *fromDense(const Matrix *matrix, const bool axis)
+{
+    if (matrix == NULL)
+        return NULL;
+
+    int nonzeros = 0;
+    for (int i = 0; i < matrix->rows; i++)
+        for (int j = 0; j < matrix->columns; j++)
+            nonzeros += matrix->grid[i][j] != 0.0;
+
+    SparseMatrix *sparse = __sparseInit__(matrix->rows, matrix->columns, nonzeros, axis);
+    if (sparse == NULL)
+        return NULL;
+
+    int groups = axis ? matrix->columns : matrix->rows, length = axis ? matrix->rows : matrix->columns;
+    int position = 0;
+    for (int g = 0; g < groups; g++)
+    {
+        for (int k = 0; k < length; k++)
+        {
+            double value = axis ? matrix->grid[k][g] : matrix->grid[g][k];
+            if (value != 0.0)
+            {
+                sparse->values[position] = value;
+                sparse->indices[position++] = k;
+            }
+        }
+        sparse->offsets[g + 1] = position;
+    }
+    return sparse;
+}
+
+/**
+ * @brief Creates a sparse matrix from coordinate (COO) triplets, without a dense intermediate.
+ * @param rows The number of rows.
+ * @param columns The number of columns.
+ * @param nonzeros The number of triplets.
+ * @param rowIndices The row index of each triplet.
+ * @param columnIndices The column index of each triplet.
+ * @param values The value of each triplet.
+ * @param axis false for CSR (row-compressed), true for CSC (column-compressed).
+ * @return A pointer to the new sparse matrix, or NULL on failure or if any index is out of range.
+ * @note The triplets may come in any order. Duplicate coordinates are summed, and entries that are
+ * (or sum to) zero are not stored. Two stable counting sorts: O(nonzeros + rows + columns) time and
+ * memory.
+ */
+SparseMatrix *sparseFromTriplets(const int rows, const int columns, const int nonzeros, const int *rowIndices, const int *columnIndices, const double *values, const bool axis)
+{
+    if (rows <= 0 || columns <= 0 || nonzeros < 0)
+        return NULL;
+    if (nonzeros > 0 && (rowIndices == NULL || columnIndices == NULL || values == NULL))
+        return NULL;
+    for (int p = 0; p < nonzeros; p++)
+        if (rowIndices[p] < 0 || rowIndices[p] >= rows || columnIndices[p] < 0 || columnIndices[p] >= columns)
+            return NULL;
+
+    SparseMatrix *sparse = __sparseInit__(rows, columns, nonzeros, axis);
+    if (sparse == NULL)
+        return NULL;
+
+    const int *major = axis ? columnIndices : rowIndices, *minor = axis ? rowIndices : columnIndices;
+    int groups = axis ? columns : rows, length = axis ? rows : columns;
+    int *order = (int *)malloc((nonzeros > 0 ? nonzeros : 1) * sizeof(int));
+    int *next = (int *)calloc((length > groups ? length : groups) + 1, sizeof(int));
+    if (order == NULL || next == NULL)
+    {
+        free(order);
+        free(next);
+        destroySparse(sparse);
+        return NULL;
+    }
+
+    // Order the triplets by minor index first, so that scattering them by group in that order
+    // leaves the indices ascending within each group.
+    for (int p = 0; p < nonzeros; p++)
+        next[minor[p] + 1]++;
+    for (int k = 0; k < length; k++)
+        next[k + 1] += next[k];
+    for (int p = 0; p < nonzeros; p++)
+        order[next[minor[p]]++] = p;
+
+    for (int p = 0; p < nonzeros; p++)
+        sparse->offsets[major[p] + 1]++;
+    for (int g = 0; g < groups; g++)
+        sparse->offsets[g + 1] += sparse->offsets[g];
+    memcpy(next, sparse->offsets, groups * sizeof(int));
+    for (int q = 0; q < nonzeros; q++)
+    {
+        int p = order[q], position = next[major[p]]++;
+        sparse->values[position] = values[p];
+        sparse->indices[position] = minor[p];
+    }
+    free(order);
+    free(next);
+
+    // Duplicates are now adjacent: sum each run and compact the survivors to the front.
+    int position = 0, start = 0;
+    for (int g = 0; g < groups; g++)
+    {
+        int end = sparse->offsets[g + 1];
+        for (int p = start; p < end; p++)
+        {
+            int index = sparse->indices[p];
+            double value = sparse->values[p];
+            while (p + 1 < end && sparse->indices[p + 1] == index)
+                value += sparse->values[++p];
+            if (value != 0.0)
+            {
+                sparse->values[position] = value;
+                sparse->indices[position++] = index;
+            }
+        }
+        sparse->offsets[g + 1] = position;
+        start = end;
+    }
+    sparse->nonzeros = position;
+    return sparse;
+}
+
+/**
+ * @brief Expands a sparse matrix into a dense matrix.
+ * @param sparse The sparse matrix.
+ * @return A pointer to the new dense matrix, or NULL on failure.
+ */
+Matrix *toDense(const SparseMatrix *sparse)
+{
+    if (sparse == NULL)
+        return NULL;
+
+    Matrix *matrix = init(sparse->rows, sparse->columns);
+    if (matrix == NULL)
+        return NULL;
+
+    int groups = sparse->axis ? sparse->columns : sparse->rows;
+    for (int g = 0; g < groups; g++)
+        for (int p = sparse->offsets[g]; p < sparse->offsets[g + 1]; p++)
+            if (sparse->axis)
+                matrix->grid[sparse->indices[p]][g] = sparse->values[p];
+            else
+                matrix->grid[g][sparse->indices[p]] = sparse->values[p];
+    return matrix;
+}
+
+/**
+ * @brief Retrieves an element of a sparse matrix.
+ * @param sparse The sparse matrix.
+ * @param row The row index.
+ * @param column The column index.
+ * @return The element, 0.0 if it is not stored, or -1 if the input is invalid.
+ * @note Binary search within the row (CSR) or column (CSC): O(log nonzeros per group).
+ */
+double sparseGet(const SparseMatrix *sparse, const int row, const int column)
+{
+    if (sparse == NULL || row < 0 || row >= sparse->rows || column < 0 || column >= sparse->columns)
+        return -1;
+
+    int group = sparse->axis ? column : row, index = sparse->axis ? row : column;
+    int low = sparse->offsets[group], high = sparse->offsets[group + 1];
+    while (low < high)
+    {
+        int middle = low + (high - low) / 2;
+        if (sparse->indices[middle] < index)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low < sparse->offsets[group + 1] && sparse->indices[low] == index ? sparse->values[low] : 0.0;
+}
+
+/**
+ * @brief Creates a copy of a sparse matrix stored in the other compressed form (CSR to CSC or CSC to CSR).
+ * @param sparse The sparse matrix to convert.
+ * @return A pointer to the new sparse matrix, or NULL on failure.
+ * @note A counting sort over the indices: O(nonzeros + rows + columns).
+ */
+SparseMatrix *convertSparse(const SparseMatrix *sparse)
+{
+    if (sparse == NULL)
+        return NULL;
+
+    SparseMatrix *result = __sparseInit__(sparse->rows, sparse->columns, sparse->nonzeros, !sparse->axis);
+    if (result == NULL)
+        return NULL;
+
+    int groups = sparse->axis ? sparse->columns : sparse->rows;
+    int targets = result->axis ? result->columns : result->rows;
+    for (int p = 0; p < sparse->nonzeros; p++)
+        result->offsets[sparse->indices[p] + 1]++;
+    for (int t = 0; t < targets; t++)
+        result->offsets[t + 1] += result->offsets[t];
+
+    int *next = (int *)malloc(targets * sizeof(int));
+    if (next == NULL)
+    {
+        destroySparse(result);
+        return NULL;
+    }
+    memcpy(next, result->offsets, targets * sizeof(int));
+    // Visiting groups in order keeps the new indices ascending within each new group.
+    for (int g = 0; g < groups; g++)
+        for (int p = sparse->offsets[g]; p < sparse->offsets[g + 1]; p++)
+        {
+            int position = next[sparse->indices[p]]++;
+            result->values[position] = sparse->values[p];
+            result->indices[position] = g;
+        }
+    free(next);
+    return result;
+}
+
+/**
+ * @brief Creates the transpose of a sparse matrix.
+ * @param sparse The sparse matrix to transpose.
+ * @return A pointer to the new sparse matrix, or NULL on failure.
+ * @note The CSR arrays of a matrix are the CSC arrays of its transpose, so this is an O(nonzeros)
+ * copy that flips the compressed axis; use convertSparse() on the result to get the original form.
+ */
+SparseMatrix *sparseTranspose(const SparseMatrix *sparse)
+{
+    if (sparse == NULL)
+        return NULL;
+
+    SparseMatrix *result = __sparseInit__(sparse->columns, sparse->rows, sparse->nonzeros, !sparse->axis);
+    if (result == NULL)
+        return NULL;
+
+    int groups = sparse->axis ? sparse->columns : sparse->rows;
+    memcpy(result->values, sparse->values, sparse->nonzeros * sizeof(double));
+    memcpy(result->indices, sparse->indices, sparse->nonzeros * sizeof(int));
+    memcpy(result->offsets, sparse->offsets, (groups + 1) * sizeof(int));
+    return result;
+}
+
+/**
+ * @brief Shared state of a parallel spmv() or spmm() call on a CSR matrix.
+ * @note This is a private helper type.
+ */
+typedef struct
+{
+    const SparseMatrix *sparse;
+    const double *vector;
+    const Matrix *dense;
+    double *output;
+    Matrix *result;
+    int blocks;
+} __SparseJob__;
+
+/**
+ * @brief Finds the first row of a block when the rows of a CSR matrix are split into blocks of equal nonzeros.
+ * @param sparse The CSR matrix.
+ * @param block The index of the block; `blocks` gives the end of the last block.
+ * @param blocks The number of blocks.
+ * @return The first row of the block.
+ * @note This is a private helper function. Balancing by nonzeros rather than by rows keeps
+ * skewed matrices, such as power-law graphs, from leaving most threads idle.
+ */
+int __sparseSplit__(const SparseMatrix *sparse, const int block, const int blocks)
+{
+    long long target = (long long)sparse->nonzeros * block / blocks;
+    int low = 0, high = sparse->rows;
+    while (low < high)
+    {
+        int middle = low + (high - low) / 2;
+        if (sparse->offsets[middle] < target)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return block == blocks ? sparse->rows : low;
+}
+
+/**
+ * @brief Computes one block of rows of a CSR sparse matrix-vector or sparse-dense product.
+ * @param context The __SparseJob__.
+ * @param block The index of the row block.
+ * @param worker Unused.
+ * @note This is a private helper function.
+ */
+void __sparseRows__(void *context, const int block, const int worker)
+{
+    (void)worker;
+    __SparseJob__ *job = (__SparseJob__ *)context;
+    const SparseMatrix *a = job->sparse;
+    int from = __sparseSplit__(a, block, job->blocks), to = __sparseSplit__(a, block + 1, job->blocks);
+    for (int i = from; i < to; i++)
+    {
+        if (job->vector != NULL)
+        {
+            double sum = 0.0;
+            for (int p = a->offsets[i]; p < a->offsets[i + 1]; p++)
+                sum += a->values[p] * job->vector[a->indices[p]];
+            job->output[i] = sum;
+            continue;
+        }
+        double *target = job->result->grid[i];
+        for (int p = a->offsets[i]; p < a->offsets[i + 1]; p++)
+        {
+            const double *source = job->dense->grid[a->indices[p]];
+            double value = a->values[p];
+            for (int j = 0; j < job->result->columns; j++)
+                target[j] += value * source[j];
+        }
+    }
+}
+
+/**
+ * @brief Multiplies a sparse matrix by a dense vector (SpMV).
+ * @param sparse The sparse matrix, m x n.
+ * @param vector The dense vector, an array of n values.
+ * @return A pointer to the new result array of m values, or NULL on failure. The caller is responsible for freeing this memory.
+ * @note CSR matrices compute each row as an independent dot product, split into blocks of equal
+ * nonzeros across the thread pool once there are at least MATRIX_PARALLEL_CUTOFF nonzeros
+ * (setThreads(1) keeps it serial). CSC matrices scatter column by column on the calling thread.
+ */
+double *spmv(const SparseMatrix *sparse, const double *vector)
+{
+    if (sparse == NULL || vector == NULL)
+        return NULL;
+
+    double *output = (double *)calloc(sparse->rows, sizeof(double));
+    if (output == NULL)
+        return NULL;
+
+    if (sparse->axis)
+    {
+        for (int j = 0; j < sparse->columns; j++)
+            for (int p = sparse->offsets[j]; p < sparse->offsets[j + 1]; p++)
+                output[sparse->indices[p]] += sparse->values[p] * vector[j];
+        return output;
+    }
+
+    __SparseJob__ job = {sparse, vector, NULL, output, NULL, __rowBlocks__(sparse->rows, sparse->nonzeros)};
+    __poolRun__(job.blocks, __sparseRows__, &job);
+    return output;
+}
+
+/**
+ * @brief Multiplies a sparse matrix by a dense matrix (SpMM).
+ * @param sparse The sparse matrix, m x k.
+ * @param dense The dense matrix, k x n.
+ * @return A pointer to the new dense m x n result, or NULL if the dimensions do not match or allocation fails.
+ * @note Each nonzero a(i, p) adds a(i, p) times row p of `dense` to row i of the result, so all
+ * inner loops are contiguous. CSR matrices are split into row blocks of equal nonzeros across
+ * the thread pool for large products; CSC matrices run on the calling thread.
+ */
+Matrix *spmm(const SparseMatrix *sparse, const Matrix *dense)
+{
+    if (sparse == NULL || dense == NULL || sparse->columns != dense->rows)
+        return NULL;
+
+    Matrix *result = init(sparse->rows, dense->columns);
+    if (result == NULL)
+        return NULL;
+
+    if (sparse->axis)
+    {
+        for (int k = 0; k < sparse->columns; k++)
+            for (int p = sparse->offsets[k]; p < sparse->offsets[k + 1]; p++)
+            {
+                double *target = result->grid[sparse->indices[p]];
+                const double *source = dense->grid[k];
+                double value = sparse->values[p];
+                for (int j = 0; j < result->columns; j++)
+                    target[j] += value * source[j];
+            }
+        return result;
+    }
+
+    __SparseJob__ job = {sparse, NULL, dense, NULL, result, __rowBlocks__(sparse->rows, (double)sparse->nonzeros * dense->columns)};
+    __poolRun__(job.blocks, __sparseRows__, &job);
+    return result;
+}
+
+/**
+ * @brief Identifies a file written by save ("MAT1" in little-endian byte order).
+ */
+#define MATRIX_FILE_MAGIC 0x3154414Du
+
+/**
+ * @brief Version of the binary matrix format written by save.
+ */
+#define MATRIX_FILE_VERSION 1
+
+/**
+ * @brief Element type code of a binary matrix file whose elements are IEEE-754 doubles.
+ */
+#define MATRIX_FILE_FLOAT64 1
+
+/**
+ * @brief Written in native byte order, so a reader can tell whether a file came from a machine
+ * with the same endianness.
+ */
+#define MATRIX_FILE_ENDIANNESS 0x01020304u
+
+/**
+ * @brief Size in bytes of the header that precedes the elements in a binary matrix file.
+ * @note A full cache line, so the elements start 64-byte aligned within a mapping of the file.
+ */
+#define MATRIX_FILE_HEADER 64
+
+/**
+ * @brief On-disk header of a binary matrix file.
+ * @note This is a private helper type. It occupies the first MATRIX_FILE_HEADER bytes; the rest
+ * of them are zero. With `tile == 0` (files written by save) the rows * columns elements follow
+ * in row-major order with no padding; otherwise the file belongs to a DiskMatrix and holds
+ * tile x tile blocks, see DiskMatrix.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    int32_t rows;
+    int32_t columns;
+    uint32_t dtype;
+    uint32_t endianness;
+    int32_t tile;
+} __MatrixFileHeader__;
+
+/**
+ * @brief Writes a buffer to a file descriptor, retrying after short writes.
+ * @param descriptor The file descriptor.
+ * @param buffer The bytes to write.
+ * @param size The number of bytes to write.
+ * @return true if every byte was written, false otherwise.
+ * @note This is a private helper function.
+ */
+bool __writeAll__(const int descriptor, const void *buffer, size_t size)
+{
+    const char *bytes = (const char *)buffer;
+    while (size > 0)
+    {
+        ssize_t written = write(descriptor, bytes, size);
+        if (written <= 0)
+            return false;
+        bytes += written;
+        size -= (size_t)written;
+    }
+    return true;
+}
+
+/**
+ * @brief Saves a matrix to a file in the binary matrix format.
+ * @param matrix The matrix to save.
+ * @param path The path of the file. An existing file is overwritten.
+ * @return true on success, false if the input is invalid or the file cannot be written.
+ * @note The file is a 64-byte header (magic, version, dimensions, element type and an endianness
+ * marker) followed by the raw elements, so mmapLoad can map it without parsing or copying.
+ */
+bool save(const Matrix *matrix, const char *path)
+{
+    if (matrix == NULL || path == NULL)
+        return false;
+
+    int descriptor = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (descriptor < 0)
+        return false;
+
+    char header[MATRIX_FILE_HEADER] = {0};
+    __MatrixFileHeader__ fields = {MATRIX_FILE_MAGIC, MATRIX_FILE_VERSION, matrix->rows, matrix->columns, MATRIX_FILE_FLOAT64, MATRIX_FILE_ENDIANNESS, 0};
+    memcpy(header, &fields, sizeof(fields));
+    bool written = __writeAll__(descriptor, header, sizeof(header));
+    if (matrix->stride == matrix->columns)
+        written = written && __writeAll__(descriptor, matrix->data, (size_t)matrix->rows * matrix->columns * sizeof(double));
+    else
+        for (int i = 0; written && i < matrix->rows; i++)
+            written = __writeAll__(descriptor, matrix->grid[i], (size_t)matrix->columns * sizeof(double));
+
+    return close(descriptor) == 0 && written;
+}
+
+/**
+ * @brief Loads a binary matrix file by mapping it into memory, without reading or copying its elements.
+ * @param path The path of a file written by save.
+ * @return A pointer to a read-only Matrix whose elements live in the mapping, or NULL if the file
+ * cannot be opened or mapped, is not a binary matrix file written by save (DiskMatrix files are
+ * tiled), or was written on a machine with a different byte order.
+ * @note Loading takes the same few system calls whatever the size of the matrix: pages are read
+ * from disk, or shared from the page cache, only when they are first touched.
+ * @note The mapping is read-only, so writing to the matrix (set, setField, swapField, evaluate into
+ * it, ...) crashes the program. Every function that returns a new matrix works as usual; use copy
+ * to get a writable matrix. destroy unmaps the file.
+ */
+Matrix *mmapLoad(const char *path)
+{
+    if (path == NULL)
+        return NULL;
+
+    int descriptor = open(path, O_RDONLY);
+    if (descriptor < 0)
+        return NULL;
+
+    __MatrixFileHeader__ header;
+    struct stat info;
+    if (fstat(descriptor, &info) != 0 || info.st_size < MATRIX_FILE_HEADER ||
+        read(descriptor, &header, sizeof(header)) != sizeof(header) ||
+        header.magic != MATRIX_FILE_MAGIC || header.version != MATRIX_FILE_VERSION ||
+        header.dtype != MATRIX_FILE_FLOAT64 || header.endianness != MATRIX_FILE_ENDIANNESS ||
+        header.rows <= 0 || header.columns <= 0 || header.tile != 0)
+    {
+        close(descriptor);
+        return NULL;
+    }
+
+    size_t size = MATRIX_FILE_HEADER + (size_t)header.rows * (size_t)header.columns * sizeof(double);
+    if ((size_t)info.st_size < size)
+    {
+        close(descriptor);
+        return NULL;
+    }
+    void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (mapping == MAP_FAILED)
+        return NULL;
+
+    Matrix *matrix = (Matrix *)calloc(1, sizeof(Matrix) + (size_t)header.rows * sizeof(double *));
+    if (matrix == NULL)
+    {
+        munmap(mapping, size);
+        return NULL;
+    }
+    matrix->grid = (double **)(matrix + 1);
+    matrix->data = (double *)((char *)mapping + MATRIX_FILE_HEADER);
+    matrix->rows = header.rows;
+    matrix->columns = header.columns;
+    matrix->stride = header.columns;
+    matrix->capacity = header.rows;
+    matrix->mapping = mapping;
+    matrix->mappedSize = size;
+    for (int i = 0; i < matrix->rows; i++)
+        matrix->grid[i] = matrix->data + (size_t)i * matrix->columns;
+    return matrix;
+}
+
+/**
+ * @struct MatrixBatch
+ * @brief A batch of same-shaped small matrices stored back to back in one contiguous buffer.
+ * @var data The elements: matrix k occupies `data[k * rows * columns]` onward, in row-major order.
+ * @var count The number of matrices in the batch.
+ * @var rows The number of rows of every matrix.
+ * @var columns The number of columns of every matrix.
+ * @note Batched operations make one allocation and one pass over the whole batch, instead of
+ * the several allocations and checks that dot(), inverse() and friends pay per matrix.
+ */
+typedef struct
+{
+    double *data;
+    int count;
+    int rows;
+    int columns;
+} MatrixBatch;
+
+/**
+ * @brief Initializes and allocates a zero-filled batch of matrices.
+ * @param count The number of matrices. Must be greater than 0.
+ * @param rows The number of rows of every matrix. Must be greater than 0.
+ * @param columns The number of columns of every matrix. Must be greater than 0.
+ * @return A pointer to the new batch, or NULL if allocation fails or the dimensions are invalid.
+ * @note The struct and the elements share a single allocation, and the elements start on a
+ * MATRIX_ALIGNMENT boundary.
+ */
+MatrixBatch *batchInit(const int count, const int rows, const int columns)
+{
+    if (count <= 0 || rows <= 0 || columns <= 0)
+        return NULL;
+
+    size_t elements = (size_t)count * rows * columns * sizeof(double);
+    char *block = (char *)calloc(1, sizeof(MatrixBatch) + MATRIX_ALIGNMENT - 1 + elements);
+    if (block == NULL)
+        return NULL;
+
+    MatrixBatch *batch = (MatrixBatch *)block;
+    batch->data = (double *)(((uintptr_t)(block + sizeof(MatrixBatch)) + MATRIX_ALIGNMENT - 1) & ~(uintptr_t)(MATRIX_ALIGNMENT - 1));
+    batch->count = count;
+    batch->rows = rows;
+    batch->columns = columns;
+    return batch;
+}
+
+/**
+ * @brief Frees the memory allocated for a batch.
+ * @param batch The batch to be destroyed. If NULL, the function does nothing.
+ */
+void destroyBatch(MatrixBatch *batch)
+{
+    if (batch == NULL)
+        return;
+    free(batch);
+}
+
+/**
+ * @brief Creates a view of one matrix of a batch.
+ * @param batch The batch.
+ * @param index The index of the matrix.
+ * @return A view of the matrix, or an empty view (data == NULL) if the index is out of bounds.
+ * @note Use viewGet, viewSet, materialize or gemm on the view to read, fill or combine single matrices.
+ */
+MatrixView batchView(const MatrixBatch *batch, const int index)
+{
+    MatrixView result = {NULL, 0, 0, 0, 0};
+    if (batch == NULL || index < 0 || index >= batch->count)
+        return result;
+
+    result.data = batch->data + (size_t)index * batch->rows * batch->columns;
+    result.rows = batch->rows;
+    result.columns = batch->columns;
+    result.rowStride = batch->columns;
+    result.columnStride = 1;
+    return result;
+}
+
+/**
+ * @brief A kernel that applies one batched operation to a single matrix (or pair of matrices).
+ * @note This is a private helper type. `rows`, `inner` and `columns` are the dimensions of the
+ * operation (rows x inner times inner x columns for a product); fixed-size kernels ignore them.
+ * `scratch` holds at least rows * columns doubles.
+ */
+typedef void (*__BatchKernel__)(const double *a, const double *b, double *output, double *scratch, const int rows, const int inner, const int columns);
+
+/**
+ * @brief Multiplies one pair of matrices of any shape.
+ * @note This is a private helper function. A __BatchKernel__.
+ */
+void __batchDot__(const double *a, const double *b, double *output, double *scratch, const int rows, const int inner, const int columns)
+{
+    (void)scratch;
+    for (int i = 0; i < rows; i++)
+    {
+        double *target = output + i * columns;
+        for (int j = 0; j < columns; j++)
+            target[j] = 0.0;
+        for (int k = 0; k < inner; k++)
+        {
+            double factor = a[i * inner + k];
+            for (int j = 0; j < columns; j++)
+                target[j] += factor * b[k * columns + j];
+        }
+    }
+}
+
+/**
+ * @brief Transposes one matrix of any shape.
+ * @note This is a private helper function. A __BatchKernel__.
+ */
+void __batchTranspose__(const double *a, const double *b, double *output, double *scratch, const int rows, const int inner, const int columns)
+{
+    (void)b, (void)scratch, (void)inner;
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < columns; j++)
+            output[j * rows + i] = a[i * columns + j];
+}
+
+/**
+ * @brief Defines the product and transpose kernels for N x N matrices.
+ * @param N The size of the matrices, a literal constant.
+ * @note This is a private helper macro. With every trip count a compile-time constant, the
+ * compiler fully unrolls and vectorizes the loops.
+ */
+#define __DEFINE_BATCH_KERNELS__(N)                                                                                                                   \
+    void __batchDot##N##__(const double *a, const double *b, double *output, double *scratch, const int rows, const int inner, const int columns)     \
+    {                                                                                                                                                 \
+        (void)scratch, (void)rows, (void)inner, (void)columns;                                                                                        \
+        for (int i = 0; i < N; i++)                                                                                                                   \
+        {                                                                                                                                             \
+            double row[N] = {0};                                                                                                                      \
+            for (int k = 0; k < N; k++)                                                                                                               \
+                for (int j = 0; j < N; j++)                                                                                                           \
+                    row[j] += a[i * N + k] * b[k * N + j];                                                                                            \
+            for (int j = 0; j < N; j++)                                                                                                               \
+                output[i * N + j] = row[j];                                                                                                           \
+        }                                                                                                                                             \
+    }                                                                                                                                                 \
+    void __batchTranspose##N##__(const double *a, const double *b, double *output, double *scratch, const int rows, const int inner, const int columns) \
+    {                                                                                                                                                 \
+        (void)b, (void)scratch, (void)rows, (void)inner, (void)columns;                                                                               \
+        for (int i = 0; i < N; i++)                                                                                                                   \
+            for (int j = 0; j < N; j++)                                                                                                               \
+                output[j * N + i] = a[i * N + j];                                                                                                     \
+    }
+
+__DEFINE_BATCH_KERNELS__(2)
+__DEFINE_BATCH_KERNELS__(3)
+__DEFINE_BATCH_KERNELS__(4)
+__DEFINE_BATCH_KERNELS__(8)
+
+/**
+ * @brief Reduces a square matrix with partial pivoting and returns its determinant.
+ * @param work The matrix, n x n. Overwritten.
+ * @param inverse NULL to only compute the determinant, or an n x n array that receives the inverse.
+ * @param n The size of the matrix.
+ * @return The determinant, or 0.0 if a pivot smaller than 1e-12 is met, as in factorize() (the
+ * inverse is then incomplete).
+ * @note This is a private helper function. Without `inverse` it is Gaussian elimination; with it,
+ * Gauss-Jordan elimination applied to the identity.
+ */
+double __batchEliminate__(double *work, double *inverse, const int n)
+{
+    if (inverse != NULL)
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                inverse[i * n + j] = i == j ? 1.0 : 0.0;
+
+    double det = 1.0;
+    for (int p = 0; p < n; p++)
+    {
+        int pivot = p;
+        for (int i = p + 1; i < n; i++)
+            if (fabs(work[i * n + p]) > fabs(work[pivot * n + p]))
+                pivot = i;
+        if (fabs(work[pivot * n + p]) < 1e-12)
+            return 0.0;
+        if (pivot != p)
+        {
+            det = -det;
+            for (int j = 0; j < n; j++)
+            {
+                __swap__(&work[p * n + j], &work[pivot * n + j]);
+                if (inverse != NULL)
+                    __swap__(&inverse[p * n + j], &inverse[pivot * n + j]);
+            }
+        }
+        double value = work[p * n + p];
+        det *= value;
+        if (inverse != NULL)
+            for (int j = 0; j < n; j++)
+            {
+                work[p * n + j] /= value;
+                inverse[p * n + j] /= value;
+            }
+        for (int i = inverse != NULL ? 0 : p + 1; i < n; i++)
+        {
+            double factor = work[i * n + p] / work[p * n + p];
+            if (i == p || factor == 0.0)
+                continue;
+            for (int j = p; j < n; j++)
+                work[i * n + j] -= factor * work[p * n + j];
+            if (inverse != NULL)
+                for (int j = 0; j < n; j++)
+                    inverse[i * n + j] -= factor * inverse[p * n + j];
+        }
+    }
+    return det;
+}
+
+/**
+ * @brief Whether factorize() would meet a pivot smaller than 1e-12 in a small square matrix.
+ * @param a The matrix, n x n with n at most 4.
+ * @param n The size of the matrix.
+ * @param det The determinant of the matrix, computed in closed form.
+ * @return true if inverse() and determinant() treat the matrix as singular.
+ * @note This is a private helper function behind the closed-form kernels. With partial pivoting
+ * no pivot exceeds 2^(n-1) times the largest element, so when |det| is large against the product
+ * of n - 1 such bounds every pivot is at least 1e-12, and the elimination is skipped.
+ */
+bool __batchSingular__(const double *a, const int n, const double det)
+{
+    double largest = 0.0, bound = 1.0;
+    for (int i = 0; i < n * n; i++)
+        largest = fabs(a[i]) > largest ? fabs(a[i]) : largest;
+    for (int k = 1; k < n; k++)
+        bound *= (double)(1 << (n - 1)) * largest;
+    if (fabs(det) > 1e-12 * bound)
+        return false;
+
+    double work[16];
+    memcpy(work, a, (size_t)n * n * sizeof(double));
+    return __batchEliminate__(work, NULL, n) == 0.0;
+}
+
+/**
+ * @brief Computes the determinant of one square matrix of any size.
+ * @note This is a private helper function. A __BatchKernel__ that writes one value.
+ */
+void __batchDeterminant__(const double *a, const double *b, double *output, double *scratch, const int rows, const int inner, const int columns)
+{
+    (void)b, (void)inner;
+    memcpy(scratch, a, (size_t)rows * columns * sizeof(double));
+    *output = __batchEliminate__(scratch, NULL, rows);
+}
+
+/**
+ * @brief Inverts one square matrix of any size.
+ * @note This is a private helper function. A __BatchKernel__. A singular matrix yields NaNs.
+ */
+void __batchInverse__(const double *a, const double *b, double *output, double *scratch, const int rows, const int inner, const int columns)
+{
+    (void)b, (void)inner;
+    memcpy(scratch, a, (size_t)rows * columns * sizeof(double));
+    if (__batchEliminate__(scratch, output, rows) == 0.0)
+        for (int i = 0; i < rows * columns; i++)
+            output[i] = NAN;
+}
+
+/**
+ * @brief Computes the determinant of one 2 x 2 matrix in closed form.
+ * @note This is a private helper function. A __BatchKernel__ that writes one value.
+ */
+void __batchDeterminant2__(const double *a, const double *b, double *output, double *scratch, const int rows, const int inner, const int columns)
+{
+    (void)b, (void)scratch, (void)rows, (void)inner, (void)columns;
+    double det = a[0] * a[3] - a[1] * a[2];
+    *output = __batchSingular__(a, 2, det) ? 0.0 : det;
+}
+
+/**
+ * @brief Computes the determinant of one 3 x 3 matrix in closed form.
+ * @note This is a private helper function. A __BatchKernel__ that writes one value.
+ */
+void __batchDeterminant3__(const double *a, const double *b, double *output, double *scratch, const int rows, const int inner, const int columns)
+{
+    (void)b, (void)scratch, (void)rows, (void)inner, (void)columns;
+    double det = a[0] * (a[4] * a[8] - a[5] * a[7]) - a[1] * (a[3] * a[8] - a[5] * a[6]) + a[2] * (a[3] * a[7] - a[4] * a[6]);
+    *output = __batchSingular__(a, 3, det) ? 0.0 : det;
+}
+
+/**
+ * @brief Computes the determinant of one 4 x 4 matrix in closed form.
+ * @note This is a private helper function. A __BatchKernel__ that writes one value. Expands
+ * along the top two rows, using the six 2 x 2 minors of each half.
+ */
+void __batchDeterminant4__(const double *a, const double *b, double *output, double *scratch, const int rows, const int inner, const int columns)
+{
+    (void)b, (void)scratch, (void)rows, (void)inner, (void)columns;
+    double s0 = a[0] * a[5] - a[4] * a[1], s1 = a[0] * a[6] - a[4] * a[2], s2 = a[0] * a[7] - a[4] * a[3];
+    double s3 = a[1] * a[6] - a[5] * a[2], s4 = a[1] * a[7] - a[5] * a[3], s5 = a[2] * a[7] - a[6] * a[3];
+    double c5 = a[10] * a[15] - a[14] * a[11], c4 = a[9] * a[15] - a[13] * a[11], c3 = a[9] * a[14] - a[13] * a[10];
+    double c2 = a[8] * a[15] - a[12] * a[11], c1 = a[8] * a[14] - a[12] * a[10], c0 = a[8] * a[13] - a[12] * a[9];
+    double det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    *output = __batchSingular__(a, 4, det) ? 0.0 : det;
+}
+
+/**
+ * @brief Inverts one 2 x 2 matrix in closed form.
+ * @note This is a private helper function. A __BatchKernel__. A singular matrix yields NaNs.
+ */
+void __batchInverse2__(const double *a, const double *b, double *output, double *scratch, const int rows, const int inner, const int columns)
+{
+    (void)b, (void)scratch, (void)rows, (void)inner, (void)columns;
+    double det = a[0] * a[3] - a[1] * a[2];
+    double scale = __batchSingular__(a, 2, det) ? NAN : 1.0 / det;
+    double a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3];
+    output[0] = a3 * scale;
+    output[1] = -a1 * scale;
+    output[2] = -a2 * scale;
+    output[3] = a0 * scale;
+}
+
+/**
+ * @brief Inverts one 3 x 3 matrix in closed form, as its adjugate over its determinant.
+ * @note This is a private helper function. A __BatchKernel__. A singular matrix yields NaNs.
+ */
+void __batchInverse3__(const double *a, const double *b, double *output, double *scratch, const int rows, const int inner, const int columns)
+{
+    (void)b, (void)scratch, (void)rows, (void)inner, (void)columns;
+    double adjugate[9] = {
+        a[4] * a[8] - a[5] * a[7], a[2] * a[7] - a[1] * a[8], a[1] * a[5] - a[2] * a[4],
+        a[5] * a[6] - a[3] * a[8], a[0] * a[8] - a[2] * a[6], a[2] * a[3] - a[0] * a[5],
+        a[3] * a[7] - a[4] * a[6], a[1] * a[6] - a[0] * a[7], a[0] * a[4] - a[1] * a[3]};
+    double det = a[0] * adjugate[0] + a[1] * adjugate[3] + a[2] * adjugate[6];
+    double scale = __batchSingular__(a, 3, det) ? NAN : 1.0 / det;
+    for (int i = 0; i < 9; i++)
+        output[i] = adjugate[i] * scale;
+}
+
+/**
+ * @brief Inverts one 4 x 4 matrix in closed form, as its adjugate over its determinant.
+ * @note This is a private helper function. A __BatchKernel__. A singular matrix yields NaNs.
+ * The cofactors are built from the same 2 x 2 minors as __batchDeterminant4__.
+ */
+void __batchInverse4__(const double *a, const double *b, double *output, double *scratch, const int rows, const int inner, const int columns)
+{
+    (void)b, (void)scratch, (void)rows, (void)inner, (void)columns;
+    double s0 = a[0] * a[5] - a[4] * a[1], s1 = a[0] * a[6] - a[4] * a[2], s2 = a[0] * a[7] - a[4] * a[3];
+    double s3 = a[1] * a[6] - a[5] * a[2], s4 = a[1] * a[7] - a[5] * a[3], s5 = a[2] * a[7] - a[6] * a[3];
+    double c5 = a[10] * a[15] - a[14] * a[11], c4 = a[9] * a[15] - a[13] * a[11], c3 = a[9] * a[14] - a[13] * a[10];
+    double c2 = a[8] * a[15] - a[12] * a[11], c1 = a[8] * a[14] - a[12] * a[10], c0 = a[8] * a[13] - a[12] * a[9];
+    double det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    double scale = __batchSingular__(a, 4, det) ? NAN : 1.0 / det;
+    double adjugate[16] = {
+        a[5] * c5 - a[6] * c4 + a[7] * c3, -a[1] * c5 + a[2] * c4 - a[3] * c3, a[13] * s5 - a[14] * s4 + a[15] * s3, -a[9] * s5 + a[10] * s4 - a[11] * s3,
+        -a[4] * c5 + a[6] * c2 - a[7] * c1, a[0] * c5 - a[2] * c2 + a[3] * c1, -a[12] * s5 + a[14] * s2 - a[15] * s1, a[8] * s5 - a[10] * s2 + a[11] * s1,
+        a[4] * c4 - a[5] * c2 + a[7] * c0, -a[0] * c4 + a[1] * c2 - a[3] * c0, a[12] * s4 - a[13] * s2 + a[15] * s0, -a[8] * s4 + a[9] * s2 - a[11] * s0,
+        -a[4] * c3 + a[5] * c1 - a[6] * c0, a[0] * c3 - a[1] * c1 + a[2] * c0, -a[12] * s3 + a[13] * s1 - a[14] * s0, a[8] * s3 - a[9] * s1 + a[10] * s0};
+    for (int i = 0; i < 16; i++)
+        output[i] = adjugate[i] * scale;
+}
+
+/**
+ * @brief Shared state of a batched operation.
+ * @note This is a private helper type.
+ */
+typedef struct
+{
+    __BatchKernel__ kernel;
+    const double *a;
+    const double *b;
+    double *output;
+    double *scratch;
+    size_t aSize;
+    size_t bSize;
+    size_t outputSize;
+    int rows;
+    int inner;
+    int columns;
+    int count;
+    int blocks;
+} __BatchJob__;
+
+/**
+ * @brief Applies the kernel of a __BatchJob__ to one block of the batch.
+ * @param context The __BatchJob__.
+ * @param block The index of the block of matrices.
+ * @param worker Unused.
+ * @note This is a private helper function. Each block has its own slice of the scratch space.
+ */
+void __batchRange__(void *context, const int block, const int worker)
+{
+    (void)worker;
+    __BatchJob__ *job = (__BatchJob__ *)context;
+    int from = (int)((long long)job->count * block / job->blocks);
+    int to = (int)((long long)job->count * (block + 1) / job->blocks);
+    double *scratch = job->scratch != NULL ? job->scratch + (size_t)block * job->rows * job->columns : NULL;
+    for (int k = from; k < to; k++)
+        job->kernel(job->a + k * job->aSize, job->b != NULL ? job->b + k * job->bSize : NULL,
+                    job->output + k * job->outputSize, scratch, job->rows, job->inner, job->columns);
+}
+
+/**
+ * @brief Runs a kernel over a whole batch, split into blocks across the thread pool.
+ * @param job The job, with everything but `scratch` and `blocks` filled in.
+ * @param needsScratch Whether the kernel uses its scratch space.
+ * @return true on success, false if the scratch space cannot be allocated.
+ * @note This is a private helper function. Batches with fewer than MATRIX_PARALLEL_CUTOFF
+ * multiply-adds in total run on the calling thread.
+ */
+bool __batchRun__(__BatchJob__ *job, const bool needsScratch)
+{
+    job->blocks = __rowBlocks__(job->count, (double)job->count * job->rows * job->inner * job->columns);
+    job->scratch = NULL;
+    if (needsScratch)
+    {
+        job->scratch = (double *)malloc((size_t)job->blocks * job->rows * job->columns * sizeof(double));
+        if (job->scratch == NULL)
+            return false;
+    }
+    __poolRun__(job->blocks, __batchRange__, job);
+    free(job->scratch);
+    return true;
+}
+
+/**
+ * @brief Multiplies two batches of matrices pairwise.
+ * @param batch1 The left matrices, each m x k.
+ * @param batch2 The right matrices, each k x n. Must hold as many matrices as batch1.
+ * @return A pointer to a new batch of the m x n products, or NULL if the shapes or counts do not
+ * match or allocation fails.
+ * @note Square 2 x 2, 3 x 3, 4 x 4 and 8 x 8 products use fully unrolled kernels. Large batches
+ * are split across the thread pool.
+ */
+MatrixBatch *batchDot(const MatrixBatch *batch1, const MatrixBatch *batch2)
+{
+    if (batch1 == NULL || batch2 == NULL || batch1->count != batch2->count || batch1->columns != batch2->rows)
+        return NULL;
+
+    MatrixBatch *result = batchInit(batch1->count, batch1->rows, batch2->columns);
+    if (result == NULL)
+        return NULL;
+
+    __BatchKernel__ kernel = __batchDot__;
+    if (batch1->rows == batch1->columns && batch2->rows == batch2->columns)
+        switch (batch1->rows)
+        {
+        case 2:
+            kernel = __batchDot2__;
+            break;
+        case 3:
+            kernel = __batchDot3__;
+            break;
+        case 4:
+            kernel = __batchDot4__;
+            break;
+        case 8:
+            kernel = __batchDot8__;
+            break;
+        }
+    __BatchJob__ job = {kernel, batch1->data, batch2->data, result->data, NULL,
+                        (size_t)batch1->rows * batch1->columns, (size_t)batch2->rows * batch2->columns, (size_t)result->rows * result->columns,
+                        batch1->rows, batch1->columns, batch2->columns, batch1->count, 0};
+    __batchRun__(&job, false);
+    return result;
+}
+
+/**
+ * @brief Transposes every matrix of a batch.
+ * @param batch The batch of m x n matrices.
+ * @return A pointer to a new batch of the n x m transposes, or NULL on failure.
+ * @note Square 2 x 2, 3 x 3, 4 x 4 and 8 x 8 matrices use fully unrolled kernels.
+ */
+MatrixBatch *batchTranspose(const MatrixBatch *batch)
+{
+    if (batch == NULL)
+        return NULL;
+
+    MatrixBatch *result = batchInit(batch->count, batch->columns, batch->rows);
+    if (result == NULL)
+        return NULL;
+
+    __BatchKernel__ kernel = __batchTranspose__;
+    if (batch->rows == batch->columns)
+        switch (batch->rows)
+        {
+        case 2:
+            kernel = __batchTranspose2__;
+            break;
+        case 3:
+            kernel = __batchTranspose3__;
+            break;
+        case 4:
+            kernel = __batchTranspose4__;
+            break;
+        case 8:
+            kernel = __batchTranspose8__;
+            break;
+        }
+    size_t size = (size_t)batch->rows * batch->columns;
+    __BatchJob__ job = {kernel, batch->data, NULL, result->data, NULL, size, 0, size, batch->rows, 1, batch->columns, batch->count, 0};
+    __batchRun__(&job, false);
+    return result;
+}
+
+/**
+ * @brief Computes the determinant of every matrix of a batch.
+ * @param batch The batch of square matrices.
+ * @return A pointer to a new array of `count` determinants, or NULL if the matrices are not
+ * square or allocation fails. The caller is responsible for freeing this memory.
+ * @note 2 x 2, 3 x 3 and 4 x 4 determinants are computed in closed form; larger ones by
+ * Gaussian elimination with partial pivoting. As in determinant(), a matrix with a pivot smaller
+ * than 1e-12 has determinant 0.0.
+ */
+double *batchDeterminant(const MatrixBatch *batch)
+{
+    if (batch == NULL || batch->rows != batch->columns)
+        return NULL;
 
-        array = (double *)malloc(matrix->columns * sizeof(double));
-        if (array == NULL)
-            return NULL;
+    double *determinants = (double *)malloc(batch->count * sizeof(double));
+    if (determinants == NULL)
+        return NULL;
 
-        for (int j = 0; j < matrix->columns; j++)
-            array[j] = func(matrix->grid[index][j]);
+    int n = batch->rows;
+    __BatchKernel__ kernel = n == 2 ? __batchDeterminant2__ : n == 3 ? __batchDeterminant3__ : n == 4 ? __batchDeterminant4__ : __batchDeterminant__;
+    __BatchJob__ job = {kernel, batch->data, NULL, determinants, NULL, (size_t)n * n, 0, 1, n, n, n, batch->count, 0};
+    if (!__batchRun__(&job, kernel == __batchDeterminant__))
+    {
+        free(determinants);
+        return NULL;
     }
-    return array;
+    return determinants;
 }
 
 /**
- * @brief Applies a binary function to corresponding elements of two matrices and returns a new matrix with the results.
- * @param matrix1 The first source matrix.
- * @param matrix2 The second source matrix.
- * @param func A function pointer that takes two doubles and returns a double.
- * @return A pointer to the new result matrix, or NULL if matrices are incompatible or allocation fails.
+ * @brief Inverts every matrix of a batch.
+ * @param batch The batch of square matrices.
+ * @return A pointer to a new batch of the inverses, or NULL if the matrices are not square or
+ * allocation fails.
+ * @note The inverse of a singular matrix is filled with NaN rather than failing the whole batch;
+ * test one element with isnan() to detect it. As in inverse(), a matrix is singular when a pivot
+ * smaller than 1e-12 is met, so near-singular matrices also yield NaN.
+ * @note 2 x 2, 3 x 3 and 4 x 4 matrices are inverted in closed form (adjugate over determinant),
+ * larger ones by Gauss-Jordan elimination with partial pivoting.
  */
-Matrix *elementwise(const Matrix *matrix1, const Matrix *matrix2, double (*func)(double, double))
+MatrixBatch *batchInverse(const MatrixBatch *batch)
 {
-    if (matrix1 == NULL || matrix2 == NULL || func == NULL || matrix1->rows != matrix2->rows || matrix1->columns != matrix2->columns)
+    if (batch == NULL || batch->rows != batch->columns)
         return NULL;
 
-    Matrix *result = init(matrix1->rows, matrix1->columns);
-    for (int i = 0; i < result->rows; i++)
-        for (int j = 0; j < result->columns; j++)
-            result->grid[i][j] = func(matrix1->grid[i][j], matrix2->grid[i][j]);
+    MatrixBatch *result = batchInit(batch->count, batch->rows, batch->columns);
+    if (result == NULL)
+        return NULL;
 
+    int n = batch->rows;
+    __BatchKernel__ kernel = n == 2 ? __batchInverse2__ : n == 3 ? __batchInverse3__ : n == 4 ? __batchInverse4__ : __batchInverse__;
+    __BatchJob__ job = {kernel, batch->data, NULL, result->data, NULL, (size_t)n * n, 0, (size_t)n * n, n, n, n, batch->count, 0};
+    if (!__batchRun__(&job, kernel == __batchInverse__))
+    {
+        destroyBatch(result);
+        return NULL;
+    }
     return result;
 }
 
 /**
- * @brief Applies a binary function to a row or column of a matrix and a 1D array, returning the result as a new 1D array.
- * @param matrix The source matrix.
- * @param index The index of the row or column.
- * @param axis A boolean flag: true for a column, false for a row.
- * @param array The 1D array of values.
- * @param func A function pointer that takes two doubles and returns a double.
- * @return A pointer to the new result array, or NULL on failure. The caller is responsible for freeing this memory.
+ * @brief Default edge length, in elements, of the square tiles of a DiskMatrix.
+ * @note A 256 x 256 tile of doubles is 512 KiB: large enough for sequential disk reads and for
+ * gemm() to run at full speed on a pair of tiles.
+ * @note Define this before including the header to override the default.
  */
-double *elementwiseField(const Matrix *matrix, const int index, const bool axis, const double *array, double (*func)(double, double))
+#ifndef DISK_TILE
+#define DISK_TILE 256
+#endif
+
+/**
+ * @brief Default memory budget, in bytes, of the out-of-core operations.
+ * @note Define this before including the header to override the default.
+ */
+#ifndef DISK_BUDGET
+#define DISK_BUDGET ((size_t)256 << 20)
+#endif
+
+/**
+ * @struct DiskMatrix
+ * @brief A matrix that lives in a file and is processed a tile at a time, so it may exceed memory.
+ * @var descriptor The descriptor of the open file.
+ * @var lock Serializes seeking and transferring on `descriptor`.
+ * @var rows The number of rows in the matrix.
+ * @var columns The number of columns in the matrix.
+ * @var tile The edge length of the square tiles.
+ * @var tileRows The number of rows of tiles.
+ * @var tileColumns The number of columns of tiles.
+ * @note The file starts with the same 64-byte header as save() writes, with its `tile` field set,
+ * followed by the tiles in row-major order of tiles. Every tile is stored as a full tile x tile
+ * row-major block, so tile (i, j) lives at a fixed offset; edge tiles are padded and their
+ * padding is never read back as part of the matrix.
+ * @note File offsets are computed in `off_t`. On 32-bit platforms, compile with
+ * `-D_FILE_OFFSET_BITS=64` to address files of 2 GiB and more; otherwise tiles beyond that are
+ * rejected instead of wrapping around.
+ * @note Tile reads and writes share the file offset of `descriptor`, so each seek-and-transfer
+ * holds `lock`. Several threads may therefore read and write tiles of one DiskMatrix at once;
+ * diskClose must not race with them.
+ */
+typedef struct
 {
-    if (matrix == NULL || array == NULL || func == NULL)
-        return NULL;
+    int descriptor;
+    pthread_mutex_t lock;
+    int rows;
+    int columns;
+    int tile;
+    int tileRows;
+    int tileColumns;
+} DiskMatrix;
 
-    double *result;
-    if (axis) // apply to column
+/**
+ * @brief Allocates a DiskMatrix for an open file.
+ * @param descriptor The descriptor of the file, positioned anywhere.
+ * @param rows The number of rows.
+ * @param columns The number of columns.
+ * @param tile The edge length of the tiles.
+ * @return A pointer to the new DiskMatrix, or NULL if allocation fails (the file is then closed).
+ * @note This is a private helper function.
+ */
+DiskMatrix *__diskInit__(const int descriptor, const int rows, const int columns, const int tile)
+{
+    DiskMatrix *disk = (DiskMatrix *)malloc(sizeof(DiskMatrix));
+    if (disk == NULL)
     {
-        if (index < 0 || index >= matrix->columns)
-            return NULL;
+        close(descriptor);
+        return NULL;
+    }
+    disk->descriptor = descriptor;
+    pthread_mutex_init(&disk->lock, NULL);
+    disk->rows = rows;
+    disk->columns = columns;
+    disk->tile = tile;
+    disk->tileRows = (rows + tile - 1) / tile;
+    disk->tileColumns = (columns + tile - 1) / tile;
+    return disk;
+}
 
-        result = (double *)malloc(matrix->rows * sizeof(double));
-        if (result == NULL)
-            return NULL;
+/**
+ * @brief Computes the file offset at which a tile of a DiskMatrix starts.
+ * @param disk The DiskMatrix.
+ * @param tile The index of the tile in row-major order of tiles; tileRows * tileColumns gives the size of the file.
+ * @param offset Receives the offset of the start of the tile.
+ * @return true on success, false if the offset does not fit in `off_t`.
+ * @note This is a private helper function. The arithmetic is done in 64 bits, so that a 32-bit
+ * `off_t` reports overflow instead of wrapping around.
+ */
+bool __diskOffset__(const DiskMatrix *disk, const long long tile, off_t *offset)
+{
+    long long bytes = MATRIX_FILE_HEADER + tile * disk->tile * disk->tile * (long long)sizeof(double);
+    *offset = (off_t)bytes;
+    return (long long)*offset == bytes;
+}
 
-        for (int i = 0; i < matrix->rows; i++)
-            result[i] = func(matrix->grid[i][index], array[i]);
-    }
-    else // apply to row
-    {
-        if (index < 0 || index >= matrix->rows)
-            return NULL;
+/**
+ * @brief Creates a zero-filled DiskMatrix file, overwriting any existing file.
+ * @param path The path of the file.
+ * @param rows The number of rows. Must be greater than 0.
+ * @param columns The number of columns. Must be greater than 0.
+ * @param tile The edge length of the tiles, or 0 for DISK_TILE.
+ * @return A pointer to the new DiskMatrix, or NULL if the input is invalid or the file cannot be created.
+ * @note The file is extended by writing its last byte, so on most file systems the zero tiles
+ * take no disk space until they are written.
+ */
+DiskMatrix *diskCreate(const char *path, const int rows, const int columns, const int tile)
+{
+    if (path == NULL || rows <= 0 || columns <= 0 || tile < 0)
+        return NULL;
 
-        result = (double *)malloc(matrix->columns * sizeof(double));
-        if (result == NULL)
-            return NULL;
+    int edge = tile > 0 ? tile : DISK_TILE;
+    int descriptor = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (descriptor < 0)
+        return NULL;
+    DiskMatrix *disk = __diskInit__(descriptor, rows, columns, edge);
+    if (disk == NULL)
+        return NULL;
 
-        for (int j = 0; j < matrix->columns; j++)
-            result[j] = func(matrix->grid[index][j], array[j]);
+    char header[MATRIX_FILE_HEADER] = {0};
+    __MatrixFileHeader__ fields = {MATRIX_FILE_MAGIC, MATRIX_FILE_VERSION, rows, columns, MATRIX_FILE_FLOAT64, MATRIX_FILE_ENDIANNESS, edge};
+    memcpy(header, &fields, sizeof(fields));
+    off_t size;
+    if (!__diskOffset__(disk, (long long)disk->tileRows * disk->tileColumns, &size) || !__writeAll__(descriptor, header, sizeof(header)) ||
+        lseek(descriptor, size - 1, SEEK_SET) != size - 1 || !__writeAll__(descriptor, "", 1))
+    {
+        close(descriptor);
+        pthread_mutex_destroy(&disk->lock);
+        free(disk);
+        remove(path);
+        return NULL;
     }
-    return result;
+    return disk;
 }
 
 /**
- * @brief Performs matrix multiplication (dot product) of two matrices.
- * @param matrix1 The first matrix.
- * @param matrix2 The second matrix.
- * @return A pointer to the resulting matrix, or NULL if the matrices are not compatible for multiplication.
+ * @brief Opens an existing DiskMatrix file for reading and writing.
+ * @param path The path of a file created by diskCreate.
+ * @return A pointer to the DiskMatrix, or NULL if the file cannot be opened, is not a tiled
+ * matrix file, or was written with a different byte order.
  */
-Matrix *dot(const Matrix *matrix1, const Matrix *matrix2)
+DiskMatrix *diskOpen(const char *path)
 {
-    if (matrix1 == NULL || matrix2 == NULL || matrix1->columns != matrix2->rows)
+    if (path == NULL)
         return NULL;
 
-    Matrix *result = init(matrix1->rows, matrix2->columns);
-    if (result == NULL)
+    int descriptor = open(path, O_RDWR);
+    if (descriptor < 0)
+        return NULL;
+    __MatrixFileHeader__ header;
+    if (read(descriptor, &header, sizeof(header)) != (ssize_t)sizeof(header) || header.magic != MATRIX_FILE_MAGIC || header.version != MATRIX_FILE_VERSION ||
+        header.dtype != MATRIX_FILE_FLOAT64 || header.endianness != MATRIX_FILE_ENDIANNESS ||
+        header.rows <= 0 || header.columns <= 0 || header.tile <= 0)
+    {
+        close(descriptor);
         return NULL;
+    }
+    return __diskInit__(descriptor, header.rows, header.columns, header.tile);
+}
 
-    for (int i = 0; i < result->rows; i++)
-        for (int j = 0; j < result->columns; j++)
-        {
-            result->grid[i][j] = 0.0;
-            for (int k = 0; k < matrix1->columns; k++)
-                result->grid[i][j] += matrix1->grid[i][k] * matrix2->grid[k][j];
-        }
+/**
+ * @brief Closes a DiskMatrix's file and frees the DiskMatrix.
+ * @param disk The DiskMatrix to close. If NULL, the function does nothing.
+ * @note The file itself is kept; remove it with remove() if it is no longer needed.
+ */
+void diskClose(DiskMatrix *disk)
+{
+    if (disk == NULL)
+        return;
+    close(disk->descriptor);
+    pthread_mutex_destroy(&disk->lock);
+    free(disk);
+}
 
-    return result;
+/**
+ * @brief Computes how many rows or columns of a tile lie inside the matrix.
+ * @param disk The DiskMatrix.
+ * @param index The row or column index of the tile.
+ * @param axis false for the tile's rows, true for its columns.
+ * @return The tile edge, or less for the last row or column of tiles.
+ * @note This is a private helper function.
+ */
+int __diskExtent__(const DiskMatrix *disk, const int index, const bool axis)
+{
+    int size = axis ? disk->columns : disk->rows;
+    int rest = size - index * disk->tile;
+    return rest < disk->tile ? rest : disk->tile;
 }
 
 /**
- * @brief Calculates the determinant of a square matrix.
- * @param matrix The square matrix.
- * @return The determinant value, or 0.0 if the matrix is not square or a singular matrix.
+ * @brief Reads one tile of a DiskMatrix.
+ * @param disk The DiskMatrix.
+ * @param row The row index of the tile.
+ * @param column The column index of the tile.
+ * @param buffer An array of tile * tile doubles that receives the tile in row-major order.
+ * @return true on success, false if the input is invalid or the read fails.
+ * @note Elements of an edge tile that lie outside the matrix are unspecified.
+ * @note Safe to call from several threads on the same DiskMatrix; see DiskMatrix.
  */
-double determinant(const Matrix *matrix)
+bool diskReadTile(const DiskMatrix *disk, const int row, const int column, double *buffer)
 {
-    if (matrix == NULL || matrix->rows != matrix->columns)
-        return 0.0;
+    if (disk == NULL || buffer == NULL || row < 0 || row >= disk->tileRows || column < 0 || column >= disk->tileColumns)
+        return false;
+    off_t offset;
+    if (!__diskOffset__(disk, (long long)row * disk->tileColumns + column, &offset))
+        return false;
+    pthread_mutex_t *lock = (pthread_mutex_t *)&disk->lock;
+    pthread_mutex_lock(lock);
+    bool ok = lseek(disk->descriptor, offset, SEEK_SET) == offset;
+    char *bytes = (char *)buffer;
+    size_t size = (size_t)disk->tile * disk->tile * sizeof(double);
+    while (ok && size > 0)
+    {
+        ssize_t got = read(disk->descriptor, bytes, size);
+        ok = got > 0;
+        bytes += ok ? got : 0;
+        size -= ok ? (size_t)got : 0;
+    }
+    pthread_mutex_unlock(lock);
+    return ok;
+}
 
-    int n = matrix->rows;
-    Matrix *A = copy(matrix);
-    if (A == NULL)
-        return 0.0;
+/**
+ * @brief Writes one tile of a DiskMatrix.
+ * @param disk The DiskMatrix.
+ * @param row The row index of the tile.
+ * @param column The column index of the tile.
+ * @param buffer An array of tile * tile doubles holding the tile in row-major order.
+ * @return true on success, false if the input is invalid or the write fails.
+ * @note Safe to call from several threads on the same DiskMatrix; see DiskMatrix.
+ */
+bool diskWriteTile(DiskMatrix *disk, const int row, const int column, const double *buffer)
+{
+    if (disk == NULL || buffer == NULL || row < 0 || row >= disk->tileRows || column < 0 || column >= disk->tileColumns)
+        return false;
+    off_t offset;
+    if (!__diskOffset__(disk, (long long)row * disk->tileColumns + column, &offset))
+        return false;
+    pthread_mutex_lock(&disk->lock);
+    bool ok = lseek(disk->descriptor, offset, SEEK_SET) == offset &&
+              __writeAll__(disk->descriptor, buffer, (size_t)disk->tile * disk->tile * sizeof(double));
+    pthread_mutex_unlock(&disk->lock);
+    return ok;
+}
 
-    double det = 1.0;
-    int sign = 1;
+/**
+ * @brief Writes an in-memory matrix to a new DiskMatrix file.
+ * @param matrix The matrix.
+ * @param path The path of the file. An existing file is overwritten.
+ * @param tile The edge length of the tiles, or 0 for DISK_TILE.
+ * @return A pointer to the new DiskMatrix, or NULL on failure.
+ */
+DiskMatrix *toDisk(const Matrix *matrix, const char *path, const int tile)
+{
+    if (matrix == NULL)
+        return NULL;
 
-    for (int i = 0; i < n; i++)
-    {
-        // Partial pivoting (find max in column)
-        int pivot = i;
-        for (int j = i + 1; j < n; j++)
+    DiskMatrix *disk = diskCreate(path, matrix->rows, matrix->columns, tile);
+    if (disk == NULL)
+        return NULL;
+    double *buffer = (double *)calloc((size_t)disk->tile * disk->tile, sizeof(double));
+    bool success = buffer != NULL;
+    for (int ti = 0; success && ti < disk->tileRows; ti++)
+        for (int tj = 0; success && tj < disk->tileColumns; tj++)
         {
-            if (fabs(A->grid[j][i]) > fabs(A->grid[pivot][i]))
-                pivot = j;
+            int rows = __diskExtent__(disk, ti, false), columns = __diskExtent__(disk, tj, true);
+            for (int i = 0; i < rows; i++)
+                memcpy(buffer + (size_t)i * disk->tile, matrix->grid[ti * disk->tile + i] + tj * disk->tile, columns * sizeof(double));
+            success = diskWriteTile(disk, ti, tj, buffer);
         }
+    free(buffer);
+    if (!success)
+    {
+        diskClose(disk);
+        remove(path);
+        return NULL;
+    }
+    return disk;
+}
 
-        // If pivot is zero -> determinant is zero
-        if (fabs(A->grid[pivot][i]) < 1e-12)
-        {
-            destroy(A);
-            return 0.0;
-        }
+/**
+ * @brief Reads a whole DiskMatrix into memory.
+ * @param disk The DiskMatrix.
+ * @return A pointer to the new in-memory matrix, or NULL if allocation or a read fails.
+ */
+Matrix *fromDisk(const DiskMatrix *disk)
+{
+    if (disk == NULL)
+        return NULL;
 
-        // Swap rows if needed
-        if (pivot != i)
+    Matrix *matrix = init(disk->rows, disk->columns);
+    double *buffer = (double *)malloc((size_t)disk->tile * disk->tile * sizeof(double));
+    bool success = matrix != NULL && buffer != NULL;
+    for (int ti = 0; success && ti < disk->tileRows; ti++)
+        for (int tj = 0; success && tj < disk->tileColumns; tj++)
         {
-            double *tmp = A->grid[i];
-            A->grid[i] = A->grid[pivot];
-            A->grid[pivot] = tmp;
-            sign = -sign;
+            success = diskReadTile(disk, ti, tj, buffer);
+            int rows = __diskExtent__(disk, ti, false), columns = __diskExtent__(disk, tj, true);
+            for (int i = 0; success && i < rows; i++)
+                memcpy(matrix->grid[ti * disk->tile + i] + tj * disk->tile, buffer + (size_t)i * disk->tile, columns * sizeof(double));
         }
+    free(buffer);
+    if (!success)
+    {
+        destroy(matrix);
+        return NULL;
+    }
+    return matrix;
+}
 
-        // Eliminate below pivot
-        for (int j = i + 1; j < n; j++)
-        {
-            double factor = A->grid[j][i] / A->grid[i][i];
-            for (int k = i; k < n; k++)
-                A->grid[j][k] -= factor * A->grid[i][k];
-        }
+/**
+ * @brief One tile read requested from a __DiskReader__.
+ * @note This is a private helper type.
+ */
+typedef struct
+{
+    const DiskMatrix *disk;
+    int row;
+    int column;
+    double *buffer;
+} __DiskRead__;
+
+/**
+ * @brief A background thread that reads batches of tiles while the caller computes.
+ * @note This is a private helper type. The caller posts the reads of step s + 1 before it
+ * computes on the buffers of step s, and waits for them before it moves on, so disk reads
+ * overlap computation (double buffering). Only one batch is outstanding at a time.
+ */
+typedef struct
+{
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    __DiskRead__ *reads;
+    int count;
+    bool pending;
+    bool stopping;
+    bool failed;
+} __DiskReader__;
 
-        det *= A->grid[i][i]; // product of U diagonal
+/**
+ * @brief The main loop of a __DiskReader__'s thread.
+ * @param arg The __DiskReader__.
+ * @return NULL.
+ * @note This is a private helper function.
+ */
+void *__diskReaderLoop__(void *arg)
+{
+    __DiskReader__ *reader = (__DiskReader__ *)arg;
+    pthread_mutex_lock(&reader->lock);
+    while (true)
+    {
+        while (!reader->pending && !reader->stopping)
+            pthread_cond_wait(&reader->changed, &reader->lock);
+        if (!reader->pending)
+            break;
+        int count = reader->count;
+        pthread_mutex_unlock(&reader->lock);
+
+        bool success = true;
+        for (int r = 0; success && r < count; r++)
+            success = diskReadTile(reader->reads[r].disk, reader->reads[r].row, reader->reads[r].column, reader->reads[r].buffer);
+
+        pthread_mutex_lock(&reader->lock);
+        reader->failed = reader->failed || !success;
+        reader->pending = false;
+        pthread_cond_broadcast(&reader->changed);
     }
+    pthread_mutex_unlock(&reader->lock);
+    return NULL;
+}
 
-    destroy(A);
-    return sign * det;
+/**
+ * @brief Starts a __DiskReader__.
+ * @param reader The reader to start.
+ * @param capacity The largest number of reads in one batch.
+ * @return true on success, false if allocation or thread creation fails.
+ * @note This is a private helper function.
+ */
+bool __diskReaderStart__(__DiskReader__ *reader, const int capacity)
+{
+    reader->reads = (__DiskRead__ *)malloc(capacity * sizeof(__DiskRead__));
+    if (reader->reads == NULL)
+        return false;
+    reader->count = 0;
+    reader->pending = false;
+    reader->stopping = false;
+    reader->failed = false;
+    pthread_mutex_init(&reader->lock, NULL);
+    pthread_cond_init(&reader->changed, NULL);
+    if (pthread_create(&reader->thread, NULL, __diskReaderLoop__, reader) != 0)
+    {
+        pthread_mutex_destroy(&reader->lock);
+        pthread_cond_destroy(&reader->changed);
+        free(reader->reads);
+        return false;
+    }
+    return true;
 }
 
 /**
- * @brief Calculates the inverse of a square matrix.
- * @param matrix The square matrix to invert.
- * @return A pointer to the inverse matrix, or NULL if the matrix is singular or not square.
+ * @brief Waits until the outstanding batch of a __DiskReader__ has been read.
+ * @param reader The reader.
+ * @return true if every read so far has succeeded, false otherwise.
+ * @note This is a private helper function.
  */
-Matrix *inverse(const Matrix *matrix)
+bool __diskReaderWait__(__DiskReader__ *reader)
 {
-    if (matrix == NULL || matrix->rows != matrix->columns)
-        return NULL;
+    pthread_mutex_lock(&reader->lock);
+    while (reader->pending)
+        pthread_cond_wait(&reader->changed, &reader->lock);
+    bool success = !reader->failed;
+    pthread_mutex_unlock(&reader->lock);
+    return success;
+}
 
-    int n = matrix->rows;
-    Matrix *A = copy(matrix);
-    if (A == NULL)
+/**
+ * @brief Hands a batch of reads to a __DiskReader__ and returns immediately.
+ * @param reader The reader, with no batch outstanding.
+ * @param reads The reads, copied by the reader.
+ * @param count The number of reads, at most the reader's capacity.
+ * @note This is a private helper function.
+ */
+void __diskReaderPost__(__DiskReader__ *reader, const __DiskRead__ *reads, const int count)
+{
+    pthread_mutex_lock(&reader->lock);
+    memcpy(reader->reads, reads, count * sizeof(__DiskRead__));
+    reader->count = count;
+    reader->pending = true;
+    pthread_cond_broadcast(&reader->changed);
+    pthread_mutex_unlock(&reader->lock);
+}
+
+/**
+ * @brief Stops a __DiskReader__, waiting for its outstanding batch, and frees its resources.
+ * @param reader The reader.
+ * @return true if every read has succeeded, false otherwise.
+ * @note This is a private helper function.
+ */
+bool __diskReaderStop__(__DiskReader__ *reader)
+{
+    bool success = __diskReaderWait__(reader);
+    pthread_mutex_lock(&reader->lock);
+    reader->stopping = true;
+    pthread_cond_broadcast(&reader->changed);
+    pthread_mutex_unlock(&reader->lock);
+    pthread_join(reader->thread, NULL);
+    pthread_mutex_destroy(&reader->lock);
+    pthread_cond_destroy(&reader->changed);
+    free(reader->reads);
+    return success;
+}
+
+/**
+ * @brief Counts how many tiles of a DiskMatrix fit in a memory budget.
+ * @param budget The memory budget in bytes, or 0 for DISK_BUDGET.
+ * @param tile The edge length of the tiles.
+ * @return The number of whole tiles that fit.
+ * @note This is a private helper function.
+ */
+size_t __diskBudgetTiles__(const size_t budget, const int tile)
+{
+    return (budget > 0 ? budget : DISK_BUDGET) / ((size_t)tile * tile * sizeof(double));
+}
+
+/**
+ * @brief Streams every tile of a DiskMatrix through a transformation into a new DiskMatrix.
+ * @param disk The source.
+ * @param path The path of the new file.
+ * @param budget The memory budget in bytes, or 0 for DISK_BUDGET.
+ * @param flip Whether tile (i, j) is transposed into tile (j, i) instead of mapped in place.
+ * @param func The function applied to every element when not flipping.
+ * @return A pointer to the new DiskMatrix, or NULL if the budget holds fewer than three tiles or
+ * on failure (the new file is then removed).
+ * @note This is a private helper function. Each step reads a group of consecutive tiles in the
+ * background while the previous group is transformed and written; two groups and one output tile
+ * fit in the budget.
+ */
+DiskMatrix *__diskMap__(const DiskMatrix *disk, const char *path, const size_t budget, const bool flip, double (*func)(double))
+{
+    size_t units = __diskBudgetTiles__(budget, disk->tile);
+    if (units < 3)
+        return NULL;
+    DiskMatrix *result = flip ? diskCreate(path, disk->columns, disk->rows, disk->tile) : diskCreate(path, disk->rows, disk->columns, disk->tile);
+    if (result == NULL)
         return NULL;
 
-    int *pivot = (int *)malloc(n * sizeof(int));
-    if (pivot == NULL)
+    size_t count = (size_t)disk->tile * disk->tile;
+    long tiles = (long)disk->tileRows * disk->tileColumns;
+    long group = (units - 1) / 2 < (size_t)tiles ? (long)((units - 1) / 2) : tiles;
+
+    double *buffers = (double *)malloc((2 * group + 1) * count * sizeof(double));
+    __DiskRead__ *reads = (__DiskRead__ *)malloc(group * sizeof(__DiskRead__));
+    __DiskReader__ reader;
+    bool success = buffers != NULL && reads != NULL && __diskReaderStart__(&reader, group);
+    if (!success)
     {
-        destroy(A);
+        free(buffers);
+        free(reads);
+        diskClose(result);
+        remove(path);
         return NULL;
     }
-    for (int i = 0; i < n; i++)
-        pivot[i] = i;
 
-    // LU decomposition with partial pivoting
-    for (int i = 0; i < n; i++)
+    double *output = buffers + 2 * group * count;
+    memset(output, 0, count * sizeof(double));
+    long steps = (tiles + group - 1) / group;
+    for (long step = 0; step <= steps && success; step++)
     {
-        // Find pivot row
-        int maxRow = i;
-        for (int k = i + 1; k < n; k++)
-            if (fabs(A->grid[k][i]) > fabs(A->grid[maxRow][i]))
-                maxRow = k;
-
-        // Singular matrix check
-        if (fabs(A->grid[maxRow][i]) < 1e-12)
-        {
-            free(pivot);
-            destroy(A);
-            return NULL;
-        }
-
-        // Row swap if necessary
-        if (maxRow != i)
+        if (step > 0)
+            success = __diskReaderWait__(&reader);
+        if (success && step < steps)
         {
-            double *tmp = A->grid[i];
-            A->grid[i] = A->grid[maxRow];
-            A->grid[maxRow] = tmp;
-
-            int tmpIdx = pivot[i];
-            pivot[i] = pivot[maxRow];
-            pivot[maxRow] = tmpIdx;
+            int n = 0;
+            for (long t = step * group; t < tiles && t < (step + 1) * group; t++, n++)
+                reads[n] = (__DiskRead__){disk, (int)(t / disk->tileColumns), (int)(t % disk->tileColumns), buffers + ((step % 2) * group + n) * count};
+            __diskReaderPost__(&reader, reads, n);
         }
+        if (!success || step == 0)
+            continue;
 
-        // Eliminate below pivot
-        for (int k = i + 1; k < n; k++)
+        long previous = step - 1;
+        for (long t = previous * group; success && t < tiles && t < step * group; t++)
         {
-            A->grid[k][i] /= A->grid[i][i];
-            for (int j = i + 1; j < n; j++)
-                A->grid[k][j] -= A->grid[k][i] * A->grid[i][j];
+            const double *input = buffers + ((previous % 2) * group + (t - previous * group)) * count;
+            int ti = (int)(t / disk->tileColumns), tj = (int)(t % disk->tileColumns);
+            int rows = __diskExtent__(disk, ti, false), columns = __diskExtent__(disk, tj, true);
+            for (int i = 0; i < rows; i++)
+                for (int j = 0; j < columns; j++)
+                {
+                    if (flip)
+                        output[(size_t)j * disk->tile + i] = input[(size_t)i * disk->tile + j];
+                    else
+                        output[(size_t)i * disk->tile + j] = func(input[(size_t)i * disk->tile + j]);
+                }
+            success = flip ? diskWriteTile(result, tj, ti, output) : diskWriteTile(result, ti, tj, output);
         }
     }
 
-    // Allocate inverse matrix
-    Matrix *inv = init(n, n);
-    if (inv == NULL)
+    success = __diskReaderStop__(&reader) && success;
+    free(buffers);
+    free(reads);
+    if (!success)
     {
-        free(pivot);
-        destroy(A);
+        diskClose(result);
+        remove(path);
         return NULL;
     }
+    return result;
+}
 
-    // Solve for each column of inverse
-    for (int col = 0; col < n; col++)
-    {
-        double *y = (double *)calloc(n, sizeof(double));
-        double *x = (double *)calloc(n, sizeof(double));
-        if (y == NULL || x == NULL)
-        {
-            free(y);
-            free(x);
-            destroy(inv);
-            free(pivot);
-            destroy(A);
-            return NULL;
-        }
+/**
+ * @brief Transposes a DiskMatrix into a new DiskMatrix file, a tile at a time.
+ * @param disk The source.
+ * @param path The path of the new file. Must differ from the source's.
+ * @param budget The memory budget in bytes, or 0 for DISK_BUDGET. Must hold at least three tiles.
+ * @return A pointer to the new DiskMatrix, or NULL if the budget is too small or on failure.
+ * @note Tiles are read in the background while earlier ones are transposed and written.
+ */
+DiskMatrix *diskTranspose(const DiskMatrix *disk, const char *path, const size_t budget)
+{
+    if (disk == NULL || path == NULL)
+        return NULL;
+    return __diskMap__(disk, path, budget, true, NULL);
+}
 
-        // Forward substitution (Ly = P*e_col)
-        for (int i = 0; i < n; i++)
-        {
-            y[i] = (pivot[i] == col) ? 1.0 : 0.0;
-            for (int j = 0; j < i; j++)
-                y[i] -= A->grid[i][j] * y[j];
-        }
+/**
+ * @brief Applies a function to every element of a DiskMatrix, writing a new DiskMatrix file.
+ * @param disk The source.
+ * @param path The path of the new file. Must differ from the source's.
+ * @param func The function to apply.
+ * @param budget The memory budget in bytes, or 0 for DISK_BUDGET. Must hold at least three tiles.
+ * @return A pointer to the new DiskMatrix, or NULL if the budget is too small or on failure.
+ * @note Tiles are read in the background while earlier ones are transformed and written.
+ */
+DiskMatrix *diskScalar(const DiskMatrix *disk, const char *path, double (*func)(double), const size_t budget)
+{
+    if (disk == NULL || path == NULL || func == NULL)
+        return NULL;
+    return __diskMap__(disk, path, budget, false, func);
+}
 
-        // Back substitution (Ux = y)
-        for (int i = n - 1; i >= 0; i--)
-        {
-            x[i] = y[i];
-            for (int j = i + 1; j < n; j++)
-                x[i] -= A->grid[i][j] * x[j];
-            x[i] /= A->grid[i][i];
-        }
+/**
+ * @brief Lists the tile reads of one step of diskDot().
+ * @param a The left DiskMatrix.
+ * @param b The right DiskMatrix.
+ * @param step The step: row of tiles, panel of result columns and inner tile index, flattened.
+ * @param panel The number of result tiles per panel.
+ * @param buffers The first buffer of the step's half of the double buffer.
+ * @param reads Receives the reads: tile (i, k) of a, then tiles (k, j) of b for the panel.
+ * @return The number of reads.
+ * @note This is a private helper function.
+ */
+int __diskDotReads__(const DiskMatrix *a, const DiskMatrix *b, const long step, const int panel, double *buffers, __DiskRead__ *reads)
+{
+    size_t count = (size_t)a->tile * a->tile;
+    int panels = (b->tileColumns + panel - 1) / panel;
+    int k = (int)(step % a->tileColumns), first = (int)(step / a->tileColumns % panels) * panel;
+    int row = (int)(step / a->tileColumns / panels);
+    int n = 0;
+    reads[n++] = (__DiskRead__){a, row, k, buffers};
+    for (int j = first; j < b->tileColumns && j < first + panel; j++, n++)
+        reads[n] = (__DiskRead__){b, k, j, buffers + n * count};
+    return n;
+}
 
-        // Copy solution vector into inverse matrix
-        for (int i = 0; i < n; i++)
-            inv->grid[i][col] = x[i];
+/**
+ * @brief Multiplies two DiskMatrix files into a new DiskMatrix file, out of core.
+ * @param a The left matrix, m x k.
+ * @param b The right matrix, k x n. Must use the same tile size as `a`.
+ * @param path The path of the result file. Must differ from both sources.
+ * @param budget The memory budget in bytes, or 0 for DISK_BUDGET. Must hold at least five tiles.
+ * @return A pointer to the new m x n DiskMatrix, or NULL if the shapes or tile sizes do not
+ * match, the budget is too small, or an allocation, read or write fails.
+ * @note The result is built one panel of tiles at a time: the budget decides how many result
+ * tiles p are held in memory, next to two sets of one tile of `a` and p tiles of `b` for double
+ * buffering (3p + 2 tiles in all). Each tile of `a` is therefore read once per panel, so a larger
+ * budget means less I/O. The reader thread loads the next tiles while gemm() multiplies the
+ * current ones, and gemm() itself runs on the thread pool.
+ */
+DiskMatrix *diskDot(const DiskMatrix *a, const DiskMatrix *b, const char *path, const size_t budget)
+{
+    if (a == NULL || b == NULL || path == NULL || a->columns != b->rows || a->tile != b->tile)
+        return NULL;
+    size_t units = __diskBudgetTiles__(budget, a->tile);
+    if (units < 5)
+        return NULL;
+
+    DiskMatrix *result = diskCreate(path, a->rows, b->columns, a->tile);
+    if (result == NULL)
+        return NULL;
+
+    int tile = a->tile;
+    size_t count = (size_t)tile * tile;
+    int panel = (units - 2) / 3 < (size_t)b->tileColumns ? (int)((units - 2) / 3) : b->tileColumns;
+    int panels = (b->tileColumns + panel - 1) / panel;
+
+    double *buffers = (double *)malloc((size_t)(3 * panel + 2) * count * sizeof(double));
+    __DiskRead__ *reads = (__DiskRead__ *)malloc((panel + 1) * sizeof(__DiskRead__));
+    __DiskReader__ reader;
+    bool success = buffers != NULL && reads != NULL && __diskReaderStart__(&reader, panel + 1);
+    if (!success)
+    {
+        free(buffers);
+        free(reads);
+        diskClose(result);
+        remove(path);
+        return NULL;
+    }
 
-        free(y);
-        free(x);
+    double *halves[2] = {buffers, buffers + (panel + 1) * count};
+    double *accumulators = buffers + 2 * (panel + 1) * count;
+    long steps = (long)a->tileRows * panels * a->tileColumns;
+    for (long step = 0; step <= steps && success; step++)
+    {
+        if (step > 0)
+            success = __diskReaderWait__(&reader);
+        if (success && step < steps)
+            __diskReaderPost__(&reader, reads, __diskDotReads__(a, b, step, panel, halves[step % 2], reads));
+        if (!success || step == 0)
+            continue;
+
+        long previous = step - 1;
+        int k = (int)(previous % a->tileColumns), first = (int)(previous / a->tileColumns % panels) * panel;
+        int row = (int)(previous / a->tileColumns / panels);
+        int last = first + panel < b->tileColumns ? first + panel : b->tileColumns;
+        if (k == 0)
+            memset(accumulators, 0, (size_t)panel * count * sizeof(double));
+
+        const double *input = halves[previous % 2];
+        int rows = __diskExtent__(a, row, false), inner = __diskExtent__(a, k, true);
+        MatrixView left = {(double *)input, rows, inner, tile, 1};
+        for (int j = first; success && j < last; j++)
+        {
+            int columns = __diskExtent__(b, j, true);
+            MatrixView right = {(double *)input + (j - first + 1) * count, inner, columns, tile, 1};
+            MatrixView target = {accumulators + (j - first) * count, rows, columns, tile, 1};
+            success = gemm(1.0, left, right, 1.0, target);
+        }
+        for (int j = first; success && k == a->tileColumns - 1 && j < last; j++)
+            success = diskWriteTile(result, row, j, accumulators + (j - first) * count);
     }
 
-    free(pivot);
-    destroy(A);
-    return inv;
+    success = __diskReaderStop__(&reader) && success;
+    free(buffers);
+    free(reads);
+    if (!success)
+    {
+        diskClose(result);
+        remove(path);
+        return NULL;
+    }
+    return result;
 }
 
 #endif // MATRIX_H
\ No newline at end of file
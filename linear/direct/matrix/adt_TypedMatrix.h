@@ -0,0 +1,1144 @@
+#ifndef TYPED_MATRIX_H
+#define TYPED_MATRIX_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(TYPED_MATRIX_NO_SIMD)
+#include <immintrin.h>
+#define TYPED_MATRIX_SIMD
+#endif
+
+/**
+ * @brief Alignment, in bytes, of the element storage of every typed matrix.
+ * @note Define this before including the header to override the default.
+ */
+#ifndef TYPED_MATRIX_ALIGNMENT
+#define TYPED_MATRIX_ALIGNMENT 64
+#endif
+
+/**
+ * @brief Rows of the register tile computed by one float GEMM micro-kernel call.
+ * @note Eight rows by eight columns keep eight 8-wide AVX2 accumulators in registers.
+ */
+#define SGEMM_MR 8
+
+/**
+ * @brief Columns of the register tile computed by one float GEMM micro-kernel call.
+ */
+#define SGEMM_NR 8
+
+/**
+ * @brief Rows of A packed per block; an MC x KC block of A is sized to stay in the L2 cache.
+ * @note Must be a multiple of SGEMM_MR. Define this before including the header to override the default.
+ */
+#ifndef SGEMM_MC
+#define SGEMM_MC 128
+#endif
+
+/**
+ * @brief Depth of the packed panels; a KC x NR sliver of B is sized to stay in the L1 cache.
+ * @note Define this before including the header to override the default.
+ */
+#ifndef SGEMM_KC
+#define SGEMM_KC 256
+#endif
+
+/**
+ * @brief Columns of B packed per block; a KC x NC block of B is sized to stay in the L3 cache.
+ * @note Must be a multiple of SGEMM_NR. Define this before including the header to override the default.
+ */
+#ifndef SGEMM_NC
+#define SGEMM_NC 4096
+#endif
+
+/**
+ * @brief Columns of the accumulator block of the generic (non-float) typed product.
+ * @note Together with SGEMM_MC rows and SGEMM_KC depth, this keeps a KC x NC block of B in the L2
+ * cache while SGEMM_MC rows of A stream past it. Define this before including the header to
+ * override the default.
+ */
+#ifndef TYPED_GEMM_NC
+#define TYPED_GEMM_NC 256
+#endif
+
+/**
+ * @brief Work (m * n * k) below which F32Matrix_dot uses a simple loop instead of the packed GEMM.
+ * @note Define this before including the header to override the default.
+ */
+#ifndef TYPED_GEMM_SMALL_WORK
+#define TYPED_GEMM_SMALL_WORK 32768
+#endif
+
+/**
+ * @brief A float GEMM micro-kernel: computes one SGEMM_MR x SGEMM_NR tile from two packed panels.
+ * @note This is a private helper type.
+ */
+typedef void (*__SgemmKernel__)(const int depth, const float *a, const float *b, float *tile);
+
+/**
+ * @brief Computes one SGEMM_MR x SGEMM_NR tile of the product of two packed panels.
+ * @param depth The shared dimension of the panels.
+ * @param a A packed panel of A: `depth` groups of SGEMM_MR values, one column of the block each.
+ * @param b A packed panel of B: `depth` groups of SGEMM_NR values, one row of the block each.
+ * @param tile Receives the SGEMM_MR x SGEMM_NR product in row-major order.
+ * @note This is a private helper function.
+ */
+void __sgemmKernelScalar__(const int depth, const float *a, const float *b, float *tile)
+{
+    float accumulator[SGEMM_MR * SGEMM_NR] = {0.0f};
+    for (int p = 0; p < depth; p++, a += SGEMM_MR, b += SGEMM_NR)
+        for (int i = 0; i < SGEMM_MR; i++)
+            for (int j = 0; j < SGEMM_NR; j++)
+                accumulator[i * SGEMM_NR + j] += a[i] * b[j];
+    memcpy(tile, accumulator, sizeof(accumulator));
+}
+
+#ifdef TYPED_MATRIX_SIMD
+/**
+ * @brief AVX2/FMA variant of __sgemmKernelScalar__.
+ * @param depth The shared dimension of the panels.
+ * @param a A packed panel of A.
+ * @param b A packed panel of B, aligned to 32 bytes.
+ * @param tile Receives the SGEMM_MR x SGEMM_NR product in row-major order.
+ * @note This is a private helper function. Only called when the CPU reports AVX2 and FMA.
+ * @note Keeps the whole 8 x 8 tile in eight registers; each step loads one vector of B,
+ * broadcasts eight values of A and issues eight fused multiply-adds, twice the elements per
+ * instruction of the double-precision kernel.
+ */
+__attribute__((target("avx2,fma"))) void __sgemmKernelAVX2__(const int depth, const float *a, const float *b, float *tile)
+{
+    __m256 c0 = _mm256_setzero_ps(), c1 = _mm256_setzero_ps(), c2 = _mm256_setzero_ps(), c3 = _mm256_setzero_ps();
+    __m256 c4 = _mm256_setzero_ps(), c5 = _mm256_setzero_ps(), c6 = _mm256_setzero_ps(), c7 = _mm256_setzero_ps();
+    for (int p = 0; p < depth; p++, a += SGEMM_MR, b += SGEMM_NR)
+    {
+        __m256 row = _mm256_load_ps(b);
+        c0 = _mm256_fmadd_ps(_mm256_broadcast_ss(a), row, c0);
+        c1 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 1), row, c1);
+        c2 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 2), row, c2);
+        c3 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 3), row, c3);
+        c4 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 4), row, c4);
+        c5 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 5), row, c5);
+        c6 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 6), row, c6);
+        c7 = _mm256_fmadd_ps(_mm256_broadcast_ss(a + 7), row, c7);
+    }
+    _mm256_storeu_ps(tile + 0, c0);
+    _mm256_storeu_ps(tile + 8, c1);
+    _mm256_storeu_ps(tile + 16, c2);
+    _mm256_storeu_ps(tile + 24, c3);
+    _mm256_storeu_ps(tile + 32, c4);
+    _mm256_storeu_ps(tile + 40, c5);
+    _mm256_storeu_ps(tile + 48, c6);
+    _mm256_storeu_ps(tile + 56, c7);
+}
+#endif
+
+/**
+ * @brief Picks the AVX2/FMA or scalar float micro-kernel, whichever the CPU supports.
+ * @return The micro-kernel.
+ * @note This is a private helper function. Define TYPED_MATRIX_NO_SIMD before including the
+ * header to always use the scalar kernel.
+ */
+__SgemmKernel__ __sgemmKernel__()
+{
+#ifdef TYPED_MATRIX_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return __sgemmKernelAVX2__;
+#endif
+    return __sgemmKernelScalar__;
+}
+
+/**
+ * @brief Packs a block of A into row panels of SGEMM_MR rows, zero-padding the last panel.
+ * @param a The first element of the block.
+ * @param lda The distance in elements between two rows of A.
+ * @param rows The number of rows in the block.
+ * @param depth The number of columns in the block.
+ * @param packed The destination buffer.
+ * @note This is a private helper function. Panel p holds `depth` groups of SGEMM_MR values.
+ */
+void __sgemmPackA__(const float *a, const int lda, const int rows, const int depth, float *packed)
+{
+    for (int panel = 0; panel < rows; panel += SGEMM_MR)
+    {
+        int height = rows - panel < SGEMM_MR ? rows - panel : SGEMM_MR;
+        for (int p = 0; p < depth; p++, packed += SGEMM_MR)
+        {
+            int i = 0;
+            for (; i < height; i++)
+                packed[i] = a[(size_t)(panel + i) * lda + p];
+            for (; i < SGEMM_MR; i++)
+                packed[i] = 0.0f;
+        }
+    }
+}
+
+/**
+ * @brief Packs a block of B into column panels of SGEMM_NR columns, zero-padding the last panel.
+ * @param b The first element of the block.
+ * @param ldb The distance in elements between two rows of B.
+ * @param depth The number of rows in the block.
+ * @param columns The number of columns in the block.
+ * @param packed The destination buffer.
+ * @note This is a private helper function. Panel p holds `depth` groups of SGEMM_NR values.
+ */
+void __sgemmPackB__(const float *b, const int ldb, const int depth, const int columns, float *packed)
+{
+    for (int panel = 0; panel < columns; panel += SGEMM_NR)
+    {
+        int width = columns - panel < SGEMM_NR ? columns - panel : SGEMM_NR;
+        for (int p = 0; p < depth; p++, packed += SGEMM_NR)
+        {
+            const float *source = b + (size_t)p * ldb + panel;
+            int j = 0;
+            for (; j < width; j++)
+                packed[j] = source[j];
+            for (; j < SGEMM_NR; j++)
+                packed[j] = 0.0f;
+        }
+    }
+}
+
+/**
+ * @brief Allocates the aligned buffer that holds the packed A and B panels of a float GEMM block.
+ * @param m The number of rows of A.
+ * @param n The number of columns of B.
+ * @param k The shared dimension.
+ * @return The buffer, or NULL if allocation fails. The caller frees it.
+ * @note This is a private helper function. B comes first so its panels stay 32-byte aligned.
+ */
+float *__sgemmBuffer__(const int m, const int n, const int k)
+{
+    int rows = m < SGEMM_MC ? (m + SGEMM_MR - 1) / SGEMM_MR * SGEMM_MR : SGEMM_MC;
+    int columns = n < SGEMM_NC ? (n + SGEMM_NR - 1) / SGEMM_NR * SGEMM_NR : SGEMM_NC;
+    size_t floats = (size_t)(k < SGEMM_KC ? k : SGEMM_KC) * (columns + rows);
+    size_t bytes = (floats * sizeof(float) + TYPED_MATRIX_ALIGNMENT - 1) / TYPED_MATRIX_ALIGNMENT * TYPED_MATRIX_ALIGNMENT;
+    return (float *)aligned_alloc(TYPED_MATRIX_ALIGNMENT, bytes);
+}
+
+/**
+ * @brief Computes C = A * B for float blocks on the calling thread.
+ * @param m The number of rows of A and C.
+ * @param n The number of columns of B and C.
+ * @param k The shared dimension.
+ * @param a The first element of A, with rows `lda` elements apart.
+ * @param lda The distance in elements between two rows of A.
+ * @param b The first element of B, with rows `ldb` elements apart.
+ * @param ldb The distance in elements between two rows of B.
+ * @param c The first element of C, with rows `ldc` elements apart.
+ * @param ldc The distance in elements between two rows of C.
+ * @param buffer A packing buffer from __sgemmBuffer__(m, n, k).
+ * @param kernel The micro-kernel from __sgemmKernel__.
+ * @note This is a private helper function. Same BLIS/GotoBLAS loop nest as __gemmBlock__ in
+ * adt_Matrix.h: B is packed in KC x NC blocks, A in MC x KC blocks, and the micro-kernel
+ * streams through KC x NR slivers of B.
+ */
+void __sgemmBlock__(const int m, const int n, const int k, const float *a, const int lda, const float *b, const int ldb,
+                    float *c, const int ldc, float *buffer, __SgemmKernel__ kernel)
+{
+    for (int i = 0; i < m; i++)
+        memset(c + (size_t)i * ldc, 0, n * sizeof(float));
+
+    int columns = n < SGEMM_NC ? (n + SGEMM_NR - 1) / SGEMM_NR * SGEMM_NR : SGEMM_NC;
+    float *packedB = buffer;
+    float *packedA = buffer + (size_t)(k < SGEMM_KC ? k : SGEMM_KC) * columns;
+    float tile[SGEMM_MR * SGEMM_NR];
+    for (int jc = 0; jc < n; jc += SGEMM_NC)
+    {
+        int nc = n - jc < SGEMM_NC ? n - jc : SGEMM_NC;
+        for (int pc = 0; pc < k; pc += SGEMM_KC)
+        {
+            int kc = k - pc < SGEMM_KC ? k - pc : SGEMM_KC;
+            __sgemmPackB__(b + (size_t)pc * ldb + jc, ldb, kc, nc, packedB);
+            for (int ic = 0; ic < m; ic += SGEMM_MC)
+            {
+                int mc = m - ic < SGEMM_MC ? m - ic : SGEMM_MC;
+                __sgemmPackA__(a + (size_t)ic * lda + pc, lda, mc, kc, packedA);
+                for (int jr = 0; jr < nc; jr += SGEMM_NR)
+                    for (int ir = 0; ir < mc; ir += SGEMM_MR)
+                    {
+                        kernel(kc, packedA + (size_t)ir * kc, packedB + (size_t)jr * kc, tile);
+                        int rows = mc - ir < SGEMM_MR ? mc - ir : SGEMM_MR;
+                        int width = nc - jr < SGEMM_NR ? nc - jr : SGEMM_NR;
+                        for (int i = 0; i < rows; i++)
+                        {
+                            float *target = c + (size_t)(ic + ir + i) * ldc + jc + jr;
+                            for (int j = 0; j < width; j++)
+                                target[j] += tile[i * SGEMM_NR + j];
+                        }
+                    }
+            }
+        }
+    }
+}
+
+#ifdef MATRIX_H
+/**
+ * @brief Shared state of a parallel float GEMM.
+ * @details C is cut into bands of SGEMM_MC rows; each task computes one band with the packing
+ * buffer of the worker that runs it, allocated on first use.
+ * @note This is a private helper type. Only defined when adt_Matrix.h, whose thread pool it
+ * uses, is included before this header.
+ */
+typedef struct
+{
+    int m, n, k;
+    const float *a;
+    int lda;
+    const float *b;
+    int ldb;
+    float *c;
+    int ldc;
+    __SgemmKernel__ kernel;
+    float **buffers;
+    bool *failed;
+} __SgemmJob__;
+
+/**
+ * @brief Computes one band of rows of C for a __SgemmJob__.
+ * @param context The __SgemmJob__.
+ * @param task The index of the band.
+ * @param worker The index of the worker, which selects the packing buffer.
+ * @note This is a private helper function.
+ */
+void __sgemmBand__(void *context, const int task, const int worker)
+{
+    __SgemmJob__ *job = (__SgemmJob__ *)context;
+    if (job->buffers[worker] == NULL)
+    {
+        job->buffers[worker] = __sgemmBuffer__(SGEMM_MC, job->n, job->k);
+        if (job->buffers[worker] == NULL)
+        {
+            job->failed[worker] = true;
+            return;
+        }
+    }
+    int from = task * SGEMM_MC;
+    int rows = job->m - from < SGEMM_MC ? job->m - from : SGEMM_MC;
+    __sgemmBlock__(rows, job->n, job->k, job->a + (size_t)from * job->lda, job->lda, job->b, job->ldb,
+                   job->c + (size_t)from * job->ldc, job->ldc, job->buffers[worker], job->kernel);
+}
+#endif
+
+/**
+ * @brief Computes C = A * B for row-major float matrices (single-precision general matrix multiply).
+ * @param m The number of rows of A and C.
+ * @param n The number of columns of B and C.
+ * @param k The shared dimension.
+ * @param a The first element of A, with rows `lda` elements apart.
+ * @param lda The distance in elements between two rows of A.
+ * @param b The first element of B, with rows `ldb` elements apart.
+ * @param ldb The distance in elements between two rows of B.
+ * @param c The first element of C, with rows `ldc` elements apart. Must not overlap A or B.
+ * @param ldc The distance in elements between two rows of C.
+ * @return true on success, or false if allocation fails.
+ * @note This is a private helper function behind F32Matrix_dot. When adt_Matrix.h is included
+ * before this header, bands of SGEMM_MC rows run on its thread pool (see setThreads);
+ * otherwise the product runs on the calling thread.
+ */
+bool __sgemm__(const int m, const int n, const int k, const float *a, const int lda, const float *b, const int ldb,
+               float *c, const int ldc)
+{
+    __SgemmKernel__ kernel = __sgemmKernel__();
+#ifdef MATRIX_H
+    int threads = (double)m * n * k < GEMM_PARALLEL_WORK ? 1 : getThreads();
+    int bands = (m + SGEMM_MC - 1) / SGEMM_MC;
+    if (threads > 1 && bands > 1)
+    {
+        __SgemmJob__ job = {m, n, k, a, lda, b, ldb, c, ldc, kernel, NULL, NULL};
+        job.buffers = (float **)calloc(threads, sizeof(float *));
+        job.failed = (bool *)calloc(threads, sizeof(bool));
+        bool success = job.buffers != NULL && job.failed != NULL;
+        if (success)
+            __poolRun__(bands, __sgemmBand__, &job);
+        for (int t = 0; success && t < threads; t++)
+            if (job.failed[t])
+                success = false;
+        for (int t = 0; job.buffers != NULL && t < threads; t++)
+            free(job.buffers[t]);
+        free(job.buffers);
+        free(job.failed);
+        return success;
+    }
+#endif
+    float *buffer = __sgemmBuffer__(m, n, k);
+    if (buffer == NULL)
+        return false;
+    __sgemmBlock__(m, n, k, a, lda, b, ldb, c, ldc, buffer, kernel);
+    free(buffer);
+    return true;
+}
+
+#ifdef MATRIX_H
+/**
+ * @brief Computes C = A * B for row-major double matrices through gemm() of adt_Matrix.h.
+ * @param m The number of rows of A and C.
+ * @param n The number of columns of B and C.
+ * @param k The shared dimension.
+ * @param a The first element of A, with rows `lda` elements apart.
+ * @param lda The distance in elements between two rows of A.
+ * @param b The first element of B, with rows `ldb` elements apart.
+ * @param ldb The distance in elements between two rows of B.
+ * @param c The first element of C, with rows `ldc` elements apart. Must not overlap A or B.
+ * @param ldc The distance in elements between two rows of C.
+ * @return true on success, or false if allocation fails.
+ * @note This is a private helper function behind F64Matrix_dot.
+ */
+bool __dgemm__(const int m, const int n, const int k, const double *a, const int lda, const double *b, const int ldb,
+               double *c, const int ldc)
+{
+    MatrixView left = {(double *)a, m, k, lda, 1};
+    MatrixView right = {(double *)b, k, n, ldb, 1};
+    MatrixView product = {c, m, n, ldc, 1};
+    return gemm(1.0, left, right, 0.0, product);
+}
+
+/**
+ * @brief Whether a typed matrix multiplies through gemm() of adt_Matrix.h (__dgemm__).
+ * @param T The element type.
+ * @param ACC The accumulator type.
+ * @return 1 when both are double, otherwise 0; a constant the compiler folds away.
+ * @note This is a private helper macro. Always 0 unless adt_Matrix.h is included before this header.
+ */
+#define __TYPED_IS_DGEMM__(T, ACC) _Generic((T)0, double: _Generic((ACC)0, double: 1, default: 0), default: 0)
+#else
+#define __TYPED_IS_DGEMM__(T, ACC) 0
+#define __dgemm__(m, n, k, a, lda, b, ldb, c, ldc) false
+#endif
+
+/**
+ * @brief Seeds the random number generator once, for the generated `name_random` functions.
+ * @note This is a private helper function.
+ */
+void __typedSeeding__()
+{
+    static int seeded = 0;
+    if (!seeded)
+    {
+        srand((unsigned int)time(NULL));
+        seeded = 1;
+    }
+}
+
+/**
+ * @brief Reduces a square double matrix to the identity by Gauss-Jordan elimination.
+ * @param a The n x n matrix in row-major order; destroyed.
+ * @param inverse An n x n identity matrix in row-major order that receives the inverse, or NULL
+ * when only the determinant is needed (the elimination then stops at upper triangular form).
+ * @param n The dimension.
+ * @return The determinant of `a`, or 0.0 if a pivot smaller than 1e-12 is met, as in factorize()
+ * (`inverse` is then incomplete).
+ * @note This is a private helper function behind the generated `name_determinant` and
+ * `name_inverse`. Uses partial pivoting, so every typed matrix is factored in double precision.
+ */
+double __typedEliminate__(double *a, double *inverse, const int n)
+{
+    double det = 1.0;
+    for (int k = 0; k < n; k++)
+    {
+        int pivot = k;
+        for (int i = k + 1; i < n; i++)
+            if (fabs(a[(size_t)i * n + k]) > fabs(a[(size_t)pivot * n + k]))
+                pivot = i;
+        if (fabs(a[(size_t)pivot * n + k]) < 1e-12)
+            return 0.0;
+        if (pivot != k)
+        {
+            det = -det;
+            for (int j = 0; j < n; j++)
+            {
+                double temp = a[(size_t)k * n + j];
+                a[(size_t)k * n + j] = a[(size_t)pivot * n + j];
+                a[(size_t)pivot * n + j] = temp;
+                if (inverse != NULL)
+                {
+                    temp = inverse[(size_t)k * n + j];
+                    inverse[(size_t)k * n + j] = inverse[(size_t)pivot * n + j];
+                    inverse[(size_t)pivot * n + j] = temp;
+                }
+            }
+        }
+
+        double diagonal = a[(size_t)k * n + k];
+        det *= diagonal;
+        for (int i = inverse != NULL ? 0 : k + 1; i < n; i++)
+        {
+            double factor = a[(size_t)i * n + k] / diagonal;
+            if (i == k || factor == 0.0)
+                continue;
+            for (int j = k; j < n; j++)
+                a[(size_t)i * n + j] -= factor * a[(size_t)k * n + j];
+            if (inverse != NULL)
+                for (int j = 0; j < n; j++)
+                    inverse[(size_t)i * n + j] -= factor * inverse[(size_t)k * n + j];
+        }
+    }
+    if (inverse != NULL)
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                inverse[(size_t)i * n + j] /= a[(size_t)i * n + i];
+    return det;
+}
+
+/**
+ * @brief Whether a typed matrix multiplies through the packed float GEMM (__sgemm__).
+ * @param T The element type.
+ * @param ACC The accumulator type.
+ * @return 1 when both are float, otherwise 0; a constant the compiler folds away.
+ * @note This is a private helper macro.
+ */
+#define __TYPED_IS_SGEMM__(T, ACC) _Generic((T)0, float: _Generic((ACC)0, float: 1, default: 0), default: 0)
+
+/**
+ * @brief Defines a typed matrix `name` of elements `T` whose products accumulate in `ACC`.
+ * @param name The name of the generated struct; also the prefix of every generated function.
+ * @param T The element type: any arithmetic type, such as float, double, int32_t or int8_t.
+ * @param ACC The type `name_dot` accumulates in. Use a wider type than `T` for integers (for
+ * example int64_t for int32_t, or int32_t for int8_t) so that partial sums cannot overflow.
+ * `name_dot` converts the final sums back to `T` as by assignment, so an integer sum outside the
+ * range of `T` is implementation-defined (it wraps on common compilers). When products can leave
+ * that range, pair the type with a matrix of `ACC` elements through DEFINE_MATRIX_WIDE and use
+ * `name_dotWide`, which returns the sums unconverted.
+ * @details Generates `name_init`, `name_destroy`, `name_copy`, `name_slice`, `name_join`,
+ * `name_populate`, `name_flatten`, `name_reshape`, `name_traverse`, `name_fill`, `name_random`,
+ * `name_identity`, `name_meshgrid`, `name_get`, `name_set`, `name_getField`, `name_setField`,
+ * `name_swapField`, `name_insertField`, `name_discardField`, `name_transpose`, `name_shuffle`,
+ * `name_scalar`, `name_scalarField`, `name_elementwise`, `name_elementwiseField`, `name_dot`,
+ * `name_determinant` and `name_inverse`, with the same semantics and contiguous, aligned storage
+ * as their counterparts in adt_Matrix.h. `name_random` takes its bounds as doubles and converts
+ * each sample to `T`, and `name_meshgrid` passes the indices to `func` as `T`.
+ * `name_determinant` and `name_inverse` work in double precision and, like factorize(), treat a
+ * pivot smaller than 1e-12 as singular; `name_determinant` returns a double. For integer `T`,
+ * `name_inverse` rounds each element to the nearest integer and returns NULL unless the rounded
+ * matrix is the exact inverse (checked in `ACC`), i.e. unless the matrix is unimodular.
+ * @note When `T` and `ACC` are both float (F32Matrix), `name_dot` runs a packed, cache-blocked
+ * GEMM with an 8 x 8 AVX2/FMA micro-kernel (__sgemm__). When both are double and adt_Matrix.h is
+ * included before this header, it runs gemm() on views of the operands (__dgemm__). Every other
+ * type uses an i-k-j loop blocked by SGEMM_MC, SGEMM_KC and TYPED_GEMM_NC, accumulating in `ACC`.
+ */
+#define DEFINE_MATRIX(name, T, ACC)                                                             \
+    typedef struct                                                                              \
+    {                                                                                           \
+        T **grid;                                                                               \
+        T *data;                                                                                \
+        int rows;                                                                               \
+        int columns;                                                                            \
+        int stride;                                                                             \
+    } name;                                                                                     \
+                                                                                                \
+    name *name##_init(const int rows, const int columns)                                        \
+    {                                                                                           \
+        if (rows <= 0 || columns <= 0)                                                          \
+            return NULL;                                                                        \
+        size_t header = sizeof(name) + (size_t)rows * sizeof(T *);                              \
+        size_t elements = (size_t)rows * (size_t)columns * sizeof(T);                           \
+        char *block = (char *)calloc(1, header + TYPED_MATRIX_ALIGNMENT - 1 + elements);        \
+        if (block == NULL)                                                                      \
+            return NULL;                                                                        \
+        name *matrix = (name *)block;                                                           \
+        matrix->grid = (T **)(block + sizeof(name));                                            \
+        matrix->data = (T *)(((uintptr_t)(block + header) + TYPED_MATRIX_ALIGNMENT - 1) &       \
+                             ~(uintptr_t)(TYPED_MATRIX_ALIGNMENT - 1));                         \
+        matrix->rows = rows;                                                                    \
+        matrix->columns = columns;                                                              \
+        matrix->stride = columns;                                                               \
+        for (int i = 0; i < rows; i++)                                                          \
+            matrix->grid[i] = matrix->data + (size_t)i * columns;                               \
+        return matrix;                                                                          \
+    }                                                                                           \
+                                                                                                \
+    void name##_destroy(name *matrix)                                                           \
+    {                                                                                           \
+        free(matrix);                                                                           \
+    }                                                                                           \
+                                                                                                \
+    name *name##_copy(const name *matrix)                                                       \
+    {                                                                                           \
+        if (matrix == NULL)                                                                     \
+            return NULL;                                                                        \
+        name *copied = name##_init(matrix->rows, matrix->columns);                              \
+        if (copied == NULL)                                                                     \
+            return NULL;                                                                        \
+        for (int i = 0; i < matrix->rows; i++)                                                  \
+            memcpy(copied->grid[i], matrix->grid[i], matrix->columns * sizeof(T));              \
+        return copied;                                                                          \
+    }                                                                                           \
+                                                                                                \
+    name *name##_slice(const name *matrix, const int fromRow, const int toRow,                  \
+                       const int fromColumn, const int toColumn)                                \
+    {                                                                                           \
+        if (matrix == NULL || fromRow < 0 || toRow > matrix->rows || fromRow >= toRow ||        \
+            fromColumn < 0 || toColumn > matrix->columns || fromColumn >= toColumn)             \
+            return NULL;                                                                        \
+        name *sliced = name##_init(toRow - fromRow, toColumn - fromColumn);                     \
+        if (sliced == NULL)                                                                     \
+            return NULL;                                                                        \
+        for (int i = fromRow; i < toRow; i++)                                                   \
+            memcpy(sliced->grid[i - fromRow], matrix->grid[i] + fromColumn,                     \
+                   (toColumn - fromColumn) * sizeof(T));                                        \
+        return sliced;                                                                          \
+    }                                                                                           \
+                                                                                                \
+    name *name##_join(const name *matrix1, const name *matrix2, const bool axis)                \
+    {                                                                                           \
+        if (matrix1 == NULL || matrix2 == NULL)                                                 \
+            return NULL;                                                                        \
+        if (axis ? matrix1->rows != matrix2->rows : matrix1->columns != matrix2->columns)       \
+            return NULL;                                                                        \
+        name *joined = axis ? name##_init(matrix1->rows, matrix1->columns + matrix2->columns)   \
+                            : name##_init(matrix1->rows + matrix2->rows, matrix1->columns);     \
+        if (joined == NULL)                                                                     \
+            return NULL;                                                                        \
+        for (int i = 0; i < matrix1->rows; i++)                                                 \
+            memcpy(joined->grid[i], matrix1->grid[i], matrix1->columns * sizeof(T));            \
+        for (int i = 0; i < matrix2->rows; i++)                                                 \
+            memcpy(axis ? joined->grid[i] + matrix1->columns : joined->grid[matrix1->rows + i], \
+                   matrix2->grid[i], matrix2->columns * sizeof(T));                             \
+        return joined;                                                                          \
+    }                                                                                           \
+                                                                                                \
+    name *name##_populate(const int rows, const int columns, const T *array)                    \
+    {                                                                                           \
+        if (array == NULL)                                                                      \
+            return NULL;                                                                        \
+        name *matrix = name##_init(rows, columns);                                              \
+        if (matrix == NULL)                                                                     \
+            return NULL;                                                                        \
+        for (int i = 0; i < rows; i++)                                                          \
+            memcpy(matrix->grid[i], array + (size_t)i * columns, columns * sizeof(T));          \
+        return matrix;                                                                          \
+    }                                                                                           \
+                                                                                                \
+    T *name##_flatten(const name *matrix)                                                       \
+    {                                                                                           \
+        if (matrix == NULL)                                                                     \
+            return NULL;                                                                        \
+        T *array = (T *)malloc((size_t)matrix->rows * matrix->columns * sizeof(T));             \
+        if (array == NULL)                                                                      \
+            return NULL;                                                                        \
+        for (int i = 0; i < matrix->rows; i++)                                                  \
+            memcpy(array + (size_t)i * matrix->columns, matrix->grid[i],                        \
+                   matrix->columns * sizeof(T));                                                \
+        return array;                                                                           \
+    }                                                                                           \
+                                                                                                \
+    name *name##_reshape(const name *matrix, const int newRows, const int newColumns)           \
+    {                                                                                           \
+        if (matrix == NULL || matrix->rows * matrix->columns != newRows * newColumns)           \
+            return NULL;                                                                        \
+        name *reshaped = name##_init(newRows, newColumns);                                      \
+        if (reshaped == NULL)                                                                   \
+            return NULL;                                                                        \
+        for (int i = 0; i < matrix->rows; i++)                                                  \
+            memcpy(reshaped->data + (size_t)i * matrix->columns, matrix->grid[i],               \
+                   matrix->columns * sizeof(T));                                                \
+        return reshaped;                                                                        \
+    }                                                                                           \
+                                                                                                \
+    void name##_traverse(const name *matrix)                                                    \
+    {                                                                                           \
+        if (matrix == NULL)                                                                     \
+        {                                                                                       \
+            printf("Matrix is empty\n");                                                        \
+            return;                                                                             \
+        }                                                                                       \
+        for (int i = 0; i < matrix->rows; i++)                                                  \
+        {                                                                                       \
+            printf("[ ");                                                                       \
+            for (int j = 0; j < matrix->columns; j++)                                           \
+                if ((T)0.5 == (T)0)                                                             \
+                    printf("%6lld ", (long long)matrix->grid[i][j]);                            \
+                else                                                                            \
+                    printf("%6.2f ", (double)matrix->grid[i][j]);                               \
+            printf("]\n");                                                                      \
+        }                                                                                       \
+        printf("Dim: %dx%d\n", matrix->rows, matrix->columns);                                  \
+    }                                                                                           \
+                                                                                                \
+    name *name##_fill(const int rows, const int columns, const T value)                         \
+    {                                                                                           \
+        name *matrix = name##_init(rows, columns);                                              \
+        if (matrix == NULL)                                                                     \
+            return NULL;                                                                        \
+        for (size_t k = 0; k < (size_t)rows * columns; k++)                                     \
+            matrix->data[k] = value;                                                            \
+        return matrix;                                                                          \
+    }                                                                                           \
+                                                                                                \
+    name *name##_random(const int rows, const int columns, const double min, const double max)  \
+    {                                                                                           \
+        if (min >= max)                                                                         \
+            return NULL;                                                                        \
+        __typedSeeding__();                                                                     \
+        name *matrix = name##_init(rows, columns);                                              \
+        if (matrix == NULL)                                                                     \
+            return NULL;                                                                        \
+        for (int i = 0; i < rows; i++)                                                          \
+            for (int j = 0; j < columns; j++)                                                   \
+                matrix->grid[i][j] = (T)(((double)rand() / RAND_MAX) * (max - min) + min);      \
+        return matrix;                                                                          \
+    }                                                                                           \
+                                                                                                \
+    name *name##_identity(const int dimensions)                                                 \
+    {                                                                                           \
+        name *matrix = name##_init(dimensions, dimensions);                                     \
+        if (matrix == NULL)                                                                     \
+            return NULL;                                                                        \
+        for (int i = 0; i < dimensions; i++)                                                    \
+            matrix->grid[i][i] = (T)1;                                                          \
+        return matrix;                                                                          \
+    }                                                                                           \
+                                                                                                \
+    name *name##_meshgrid(const int rows, const int columns, T (*func)(T, T))                   \
+    {                                                                                           \
+        if (func == NULL)                                                                       \
+            return NULL;                                                                        \
+        name *matrix = name##_init(rows, columns);                                              \
+        if (matrix == NULL)                                                                     \
+            return NULL;                                                                        \
+        for (int i = 0; i < rows; i++)                                                          \
+            for (int j = 0; j < columns; j++)                                                   \
+                matrix->grid[i][j] = func((T)i, (T)j);                                          \
+        return matrix;                                                                          \
+    }                                                                                           \
+                                                                                                \
+    T name##_get(const name *matrix, const int row, const int column)                           \
+    {                                                                                           \
+        if (matrix == NULL || row < 0 || row >= matrix->rows || column < 0 ||                   \
+            column >= matrix->columns)                                                          \
+            return (T)-1;                                                                       \
+        return matrix->grid[row][column];                                                       \
+    }                                                                                           \
+                                                                                                \
+    void name##_set(name *matrix, const int row, const int column, const T value)               \
+    {                                                                                           \
+        if (matrix == NULL || row < 0 || row >= matrix->rows || column < 0 ||                   \
+            column >= matrix->columns)                                                          \
+            return;                                                                             \
+        matrix->grid[row][column] = value;                                                      \
+    }                                                                                           \
+                                                                                                \
+    T *name##_getField(const name *matrix, const int index, const bool axis)                    \
+    {                                                                                           \
+        if (matrix == NULL || index < 0 || index >= (axis ? matrix->columns : matrix->rows))    \
+            return NULL;                                                                        \
+        int length = axis ? matrix->rows : matrix->columns;                                     \
+        T *array = (T *)malloc(length * sizeof(T));                                             \
+        if (array == NULL)                                                                      \
+            return NULL;                                                                        \
+        for (int k = 0; k < length; k++)                                                        \
+            array[k] = axis ? matrix->grid[k][index] : matrix->grid[index][k];                  \
+        return array;                                                                           \
+    }                                                                                           \
+                                                                                                \
+    void name##_setField(name *matrix, const int index, const bool axis, const T *array)        \
+    {                                                                                           \
+        if (matrix == NULL || array == NULL || index < 0 ||                                     \
+            index >= (axis ? matrix->columns : matrix->rows))                                   \
+            return;                                                                             \
+        int length = axis ? matrix->rows : matrix->columns;                                     \
+        for (int k = 0; k < length; k++)                                                        \
+            if (axis)                                                                           \
+                matrix->grid[k][index] = array[k];                                              \
+            else                                                                                \
+                matrix->grid[index][k] = array[k];                                              \
+    }                                                                                           \
+                                                                                                \
+    void name##_swapField(name *matrix, const int index1, const int index2, const bool axis)    \
+    {                                                                                           \
+        if (matrix == NULL)                                                                     \
+            return;                                                                             \
+        int limit = axis ? matrix->columns : matrix->rows;                                      \
+        if (index1 < 0 || index1 >= limit || index2 < 0 || index2 >= limit)                     \
+            return;                                                                             \
+        int length = axis ? matrix->rows : matrix->columns;                                     \
+        for (int k = 0; k < length; k++)                                                        \
+        {                                                                                       \
+            T *first = axis ? &matrix->grid[k][index1] : &matrix->grid[index1][k];              \
+            T *second = axis ? &matrix->grid[k][index2] : &matrix->grid[index2][k];             \
+            T temp = *first;                                                                    \
+            *first = *second;                                                                   \
+            *second = temp;                                                                     \
+        }                                                                                       \
+    }                                                                                           \
+                                                                                                \
+    name *name##_insertField(const name *matrix, int index, const bool axis, const T *array)    \
+    {                                                                                           \
+        if (matrix == NULL || array == NULL)                                                    \
+            return NULL;                                                                        \
+        int limit = axis ? matrix->columns : matrix->rows;                                      \
+        index = index < 0 ? 0 : (index > limit ? limit : index);                                \
+        name *expanded = axis ? name##_init(matrix->rows, matrix->columns + 1)                  \
+                              : name##_init(matrix->rows + 1, matrix->columns);                 \
+        if (expanded == NULL)                                                                   \
+            return NULL;                                                                        \
+        if (axis)                                                                               \
+            for (int i = 0; i < matrix->rows; i++)                                              \
+            {                                                                                   \
+                memcpy(expanded->grid[i], matrix->grid[i], index * sizeof(T));                  \
+                expanded->grid[i][index] = array[i];                                            \
+                memcpy(expanded->grid[i] + index + 1, matrix->grid[i] + index,                  \
+                       (matrix->columns - index) * sizeof(T));                                  \
+            }                                                                                   \
+        else                                                                                    \
+            for (int i = 0; i < expanded->rows; i++)                                            \
+                memcpy(expanded->grid[i], i == index ? array : matrix->grid[i < index ? i : i - 1], \
+                       matrix->columns * sizeof(T));                                            \
+        return expanded;                                                                        \
+    }                                                                                           \
+                                                                                                \
+    name *name##_discardField(const name *matrix, int index, const bool axis)                   \
+    {                                                                                           \
+        if (matrix == NULL)                                                                     \
+            return NULL;                                                                        \
+        int limit = axis ? matrix->columns : matrix->rows;                                      \
+        index = index < 0 ? 0 : (index >= limit ? limit - 1 : index);                           \
+        name *reduced = axis ? name##_init(matrix->rows, matrix->columns - 1)                   \
+                             : name##_init(matrix->rows - 1, matrix->columns);                  \
+        if (reduced == NULL)                                                                    \
+            return NULL;                                                                        \
+        if (axis)                                                                               \
+            for (int i = 0; i < matrix->rows; i++)                                              \
+            {                                                                                   \
+                memcpy(reduced->grid[i], matrix->grid[i], index * sizeof(T));                   \
+                memcpy(reduced->grid[i] + index, matrix->grid[i] + index + 1,                   \
+                       (matrix->columns - index - 1) * sizeof(T));                              \
+            }                                                                                   \
+        else                                                                                    \
+            for (int i = 0; i < reduced->rows; i++)                                             \
+                memcpy(reduced->grid[i], matrix->grid[i < index ? i : i + 1], matrix->columns * sizeof(T)); \
+        return reduced;                                                                         \
+    }                                                                                           \
+                                                                                                \
+    name *name##_transpose(const name *matrix)                                                  \
+    {                                                                                           \
+        if (matrix == NULL)                                                                     \
+            return NULL;                                                                        \
+        name *transposed = name##_init(matrix->columns, matrix->rows);                          \
+        if (transposed == NULL)                                                                 \
+            return NULL;                                                                        \
+        for (int i = 0; i < matrix->rows; i++)                                                  \
+            for (int j = 0; j < matrix->columns; j++)                                           \
+                transposed->grid[j][i] = matrix->grid[i][j];                                    \
+        return transposed;                                                                      \
+    }                                                                                           \
+                                                                                                \
+    name *name##_shuffle(const name *matrix)                                                    \
+    {                                                                                           \
+        name *shuffled = name##_copy(matrix);                                                   \
+        if (shuffled == NULL)                                                                   \
+            return NULL;                                                                        \
+        __typedSeeding__();                                                                     \
+        for (int i = shuffled->rows * shuffled->columns - 1; i > 0; i--)                        \
+        {                                                                                       \
+            int j = rand() % (i + 1);                                                           \
+            T temp = shuffled->data[i];                                                         \
+            shuffled->data[i] = shuffled->data[j];                                              \
+            shuffled->data[j] = temp;                                                           \
+        }                                                                                       \
+        return shuffled;                                                                        \
+    }                                                                                           \
+                                                                                                \
+    name *name##_scalar(const name *matrix, T (*func)(T))                                       \
+    {                                                                                           \
+        if (matrix == NULL || func == NULL)                                                     \
+            return NULL;                                                                        \
+        name *result = name##_init(matrix->rows, matrix->columns);                              \
+        if (result == NULL)                                                                     \
+            return NULL;                                                                        \
+        for (int i = 0; i < matrix->rows; i++)                                                  \
+            for (int j = 0; j < matrix->columns; j++)                                           \
+                result->grid[i][j] = func(matrix->grid[i][j]);                                  \
+        return result;                                                                          \
+    }                                                                                           \
+                                                                                                \
+    T *name##_scalarField(const name *matrix, const int index, const bool axis, T (*func)(T))   \
+    {                                                                                           \
+        if (matrix == NULL || func == NULL)                                                     \
+            return NULL;                                                                        \
+        T *array = name##_getField(matrix, index, axis);                                        \
+        if (array == NULL)                                                                      \
+            return NULL;                                                                        \
+        for (int k = 0, length = axis ? matrix->rows : matrix->columns; k < length; k++)        \
+            array[k] = func(array[k]);                                                          \
+        return array;                                                                           \
+    }                                                                                           \
+                                                                                                \
+    name *name##_elementwise(const name *matrix1, const name *matrix2, T (*func)(T, T))         \
+    {                                                                                           \
+        if (matrix1 == NULL || matrix2 == NULL || func == NULL ||                               \
+            matrix1->rows != matrix2->rows || matrix1->columns != matrix2->columns)             \
+            return NULL;                                                                        \
+        name *result = name##_init(matrix1->rows, matrix1->columns);                            \
+        if (result == NULL)                                                                     \
+            return NULL;                                                                        \
+        for (int i = 0; i < result->rows; i++)                                                  \
+            for (int j = 0; j < result->columns; j++)                                           \
+                result->grid[i][j] = func(matrix1->grid[i][j], matrix2->grid[i][j]);            \
+        return result;                                                                          \
+    }                                                                                           \
+                                                                                                \
+    T *name##_elementwiseField(const name *matrix, const int index, const bool axis,            \
+                               const T *array, T (*func)(T, T))                                 \
+    {                                                                                           \
+        if (matrix == NULL || array == NULL || func == NULL)                                    \
+            return NULL;                                                                        \
+        T *result = name##_getField(matrix, index, axis);                                       \
+        if (result == NULL)                                                                     \
+            return NULL;                                                                        \
+        for (int k = 0, length = axis ? matrix->rows : matrix->columns; k < length; k++)        \
+            result[k] = func(result[k], array[k]);                                              \
+        return result;                                                                          \
+    }                                                                                           \
+                                                                                                \
+    bool __##name##_blockedDot__(const name *matrix1, const name *matrix2, T *narrow, ACC *wide, \
+                                 const int stride)                                              \
+    {                                                                                           \
+        int m = matrix1->rows, n = matrix2->columns, k = matrix1->columns;                      \
+        int width = n < TYPED_GEMM_NC ? n : TYPED_GEMM_NC;                                      \
+        ACC *accumulator = (ACC *)malloc((size_t)SGEMM_MC * width * sizeof(ACC));               \
+        if (accumulator == NULL)                                                                \
+            return false;                                                                       \
+        /* Blocked like __sgemmBlock__: a KC x NC block of B stays in cache while MC rows */    \
+        /* of A stream past it, and each MC x NC block of C accumulates in ACC until done. */   \
+        for (int ic = 0; ic < m; ic += SGEMM_MC)                                                \
+        {                                                                                       \
+            int mc = m - ic < SGEMM_MC ? m - ic : SGEMM_MC;                                     \
+            for (int jc = 0; jc < n; jc += TYPED_GEMM_NC)                                       \
+            {                                                                                   \
+                int nc = n - jc < TYPED_GEMM_NC ? n - jc : TYPED_GEMM_NC;                       \
+                for (size_t q = 0; q < (size_t)mc * nc; q++)                                    \
+                    accumulator[q] = (ACC)0;                                                    \
+                for (int pc = 0; pc < k; pc += SGEMM_KC)                                        \
+                {                                                                               \
+                    int kc = k - pc < SGEMM_KC ? k - pc : SGEMM_KC;                             \
+                    for (int i = 0; i < mc; i++)                                                \
+                    {                                                                           \
+                        ACC *row = accumulator + (size_t)i * nc;                                \
+                        const T *left = matrix1->grid[ic + i] + pc;                             \
+                        for (int p = 0; p < kc; p++)                                            \
+                        {                                                                       \
+                            ACC factor = (ACC)left[p];                                          \
+                            const T *source = matrix2->grid[pc + p] + jc;                       \
+                            for (int j = 0; j < nc; j++)                                        \
+                                row[j] += factor * (ACC)source[j];                              \
+                        }                                                                       \
+                    }                                                                           \
+                }                                                                               \
+                for (int i = 0; i < mc; i++)                                                    \
+                {                                                                               \
+                    size_t offset = (size_t)(ic + i) * stride + jc;                             \
+                    const ACC *row = accumulator + (size_t)i * nc;                              \
+                    if (wide != NULL)                                                           \
+                        memcpy(wide + offset, row, nc * sizeof(ACC));                           \
+                    else                                                                        \
+                        for (int j = 0; j < nc; j++)                                            \
+                            narrow[offset + j] = (T)row[j];                                     \
+                }                                                                               \
+            }                                                                                   \
+        }                                                                                       \
+        free(accumulator);                                                                      \
+        return true;                                                                            \
+    }                                                                                           \
+                                                                                                \
+    name *name##_dot(const name *matrix1, const name *matrix2)                                  \
+    {                                                                                           \
+        if (matrix1 == NULL || matrix2 == NULL || matrix1->columns != matrix2->rows)            \
+            return NULL;                                                                        \
+        int m = matrix1->rows, n = matrix2->columns, k = matrix1->columns;                      \
+        name *result = name##_init(m, n);                                                       \
+        if (result == NULL)                                                                     \
+            return NULL;                                                                        \
+        if (__TYPED_IS_SGEMM__(T, ACC) && (double)m * n * k > TYPED_GEMM_SMALL_WORK)            \
+        {                                                                                       \
+            if (__sgemm__(m, n, k, (const float *)matrix1->data, matrix1->stride,               \
+                          (const float *)matrix2->data, matrix2->stride,                        \
+                          (float *)result->data, result->stride))                               \
+                return result;                                                                  \
+            name##_destroy(result);                                                             \
+            return NULL;                                                                        \
+        }                                                                                       \
+        if (__TYPED_IS_DGEMM__(T, ACC))                                                         \
+        {                                                                                       \
+            if (__dgemm__(m, n, k, (const double *)matrix1->data, matrix1->stride,              \
+                          (const double *)matrix2->data, matrix2->stride,                       \
+                          (double *)result->data, result->stride))                              \
+                return result;                                                                  \
+            name##_destroy(result);                                                             \
+            return NULL;                                                                        \
+        }                                                                                       \
+        if (!__##name##_blockedDot__(matrix1, matrix2, result->data, NULL, result->stride))     \
+        {                                                                                       \
+            name##_destroy(result);                                                             \
+            return NULL;                                                                        \
+        }                                                                                       \
+        return result;                                                                          \
+    }                                                                                           \
+                                                                                                \
+    double *__##name##_toDoubles__(const name *matrix)                                          \
+    {                                                                                           \
+        double *copy = (double *)malloc((size_t)matrix->rows * matrix->columns * sizeof(double)); \
+        if (copy == NULL)                                                                       \
+            return NULL;                                                                        \
+        for (int i = 0; i < matrix->rows; i++)                                                  \
+            for (int j = 0; j < matrix->columns; j++)                                           \
+                copy[(size_t)i * matrix->columns + j] = (double)matrix->grid[i][j];             \
+        return copy;                                                                            \
+    }                                                                                           \
+                                                                                                \
+    double name##_determinant(const name *matrix)                                               \
+    {                                                                                           \
+        if (matrix == NULL || matrix->rows != matrix->columns)                                  \
+            return 0.0;                                                                         \
+        double *work = __##name##_toDoubles__(matrix);                                          \
+        if (work == NULL)                                                                       \
+            return 0.0;                                                                         \
+        double det = __typedEliminate__(work, NULL, matrix->rows);                              \
+        free(work);                                                                             \
+        return det;                                                                             \
+    }                                                                                           \
+                                                                                                \
+    name *name##_inverse(const name *matrix)                                                    \
+    {                                                                                           \
+        if (matrix == NULL || matrix->rows != matrix->columns)                                  \
+            return NULL;                                                                        \
+        int n = matrix->rows;                                                                   \
+        double *work = __##name##_toDoubles__(matrix);                                          \
+        double *inverse = (double *)calloc((size_t)n * n, sizeof(double));                      \
+        name *result = NULL;                                                                    \
+        if (work != NULL && inverse != NULL)                                                    \
+        {                                                                                       \
+            for (int i = 0; i < n; i++)                                                         \
+                inverse[(size_t)i * n + i] = 1.0;                                               \
+            if (__typedEliminate__(work, inverse, n) != 0.0 && (result = name##_init(n, n)) != NULL) \
+                for (size_t k = 0; k < (size_t)n * n; k++)                                      \
+                    result->data[k] = (T)0.5 == (T)0 ? (T)floor(inverse[k] + 0.5) : (T)inverse[k]; \
+        }                                                                                       \
+        free(work);                                                                             \
+        free(inverse);                                                                          \
+        /* An integer inverse is only returned if it is exact: A times it must be the identity. */ \
+        for (int i = 0; result != NULL && (T)0.5 == (T)0 && i < n; i++)                         \
+            for (int j = 0; result != NULL && j < n; j++)                                       \
+            {                                                                                   \
+                ACC sum = (ACC)0;                                                               \
+                for (int k = 0; k < n; k++)                                                     \
+                    sum += (ACC)matrix->grid[i][k] * (ACC)result->grid[k][j];                   \
+                if (sum != (ACC)(i == j))                                                       \
+                {                                                                               \
+                    name##_destroy(result);                                                     \
+                    result = NULL;                                                              \
+                }                                                                               \
+            }                                                                                   \
+        return result;                                                                          \
+    }
+
+/**
+ * @brief Defines `wide *name_dotWide(const name *matrix1, const name *matrix2)`, which returns the
+ * product of two typed matrices without converting the sums back to the element type.
+ * @param name The typed matrix.
+ * @param wide A typed matrix whose element type is the accumulator type `ACC` of `name`, e.g.
+ * I64Matrix for I32Matrix.
+ * @note Runs the same blocked loop as `name_dot`, but copies each finished ACC block straight
+ * into the result, so integer products that do not fit in `T` are exact as long as they fit in
+ * `ACC`.
+ */
+#define DEFINE_MATRIX_WIDE(name, wide)                                                          \
+    wide *name##_dotWide(const name *matrix1, const name *matrix2)                              \
+    {                                                                                           \
+        if (matrix1 == NULL || matrix2 == NULL || matrix1->columns != matrix2->rows)            \
+            return NULL;                                                                        \
+        wide *result = wide##_init(matrix1->rows, matrix2->columns);                            \
+        if (result == NULL)                                                                     \
+            return NULL;                                                                        \
+        if (!__##name##_blockedDot__(matrix1, matrix2, NULL, result->data, result->stride))     \
+        {                                                                                       \
+            wide##_destroy(result);                                                             \
+            return NULL;                                                                        \
+        }                                                                                       \
+        return result;                                                                          \
+    }
+
+/**
+ * @brief Defines `to *from_to<to>(const from *matrix)`, which converts between two typed matrices.
+ * @param from The source typed matrix.
+ * @param to The target typed matrix.
+ * @note Elements are converted as by assignment in C: floating-point values are truncated toward
+ * zero when the target is an integer type, and values outside its range are undefined.
+ */
+#define DEFINE_MATRIX_CONVERSION(from, to)                                                      \
+    to *from##_to##to(const from *matrix)                                                       \
+    {                                                                                           \
+        if (matrix == NULL)                                                                     \
+            return NULL;                                                                        \
+        to *converted = to##_init(matrix->rows, matrix->columns);                               \
+        if (converted == NULL)                                                                  \
+            return NULL;                                                                        \
+        for (int i = 0; i < matrix->rows; i++)                                                  \
+            for (int j = 0; j < matrix->columns; j++)                                           \
+                converted->grid[i][j] = matrix->grid[i][j];                                     \
+        return converted;                                                                       \
+    }
+
+/**
+ * @brief Defines `name_fromMatrix` and `name_toMatrix`, which convert between a typed matrix and the `Matrix` of adt_Matrix.h.
+ * @param name The typed matrix.
+ * @note Only available when adt_Matrix.h is included before this header.
+ */
+#define DEFINE_MATRIX_INTEROP(name)                                                             \
+    name *name##_fromMatrix(const Matrix *matrix)                                               \
+    {                                                                                           \
+        if (matrix == NULL)                                                                     \
+            return NULL;                                                                        \
+        name *converted = name##_init(matrix->rows, matrix->columns);                           \
+        if (converted == NULL)                                                                  \
+            return NULL;                                                                        \
+        for (int i = 0; i < matrix->rows; i++)                                                  \
+            for (int j = 0; j < matrix->columns; j++)                                           \
+                converted->grid[i][j] = matrix->grid[i][j];                                     \
+        return converted;                                                                       \
+    }                                                                                           \
+                                                                                                \
+    Matrix *name##_toMatrix(const name *matrix)                                                 \
+    {                                                                                           \
+        if (matrix == NULL)                                                                     \
+            return NULL;                                                                        \
+        Matrix *converted = init(matrix->rows, matrix->columns);                                \
+        if (converted == NULL)                                                                  \
+            return NULL;                                                                        \
+        for (int i = 0; i < matrix->rows; i++)                                                  \
+            for (int j = 0; j < matrix->columns; j++)                                           \
+                converted->grid[i][j] = matrix->grid[i][j];                                     \
+        return converted;                                                                       \
+    }
+
+DEFINE_MATRIX(F32Matrix, float, float)
+DEFINE_MATRIX(F64Matrix, double, double)
+DEFINE_MATRIX(I32Matrix, int32_t, int64_t)
+DEFINE_MATRIX(I64Matrix, int64_t, int64_t)
+
+DEFINE_MATRIX_WIDE(I32Matrix, I64Matrix)
+
+DEFINE_MATRIX_CONVERSION(F32Matrix, F64Matrix)
+DEFINE_MATRIX_CONVERSION(F32Matrix, I32Matrix)
+DEFINE_MATRIX_CONVERSION(F64Matrix, F32Matrix)
+DEFINE_MATRIX_CONVERSION(F64Matrix, I32Matrix)
+DEFINE_MATRIX_CONVERSION(I32Matrix, F32Matrix)
+DEFINE_MATRIX_CONVERSION(I32Matrix, F64Matrix)
+DEFINE_MATRIX_CONVERSION(I32Matrix, I64Matrix)
+DEFINE_MATRIX_CONVERSION(I64Matrix, I32Matrix)
+
+#ifdef MATRIX_H
+DEFINE_MATRIX_INTEROP(F32Matrix)
+DEFINE_MATRIX_INTEROP(F64Matrix)
+DEFINE_MATRIX_INTEROP(I32Matrix)
+DEFINE_MATRIX_INTEROP(I64Matrix)
+#endif
+
+#endif // TYPED_MATRIX_H
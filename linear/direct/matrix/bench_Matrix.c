@@ -0,0 +1,975 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include "adt_Matrix.h"
+#include "adt_TypedMatrix.h"
+
+#define GREEN "\x1b[32m"
+#define RED "\x1b[31m"
+#define YELLOW "\x1b[33m"
+#define BLUE "\x1b[34m"
+#define RESET "\x1b[0m"
+
+// Function prototypes for benchmark groups
+void benchLayout(const int maxSize);
+void benchGemm(const int maxSize);
+void benchThreads(const int maxSize);
+void benchLu(const int maxSize);
+void benchSparse(const int maxSize);
+void benchExpr(const int maxSize);
+void benchTyped(const int maxSize);
+void benchLoad(const int maxSize);
+void benchTranspose(const int maxSize);
+void benchStrassen(const int maxSize);
+void benchBatch(const int maxSize);
+void benchDisk(const int maxSize);
+void benchArena(const int maxSize);
+void benchAppend(const int maxSize);
+
+// Helper functions for benchmarking
+double wallTime()
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+bool areEqual(const Matrix *m1, const Matrix *m2, const double tolerance)
+{
+    if (m1 == NULL || m2 == NULL || m1->rows != m2->rows || m1->columns != m2->columns)
+        return false;
+    for (int i = 0; i < m1->rows; i++)
+        for (int j = 0; j < m1->columns; j++)
+            if (fabs(m1->grid[i][j] - m2->grid[i][j]) > tolerance * (1.0 + fabs(m2->grid[i][j])))
+                return false;
+    return true;
+}
+
+void printResult(const char *name, const int size, const double seconds, const bool correct)
+{
+    printf("  %-28s n=%-6d %10.4f s  %s\n", name, size, seconds, correct ? GREEN "ok" RESET : RED "WRONG" RESET);
+}
+
+void printFlops(const char *name, const int size, const double seconds, const double flops, const bool correct)
+{
+    printf("  %-28s n=%-6d %10.4f s %8.2f GFLOP/s  %s\n", name, size, seconds, flops / seconds / 1e9,
+           correct ? GREEN "ok" RESET : RED "WRONG" RESET);
+}
+
+void printBandwidth(const char *name, const int size, const double seconds, const double bytes, const bool correct)
+{
+    printf("  %-28s n=%-6d %10.4f s %8.2f GB/s  %s\n", name, size, seconds, bytes / seconds / 1e9,
+           correct ? GREEN "ok" RESET : RED "WRONG" RESET);
+}
+
+// ========================================
+// Baselines: the original implementations
+// ========================================
+double **baselineInit(const int rows, const int columns)
+{
+    double **grid = (double **)malloc(rows * sizeof(double *));
+    for (int i = 0; i < rows; i++)
+        grid[i] = (double *)calloc(columns, sizeof(double));
+    return grid;
+}
+
+void baselineDestroy(double **grid, const int rows)
+{
+    for (int i = 0; i < rows; i++)
+        free(grid[i]);
+    free(grid);
+}
+
+double **baselineCopy(double **grid, const int rows, const int columns)
+{
+    double **copied = baselineInit(rows, columns);
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < columns; j++)
+            copied[i][j] = grid[i][j];
+    return copied;
+}
+
+double **baselineReshape(double **grid, const int rows, const int columns, const int newRows, const int newColumns)
+{
+    double **reshaped = baselineInit(newRows, newColumns);
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < columns; j++)
+        {
+            int index = i * columns + j;
+            reshaped[index / newColumns][index % newColumns] = grid[i][j];
+        }
+    return reshaped;
+}
+
+double **baselineTranspose(double **grid, const int rows, const int columns)
+{
+    double **transposed = baselineInit(columns, rows);
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < columns; j++)
+            transposed[j][i] = grid[i][j];
+    return transposed;
+}
+
+double **baselineDot(double **grid1, double **grid2, const int rows, const int inner, const int columns)
+{
+    double **product = baselineInit(rows, columns);
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < columns; j++)
+            for (int k = 0; k < inner; k++)
+                product[i][j] += grid1[i][k] * grid2[k][j];
+    return product;
+}
+
+double baselineDeterminant(double **grid, const int n)
+{
+    double **a = baselineCopy(grid, n, n);
+    double det = 1.0;
+    for (int i = 0; i < n; i++)
+    {
+        int pivot = i;
+        for (int j = i + 1; j < n; j++)
+            if (fabs(a[j][i]) > fabs(a[pivot][i]))
+                pivot = j;
+        if (pivot != i)
+        {
+            double *tmp = a[i];
+            a[i] = a[pivot];
+            a[pivot] = tmp;
+            det = -det;
+        }
+        for (int j = i + 1; j < n; j++)
+        {
+            double factor = a[j][i] / a[i][i];
+            for (int k = i; k < n; k++)
+                a[j][k] -= factor * a[i][k];
+        }
+        det *= a[i][i];
+    }
+    baselineDestroy(a, n);
+    return det;
+}
+
+// Main function to execute benchmarks
+// Usage: ./bench_Matrix [benchmark|all] [maxSize]
+int main(int argc, char **argv)
+{
+    const char *which = argc > 1 ? argv[1] : "all";
+    int maxSize = argc > 2 ? atoi(argv[2]) : 2048;
+    if (maxSize < 64)
+        maxSize = 64;
+
+    printf(BLUE "========================================\n" RESET);
+    printf(BLUE "       Running Matrix ADT Benchmarks\n" RESET);
+    printf(BLUE "========================================\n\n" RESET);
+
+    if (!strcmp(which, "all") || !strcmp(which, "layout"))
+        benchLayout(maxSize);
+    if (!strcmp(which, "all") || !strcmp(which, "gemm"))
+        benchGemm(maxSize);
+    if (!strcmp(which, "all") || !strcmp(which, "threads"))
+        benchThreads(maxSize);
+    if (!strcmp(which, "all") || !strcmp(which, "lu"))
+        benchLu(maxSize);
+    if (!strcmp(which, "all") || !strcmp(which, "sparse"))
+        benchSparse(maxSize);
+    if (!strcmp(which, "all") || !strcmp(which, "expr"))
+        benchExpr(maxSize);
+    if (!strcmp(which, "all") || !strcmp(which, "typed"))
+        benchTyped(maxSize);
+    if (!strcmp(which, "all") || !strcmp(which, "load"))
+        benchLoad(maxSize);
+    if (!strcmp(which, "all") || !strcmp(which, "transpose"))
+        benchTranspose(maxSize);
+    if (!strcmp(which, "all") || !strcmp(which, "strassen"))
+        benchStrassen(maxSize);
+    if (!strcmp(which, "all") || !strcmp(which, "batch"))
+        benchBatch(maxSize);
+    if (!strcmp(which, "all") || !strcmp(which, "disk"))
+        benchDisk(maxSize);
+    if (!strcmp(which, "all") || !strcmp(which, "arena"))
+        benchArena(maxSize);
+    if (!strcmp(which, "all") || !strcmp(which, "append"))
+        benchAppend(maxSize);
+
+    return 0;
+}
+
+// ========================================
+// Benchmark: Contiguous Layout and Views
+// ========================================
+void benchLayout(const int maxSize)
+{
+    printf(YELLOW "--- layout: row-per-malloc baseline vs contiguous storage and views ---\n" RESET);
+    for (int n = 256; n <= maxSize; n *= 2)
+    {
+        const int repeats = 4;
+        const double bytes = 2.0 * repeats * n * (double)n * sizeof(double);
+        Matrix *m = random(n, n, -1.0, 1.0);
+        double **grid = baselineCopy(m->grid, n, n);
+
+        double start = wallTime();
+        for (int r = 0; r < repeats; r++)
+            baselineDestroy(baselineCopy(grid, n, n), n);
+        printBandwidth("baseline copy", n, wallTime() - start, bytes, true);
+
+        start = wallTime();
+        Matrix *copied = NULL;
+        for (int r = 0; r < repeats; r++)
+        {
+            destroy(copied);
+            copied = copy(m);
+        }
+        printBandwidth("copy", n, wallTime() - start, bytes, areEqual(copied, m, 0.0));
+
+        start = wallTime();
+        for (int r = 0; r < repeats; r++)
+            baselineDestroy(baselineReshape(grid, n, n, n / 2, 2 * n), n / 2);
+        printBandwidth("baseline reshape", n, wallTime() - start, bytes, true);
+
+        start = wallTime();
+        Matrix *reshaped = NULL;
+        for (int r = 0; r < repeats; r++)
+        {
+            destroy(reshaped);
+            reshaped = reshape(m, n / 2, 2 * n);
+        }
+        printBandwidth("reshape", n, wallTime() - start, bytes, reshaped->grid[0][n] == m->grid[1][0]);
+
+        start = wallTime();
+        Matrix *sliced = slice(m, n / 4, 3 * n / 4, n / 4, 3 * n / 4);
+        printResult("slice (copy)", n, wallTime() - start, true);
+
+        start = wallTime();
+        MatrixView window = sliceView(view(m), n / 4, 3 * n / 4, n / 4, 3 * n / 4);
+        printResult("sliceView (zero-copy)", n, wallTime() - start, viewGet(window, 1, 1) == sliced->grid[1][1]);
+
+        destroy(m);
+        destroy(copied);
+        destroy(reshaped);
+        destroy(sliced);
+        baselineDestroy(grid, n);
+    }
+    printf("----------------------------------------\n");
+}
+
+// ========================================
+// Benchmark: Blocked SIMD Matrix Multiply
+// ========================================
+void benchGemm(const int maxSize)
+{
+    printf(YELLOW "--- gemm: naive i-j-k baseline vs packed, blocked dot() (%s kernel) ---\n" RESET,
+           __simdLevel__() ? "AVX2/FMA" : "scalar");
+    for (int n = 64; n <= maxSize; n *= 2)
+    {
+        const double flops = 2.0 * n * (double)n * n;
+        Matrix *a = random(n, n, -1.0, 1.0);
+        Matrix *b = random(n, n, -1.0, 1.0);
+
+        Matrix *expected = NULL;
+        if (n <= 512)
+        {
+            double start = wallTime();
+            double **grid = baselineDot(a->grid, b->grid, n, n, n);
+            printFlops("baseline dot", n, wallTime() - start, flops, true);
+            expected = init(n, n);
+            for (int i = 0; i < n; i++)
+                memcpy(expected->grid[i], grid[i], n * sizeof(double));
+            baselineDestroy(grid, n);
+        }
+
+        double start = wallTime();
+        Matrix *product = dot(a, b);
+        printFlops("dot", n, wallTime() - start, flops, expected == NULL || areEqual(product, expected, 1e-9));
+
+        destroy(a);
+        destroy(b);
+        destroy(expected);
+        destroy(product);
+    }
+    printf("----------------------------------------\n");
+}
+
+// ========================================
+// Benchmark: Thread Pool Scaling
+// ========================================
+double benchAdd(double a, double b)
+{
+    return a + b;
+}
+
+void benchThreads(const int maxSize)
+{
+    const int processors = getThreads();
+    printf(YELLOW "--- threads: 1 thread vs all %d online processors ---\n" RESET, processors);
+    for (int n = 256; n <= maxSize; n *= 2)
+    {
+        Matrix *a = random(n, n, -1.0, 1.0);
+        Matrix *b = random(n, n, -1.0, 1.0);
+        for (int i = 0; i < n; i++)
+            a->grid[i][i] += n;
+        Matrix *serial[3];
+        const char *names[2] = {"1 thread", "pool"};
+
+        for (int run = 0; run < 2; run++)
+        {
+            setThreads(run == 0 ? 1 : processors);
+            char name[64];
+
+            double start = wallTime();
+            Matrix *product = dot(a, b);
+            snprintf(name, sizeof(name), "dot (%s)", names[run]);
+            printFlops(name, n, wallTime() - start, 2.0 * n * (double)n * n, run == 0 || areEqual(product, serial[0], 1e-9));
+
+            start = wallTime();
+            Matrix *sum = elementwise(a, b, benchAdd);
+            snprintf(name, sizeof(name), "elementwise (%s)", names[run]);
+            printBandwidth(name, n, wallTime() - start, 3.0 * n * (double)n * sizeof(double), run == 0 || areEqual(sum, serial[1], 0.0));
+
+            start = wallTime();
+            Matrix *inverted = inverse(a);
+            snprintf(name, sizeof(name), "inverse (%s)", names[run]);
+            printResult(name, n, wallTime() - start, run == 0 || areEqual(inverted, serial[2], 1e-9));
+
+            if (run == 0)
+            {
+                serial[0] = product;
+                serial[1] = sum;
+                serial[2] = inverted;
+            }
+            else
+            {
+                destroy(product);
+                destroy(sum);
+                destroy(inverted);
+            }
+        }
+
+        for (int i = 0; i < 3; i++)
+            destroy(serial[i]);
+        destroy(a);
+        destroy(b);
+    }
+    setThreads(0);
+    printf("----------------------------------------\n");
+}
+
+// ========================================
+// Benchmark: Blocked LU Factorization
+// ========================================
+void benchLu(const int maxSize)
+{
+    printf(YELLOW "--- lu: unblocked elimination baseline vs blocked factorize(), and solving via inverse() vs solveMany() ---\n" RESET);
+    for (int n = 256; n <= maxSize; n *= 2)
+    {
+        const int systems = 16;
+        Matrix *a = random(n, n, -1.0 / n, 1.0 / n);
+        for (int i = 0; i < n; i++)
+            a->grid[i][i] += 1.0;
+        Matrix *b = random(n, systems, -1.0, 1.0);
+
+        double start = wallTime();
+        double expected = baselineDeterminant(a->grid, n);
+        printResult("baseline determinant", n, wallTime() - start, true);
+
+        start = wallTime();
+        LUFactor *factor = factorize(a);
+        double seconds = wallTime() - start;
+        double det = factorDeterminant(factor);
+        printFlops("factorize", n, seconds, 2.0 / 3.0 * n * (double)n * n, fabs(det - expected) <= 1e-9 * fabs(expected));
+
+        start = wallTime();
+        Matrix *inv = inverse(a);
+        Matrix *viaInverse = dot(inv, b);
+        printResult("inverse + dot", n, wallTime() - start, true);
+
+        start = wallTime();
+        Matrix *viaFactor = solveMany(factor, b);
+        printResult("solveMany (reused factor)", n, wallTime() - start, areEqual(viaFactor, viaInverse, 1e-6));
+
+        destroyFactor(factor);
+        destroy(a);
+        destroy(b);
+        destroy(inv);
+        destroy(viaInverse);
+        destroy(viaFactor);
+    }
+    printf("----------------------------------------\n");
+}
+
+// ========================================
+// Benchmark: Sparse Matrices (1% nonzeros)
+// ========================================
+void benchSparse(const int maxSize)
+{
+    printf(YELLOW "--- sparse: dense dot() vs CSR spmv()/spmm() at 1%% density ---\n" RESET);
+    for (int n = 512; n <= 2 * maxSize; n *= 2)
+    {
+        const int features = 64;
+        Matrix *dense = init(n, n);
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                if (rand() % 100 == 0)
+                    dense->grid[i][j] = (double)rand() / RAND_MAX;
+        Matrix *x = random(n, 1, -1.0, 1.0);
+        Matrix *b = random(n, features, -1.0, 1.0);
+
+        double start = wallTime();
+        SparseMatrix *csr = fromDense(dense, false);
+        printResult("fromDense (CSR)", n, wallTime() - start, csr != NULL);
+        printf("  %-28s n=%-6d dense %8.1f MB  sparse %8.1f MB\n", "memory", n, n * (double)n * sizeof(double) / 1e6,
+               (csr->nonzeros * (sizeof(double) + sizeof(int)) + (n + 1.0) * sizeof(int)) / 1e6);
+
+        start = wallTime();
+        Matrix *denseVector = dot(dense, x);
+        printResult("dense dot (vector)", n, wallTime() - start, true);
+
+        start = wallTime();
+        double *sparseVector = spmv(csr, x->data);
+        Matrix *sparseVectorMatrix = populate(n, 1, sparseVector);
+        printBandwidth("spmv", n, wallTime() - start, csr->nonzeros * (sizeof(double) + sizeof(int)) + 2.0 * n * sizeof(double),
+                       areEqual(sparseVectorMatrix, denseVector, 1e-9));
+
+        start = wallTime();
+        Matrix *denseProduct = dot(dense, b);
+        printResult("dense dot (64 columns)", n, wallTime() - start, true);
+
+        start = wallTime();
+        Matrix *sparseProduct = spmm(csr, b);
+        printResult("spmm (64 columns)", n, wallTime() - start, areEqual(sparseProduct, denseProduct, 1e-9));
+
+        destroy(dense);
+        destroy(x);
+        destroy(b);
+        destroySparse(csr);
+        destroy(denseVector);
+        free(sparseVector);
+        destroy(sparseVectorMatrix);
+        destroy(denseProduct);
+        destroy(sparseProduct);
+    }
+    printf("----------------------------------------\n");
+}
+
+// ========================================
+// Benchmark: Fused Expressions
+// ========================================
+double benchMul(double a, double b)
+{
+    return a * b;
+}
+
+double benchHalf(double a)
+{
+    return a * 0.5;
+}
+
+void benchExpr(const int maxSize)
+{
+    printf(YELLOW "--- expr: (A * B + C) * 0.5 with elementwise()/scalar() temporaries vs one fused evaluate() ---\n" RESET);
+    for (int n = 256; n <= maxSize; n *= 2)
+    {
+        const double bytes = 4.0 * n * (double)n * sizeof(double);
+        Matrix *a = random(n, n, -1.0, 1.0);
+        Matrix *b = random(n, n, -1.0, 1.0);
+        Matrix *c = random(n, n, -1.0, 1.0);
+
+        double start = wallTime();
+        Matrix *product = elementwise(a, b, benchMul);
+        Matrix *sum = elementwise(product, c, benchAdd);
+        Matrix *expected = scalar(sum, benchHalf);
+        printBandwidth("elementwise + scalar", n, wallTime() - start, bytes, true);
+
+        Matrix *result = init(n, n);
+        Expr *expr = exprScale(exprAdd(exprMul(exprLeaf(a), exprLeaf(b)), exprLeaf(c)), 0.5);
+        start = wallTime();
+        evaluate(expr, result);
+        printBandwidth("evaluate", n, wallTime() - start, bytes, areEqual(result, expected, 1e-12));
+
+        Expr *inPlace = exprScale(exprAdd(exprMul(exprLeaf(a), exprLeaf(b)), exprLeaf(c)), 0.5);
+        start = wallTime();
+        evaluate(inPlace, a);
+        printBandwidth("evaluate (in place)", n, wallTime() - start, bytes, areEqual(a, expected, 1e-12));
+
+        destroyExpr(expr);
+        destroyExpr(inPlace);
+        destroy(a);
+        destroy(b);
+        destroy(c);
+        destroy(product);
+        destroy(sum);
+        destroy(expected);
+        destroy(result);
+    }
+    printf("----------------------------------------\n");
+}
+
+// ========================================
+// Benchmark: Typed Matrices
+// ========================================
+void benchTyped(const int maxSize)
+{
+    printf(YELLOW "--- typed: F64Matrix vs Matrix vs F32Matrix vs I32Matrix dot() and conversions ---\n" RESET);
+    for (int n = 128; n <= maxSize / 2; n *= 2)
+    {
+        const double flops = 2.0 * n * (double)n * n;
+        F64Matrix *a64 = F64Matrix_random(n, n, -100.0, 100.0);
+        F64Matrix *b64 = F64Matrix_random(n, n, -100.0, 100.0);
+
+        double start = wallTime();
+        F32Matrix *a32 = F64Matrix_toF32Matrix(a64);
+        F32Matrix *b32 = F64Matrix_toF32Matrix(b64);
+        printBandwidth("F64 -> F32 conversion", n, wallTime() - start, 2.0 * n * n * (sizeof(double) + sizeof(float)), true);
+        I32Matrix *a32i = F64Matrix_toI32Matrix(a64);
+        I32Matrix *b32i = F64Matrix_toI32Matrix(b64);
+
+        start = wallTime();
+        F64Matrix *c64 = F64Matrix_dot(a64, b64);
+        printFlops("F64Matrix_dot", n, wallTime() - start, flops, true);
+
+        Matrix *a = F64Matrix_toMatrix(a64), *b = F64Matrix_toMatrix(b64);
+        start = wallTime();
+        Matrix *c = dot(a, b);
+        printFlops("dot (Matrix)", n, wallTime() - start, flops, c != NULL);
+        destroy(a);
+        destroy(b);
+        destroy(c);
+
+        start = wallTime();
+        F32Matrix *c32 = F32Matrix_dot(a32, b32);
+        double seconds = wallTime() - start;
+        bool close = true;
+        for (int i = 0; i < n && close; i++)
+            close = fabs(c32->grid[i][i] - c64->grid[i][i]) <= 1e-3 * (fabs(c64->grid[i][i]) + n * 100.0);
+        printFlops("F32Matrix_dot", n, seconds, flops, close);
+
+        start = wallTime();
+        I32Matrix *c32i = I32Matrix_dot(a32i, b32i);
+        printFlops("I32Matrix_dot (int64 acc)", n, wallTime() - start, flops, c32i != NULL);
+
+        F64Matrix_destroy(a64);
+        F64Matrix_destroy(b64);
+        F64Matrix_destroy(c64);
+        F32Matrix_destroy(a32);
+        F32Matrix_destroy(b32);
+        F32Matrix_destroy(c32);
+        I32Matrix_destroy(a32i);
+        I32Matrix_destroy(b32i);
+        I32Matrix_destroy(c32i);
+    }
+    printf("----------------------------------------\n");
+}
+
+// ========================================
+// Benchmark: Binary Files and mmapLoad
+// ========================================
+void benchLoad(const int maxSize)
+{
+    printf(YELLOW "--- load: parsing a text file + populate() vs mmapLoad() of a binary file ---\n" RESET);
+    const char *text = "bench_matrix.txt", *binary = "bench_matrix.bin";
+    for (int n = 256; n <= maxSize; n *= 2)
+    {
+        Matrix *m = random(n, n, -1.0, 1.0);
+        FILE *file = fopen(text, "w");
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                fprintf(file, "%.17g%c", m->grid[i][j], j == n - 1 ? '\n' : ' ');
+        fclose(file);
+        save(m, binary);
+
+        double start = wallTime();
+        double *array = (double *)malloc((size_t)n * n * sizeof(double));
+        file = fopen(text, "r");
+        for (size_t k = 0; k < (size_t)n * n; k++)
+            if (fscanf(file, "%lf", &array[k]) != 1)
+                break;
+        fclose(file);
+        Matrix *parsed = populate(n, n, array);
+        printResult("text parse + populate", n, wallTime() - start, areEqual(parsed, m, 0.0));
+        free(array);
+
+        start = wallTime();
+        Matrix *loaded = mmapLoad(binary);
+        printResult("mmapLoad", n, wallTime() - start, loaded != NULL);
+
+        start = wallTime();
+        bool ok = areEqual(loaded, m, 0.0);
+        printBandwidth("first read of mapped data", n, wallTime() - start, (double)n * n * sizeof(double), ok);
+
+        destroy(m);
+        destroy(parsed);
+        destroy(loaded);
+    }
+    remove(text);
+    remove(binary);
+    printf("----------------------------------------\n");
+}
+
+// ========================================
+// Benchmark: Blocked Transpose
+// ========================================
+void benchTranspose(const int maxSize)
+{
+    printf(YELLOW "--- transpose: naive baseline vs blocked transpose() vs transposeInPlace() vs copy() ---\n" RESET);
+    for (int n = 256; n <= maxSize; n *= 2)
+    {
+        const double bytes = 2.0 * n * (double)n * sizeof(double);
+        Matrix *m = random(n, n, -1.0, 1.0);
+        double **grid = baselineCopy(m->grid, n, n);
+
+        double start = wallTime();
+        double **naive = baselineTranspose(grid, n, n);
+        printBandwidth("baseline transpose", n, wallTime() - start, bytes, true);
+
+        start = wallTime();
+        Matrix *blocked = transpose(m);
+        double seconds = wallTime() - start;
+        bool ok = true;
+        for (int i = 0; i < n && ok; i++)
+            ok = memcmp(blocked->grid[i], naive[i], n * sizeof(double)) == 0;
+        printBandwidth("transpose", n, seconds, bytes, ok);
+
+        Matrix *square = copy(m);
+        start = wallTime();
+        transposeInPlace(square);
+        printBandwidth("transposeInPlace", n, wallTime() - start, bytes, areEqual(square, blocked, 0.0));
+
+        start = wallTime();
+        Matrix *copied = copy(m);
+        printBandwidth("copy (memcpy reference)", n, wallTime() - start, bytes, true);
+
+        const int rows = n / 2 + 3, columns = 2 * n - 5;
+        Matrix *wide = random(rows, columns, -1.0, 1.0);
+        Matrix *flipped = transpose(wide);
+        ok = flipped->rows == columns;
+        for (int i = 0; i < rows && ok; i++)
+            for (int j = 0; j < columns && ok; j++)
+                ok = flipped->grid[j][i] == wide->grid[i][j];
+        printResult("transpose (non-square)", n, 0.0, ok);
+
+        destroy(m);
+        destroy(blocked);
+        destroy(square);
+        destroy(copied);
+        destroy(wide);
+        destroy(flipped);
+        baselineDestroy(grid, n);
+        baselineDestroy(naive, n);
+    }
+    printf("----------------------------------------\n");
+}
+
+// ========================================
+// Benchmark: Strassen-Winograd Crossover
+// ========================================
+double maxRelativeError(const Matrix *m, const Matrix *reference)
+{
+    double error = 0.0, scale = 0.0;
+    for (int i = 0; i < m->rows; i++)
+        for (int j = 0; j < m->columns; j++)
+        {
+            error = fmax(error, fabs(m->grid[i][j] - reference->grid[i][j]));
+            scale = fmax(scale, fabs(reference->grid[i][j]));
+        }
+    return error / scale;
+}
+
+void benchStrassen(const int maxSize)
+{
+    printf(YELLOW "--- strassen: dot() vs strassen() at several crossovers (effective 2n^3 GFLOP/s) ---\n" RESET);
+    for (int n = 512; n <= maxSize; n *= 2)
+    {
+        const double flops = 2.0 * n * (double)n * n;
+        Matrix *a = random(n, n, -1.0, 1.0);
+        Matrix *b = random(n, n, -1.0, 1.0);
+
+        double start = wallTime();
+        Matrix *reference = dot(a, b);
+        printFlops("dot", n, wallTime() - start, flops, true);
+
+        for (int crossover = n / 2; crossover >= 128; crossover /= 2)
+        {
+            char name[64];
+            snprintf(name, sizeof(name), "strassen (crossover %d)", crossover);
+            start = wallTime();
+            Matrix *product = strassen(a, b, crossover);
+            double seconds = wallTime() - start;
+            double error = maxRelativeError(product, reference);
+            printFlops(name, n, seconds, flops, error < 1e-10);
+            printf("    %d level(s), max relative error vs dot %.2e\n", (int)round(log2((double)n / crossover)), error);
+            destroy(product);
+        }
+
+        destroy(a);
+        destroy(b);
+        destroy(reference);
+    }
+    printf("----------------------------------------\n");
+}
+
+// ========================================
+// Benchmark: Batched Small Matrices
+// ========================================
+void printRate(const char *name, const int size, const int count, const double seconds, const bool correct)
+{
+    printf("  %-28s n=%-6d %10.4f s %8.2f M matrices/s  %s\n", name, size, seconds, count / seconds / 1e6,
+           correct ? GREEN "ok" RESET : RED "WRONG" RESET);
+}
+
+void benchBatch(const int maxSize)
+{
+    const int count = 64 * maxSize;
+    printf(YELLOW "--- batch: %d calls of dot()/inverse()/determinant() vs one batched call ---\n" RESET, count);
+    const int sizes[3] = {3, 4, 8};
+    for (int s = 0; s < 3; s++)
+    {
+        const int n = sizes[s];
+        MatrixBatch *a = batchInit(count, n, n);
+        MatrixBatch *b = batchInit(count, n, n);
+        for (size_t i = 0; i < (size_t)count * n * n; i++)
+        {
+            a->data[i] = (double)rand() / RAND_MAX - 0.5;
+            b->data[i] = (double)rand() / RAND_MAX - 0.5;
+        }
+        for (int k = 0; k < count; k++)
+            for (int i = 0; i < n; i++)
+                a->data[(size_t)k * n * n + i * n + i] += n;
+
+        Matrix **left = (Matrix **)malloc(count * sizeof(Matrix *));
+        Matrix **right = (Matrix **)malloc(count * sizeof(Matrix *));
+        for (int k = 0; k < count; k++)
+        {
+            left[k] = populate(n, n, a->data + (size_t)k * n * n);
+            right[k] = populate(n, n, b->data + (size_t)k * n * n);
+        }
+
+        double start = wallTime();
+        Matrix **products = (Matrix **)malloc(count * sizeof(Matrix *));
+        for (int k = 0; k < count; k++)
+            products[k] = dot(left[k], right[k]);
+        printRate("dot (per matrix)", n, count, wallTime() - start, true);
+
+        start = wallTime();
+        MatrixBatch *batched = batchDot(a, b);
+        double seconds = wallTime() - start;
+        bool ok = true;
+        for (int k = 0; k < count && ok; k += 97)
+            for (int i = 0; i < n * n; i++)
+                ok = ok && fabs(products[k]->data[i] - batched->data[(size_t)k * n * n + i]) < 1e-12;
+        printRate("batchDot", n, count, seconds, ok);
+
+        start = wallTime();
+        Matrix **inverses = (Matrix **)malloc(count * sizeof(Matrix *));
+        for (int k = 0; k < count; k++)
+            inverses[k] = inverse(left[k]);
+        printRate("inverse (per matrix)", n, count, wallTime() - start, true);
+
+        start = wallTime();
+        MatrixBatch *inverted = batchInverse(a);
+        seconds = wallTime() - start;
+        ok = true;
+        for (int k = 0; k < count && ok; k += 97)
+            for (int i = 0; i < n * n; i++)
+                ok = ok && fabs(inverses[k]->data[i] - inverted->data[(size_t)k * n * n + i]) < 1e-12;
+        printRate("batchInverse", n, count, seconds, ok);
+
+        start = wallTime();
+        double *determinants = (double *)malloc(count * sizeof(double));
+        for (int k = 0; k < count; k++)
+            determinants[k] = determinant(left[k]);
+        printRate("determinant (per matrix)", n, count, wallTime() - start, true);
+
+        start = wallTime();
+        double *batchedDeterminants = batchDeterminant(a);
+        seconds = wallTime() - start;
+        ok = true;
+        for (int k = 0; k < count && ok; k++)
+            ok = fabs(determinants[k] - batchedDeterminants[k]) <= 1e-10 * fabs(determinants[k]);
+        printRate("batchDeterminant", n, count, seconds, ok);
+
+        for (int k = 0; k < count; k++)
+        {
+            destroy(left[k]);
+            destroy(right[k]);
+            destroy(products[k]);
+            destroy(inverses[k]);
+        }
+        free(left);
+        free(right);
+        free(products);
+        free(inverses);
+        free(determinants);
+        free(batchedDeterminants);
+        destroyBatch(a);
+        destroyBatch(b);
+        destroyBatch(batched);
+        destroyBatch(inverted);
+    }
+    printf("----------------------------------------\n");
+}
+
+// ========================================
+// Benchmark: Out-of-Core DiskMatrix
+// ========================================
+void benchDisk(const int maxSize)
+{
+    const int n = maxSize;
+    const double flops = 2.0 * n * (double)n * n, bytes = 2.0 * n * (double)n * sizeof(double);
+    const char *paths[4] = {"bench_disk_a.bin", "bench_disk_b.bin", "bench_disk_c.bin", "bench_disk_t.bin"};
+    printf(YELLOW "--- disk: in-memory dot() vs diskDot(), diskTranspose() and diskScalar() at several memory budgets ---\n" RESET);
+    Matrix *a = random(n, n, -1.0, 1.0);
+    Matrix *b = random(n, n, -1.0, 1.0);
+    DiskMatrix *diskA = toDisk(a, paths[0], 0);
+    DiskMatrix *diskB = toDisk(b, paths[1], 0);
+
+    double start = wallTime();
+    Matrix *reference = dot(a, b);
+    printFlops("dot (in memory)", n, wallTime() - start, flops, true);
+
+    const size_t tileBytes = (size_t)DISK_TILE * DISK_TILE * sizeof(double);
+    const int budgets[4] = {5, 14, 32, 200}; // in tiles
+    for (int i = 0; i < 4; i++)
+    {
+        size_t budget = budgets[i] * tileBytes;
+        char name[64];
+
+        snprintf(name, sizeof(name), "diskDot (%zu MiB)", budget >> 20);
+        start = wallTime();
+        DiskMatrix *product = diskDot(diskA, diskB, paths[2], budget);
+        double seconds = wallTime() - start;
+        Matrix *result = fromDisk(product);
+        printFlops(name, n, seconds, flops, areEqual(result, reference, 1e-12));
+
+        snprintf(name, sizeof(name), "diskTranspose (%zu MiB)", budget >> 20);
+        start = wallTime();
+        DiskMatrix *flipped = diskTranspose(diskA, paths[3], budget);
+        printBandwidth(name, n, wallTime() - start, bytes, flipped != NULL);
+        diskClose(flipped);
+
+        snprintf(name, sizeof(name), "diskScalar (%zu MiB)", budget >> 20);
+        start = wallTime();
+        DiskMatrix *absolute = diskScalar(diskA, paths[3], fabs, budget);
+        printBandwidth(name, n, wallTime() - start, bytes, absolute != NULL);
+        diskClose(absolute);
+
+        diskClose(product);
+        destroy(result);
+    }
+
+    diskClose(diskA);
+    diskClose(diskB);
+    for (int i = 0; i < 4; i++)
+        remove(paths[i]);
+    destroy(a);
+    destroy(b);
+    destroy(reference);
+    printf("  (files are served from the page cache when they fit in RAM; drop caches for cold-disk numbers)\n");
+    printf("----------------------------------------\n");
+}
+
+// ========================================
+// Benchmark: Arena Allocation and Into Variants
+// ========================================
+void benchArena(const int maxSize)
+{
+    const int requests = 20000;
+    printf(YELLOW "--- arena: %d scoring requests (dot, scalar, elementwise, transpose, copy) with calloc vs an arena vs Into ---\n" RESET, requests);
+    for (int n = 8; n <= 64 && n <= maxSize; n *= 2)
+    {
+        Matrix *features = random(n, 2 * n, -1.0, 1.0);
+        Matrix *weights = random(2 * n, n, -1.0, 1.0);
+        double checksum[3] = {0.0, 0.0, 0.0};
+        const char *names[3] = {"calloc + destroy", "arena + reset", "Into (preallocated)"};
+        MatrixArena *arena = arenaInit(4096);
+        Matrix *hidden = init(n, n), *activated = init(n, n), *summed = init(n, n), *flipped = init(n, n), *copied = init(n, n);
+
+        for (int mode = 0; mode < 3; mode++)
+        {
+            double start = wallTime();
+            for (int r = 0; r < requests; r++)
+            {
+                if (mode == 2)
+                {
+                    dotInto(hidden, features, weights);
+                    scalarInto(activated, hidden, benchHalf);
+                    elementwiseInto(summed, activated, hidden, benchAdd);
+                    transposeInto(flipped, summed);
+                    copyInto(copied, flipped);
+                    checksum[mode] += copied->grid[0][n - 1];
+                    continue;
+                }
+                if (mode == 1)
+                    useArena(arena);
+                Matrix *h = dot(features, weights);
+                Matrix *a = scalar(h, benchHalf);
+                Matrix *s = elementwise(a, h, benchAdd);
+                Matrix *t = transpose(s);
+                Matrix *c = copy(t);
+                checksum[mode] += c->grid[0][n - 1];
+                destroy(h);
+                destroy(a);
+                destroy(s);
+                destroy(t);
+                destroy(c);
+                if (mode == 1)
+                {
+                    useArena(NULL);
+                    arenaReset(arena);
+                }
+            }
+            double seconds = wallTime() - start;
+            printf("  %-28s n=%-6d %10.4f s %8.2f k requests/s  %s\n", names[mode], n, seconds, requests / seconds / 1e3,
+                   checksum[mode] == checksum[0] ? GREEN "ok" RESET : RED "WRONG" RESET);
+        }
+
+        arenaDestroy(arena);
+        destroy(features);
+        destroy(weights);
+        destroy(hidden);
+        destroy(activated);
+        destroy(summed);
+        destroy(flipped);
+        destroy(copied);
+    }
+    printf("----------------------------------------\n");
+}
+
+// ========================================
+// Benchmark: In-Place Row Appends
+// ========================================
+void benchAppend(const int maxSize)
+{
+    const int columns = 32;
+    printf(YELLOW "--- append: growing a %d-column matrix one row at a time, insertField vs insertFieldInPlace ---\n" RESET, columns);
+    for (int rows = 2000; rows <= 8000 && rows <= 8 * maxSize; rows *= 2)
+    {
+        Matrix *source = random(rows, columns, -1.0, 1.0);
+        const char *names[3] = {"insertField (copy)", "insertFieldInPlace", "reserve + InPlace"};
+        for (int mode = 0; mode < 3; mode++)
+        {
+            Matrix *grown = init(1, columns);
+            memcpy(grown->grid[0], source->grid[0], columns * sizeof(double));
+            if (mode == 2)
+                reserve(grown, rows, columns);
+
+            double start = wallTime();
+            for (int i = 1; i < rows; i++)
+            {
+                if (mode != 0)
+                {
+                    insertFieldInPlace(grown, grown->rows, false, source->grid[i]);
+                    continue;
+                }
+                Matrix *next = insertField(grown, grown->rows, false, source->grid[i]);
+                destroy(grown);
+                grown = next;
+            }
+            double seconds = wallTime() - start;
+            printf("  %-28s n=%-6d %10.4f s %10.1f k rows/s  %s\n", names[mode], rows, seconds, rows / seconds / 1e3,
+                   areEqual(grown, source, 0.0) ? GREEN "ok" RESET : RED "WRONG" RESET);
+            destroy(grown);
+        }
+        destroy(source);
+    }
+}
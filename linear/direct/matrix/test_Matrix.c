@@ -324,6 +324,923 @@ void test_meshgrid()
     destroy(expected_mesh);
 }
 
+void test_contiguous_views()
+{
+    TEST_CASE("contiguous storage, view(), sliceView(), fieldView(), transposeView(), & materialize()");
+    Matrix *m = populate(3, 4, (double[]){1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+    int contiguous = m->stride == m->columns && ((uintptr_t)m->data % MATRIX_ALIGNMENT) == 0;
+    for (int i = 0; i < m->rows; i++)
+        contiguous = contiguous && m->grid[i] == m->data + i * m->stride;
+    ASSERT_TRUE(contiguous, "init() stores the rows contiguously in one aligned block.");
+
+    MatrixView block = sliceView(view(m), 1, 3, 1, 3);
+    Matrix *block_copy = materialize(block);
+    Matrix *expected_block = slice(m, 1, 3, 1, 3);
+    ASSERT_TRUE(are_matrices_equal(block_copy, expected_block, 1e-9), "sliceView() matches slice().");
+    viewSet(block, 0, 0, 99);
+    ASSERT_TRUE(m->grid[1][1] == 99 && block.data == &m->grid[1][1], "sliceView() shares storage with the matrix (zero-copy).");
+    m->grid[1][1] = 6;
+
+    MatrixView column = fieldView(view(m), 2, true);
+    double *expected_column = getField(m, 2, true);
+    int column_ok = column.rows == 3 && column.columns == 1;
+    for (int i = 0; i < 3; i++)
+        column_ok = column_ok && viewGet(column, i, 0) == expected_column[i];
+    ASSERT_TRUE(column_ok, "fieldView() of a column matches getField().");
+
+    Matrix *transposed_copy = materialize(transposeView(view(m)));
+    Matrix *expected_transpose = transpose(m);
+    ASSERT_TRUE(are_matrices_equal(transposed_copy, expected_transpose, 1e-9), "transposeView() matches transpose().");
+    MatrixView nested = sliceView(transposeView(view(m)), 1, 4, 0, 2);
+    ASSERT_TRUE(viewGet(nested, 2, 1) == 8, "Views compose: a slice of a transposed view addresses the right element.");
+    ASSERT_TRUE(sliceView(view(m), 0, 4, 0, 1).data == NULL && viewGet(column, 3, 0) == -1, "Invalid views are empty and out-of-range reads return -1.");
+
+    destroy(m);
+    destroy(block_copy);
+    destroy(expected_block);
+    free(expected_column);
+    destroy(transposed_copy);
+    destroy(expected_transpose);
+}
+
+void test_gemm()
+{
+    TEST_CASE("gemm() & blocked dot()");
+    const int m = 37, k = 300, n = 45;
+    Matrix *a = random(m, k, -1.0, 1.0);
+    Matrix *b = random(k, n, -1.0, 1.0);
+    Matrix *reference = init(m, n);
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < n; j++)
+            for (int p = 0; p < k; p++)
+                reference->grid[i][j] += a->grid[i][p] * b->grid[p][j];
+
+    Matrix *product = dot(a, b);
+    ASSERT_TRUE(are_matrices_equal(product, reference, 1e-9), "dot() on odd sizes matches the naive triple loop.");
+
+    Matrix *c = fill(m, n, 1.0);
+    gemm(2.0, view(a), view(b), -1.0, view(c));
+    int scaled_ok = 1;
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < n; j++)
+            scaled_ok = scaled_ok && fabs(c->grid[i][j] - (2.0 * reference->grid[i][j] - 1.0)) < 1e-9;
+    ASSERT_TRUE(scaled_ok, "gemm() computes alpha * A * B + beta * C.");
+
+    Matrix *at = transpose(a);
+    Matrix *bt = transpose(b);
+    Matrix *ct = init(n, m);
+    gemm(1.0, transposeView(view(at)), transposeView(view(bt)), 0.0, transposeView(view(ct)));
+    Matrix *ct_back = transpose(ct);
+    ASSERT_TRUE(are_matrices_equal(ct_back, reference, 1e-9), "gemm() handles transposed (strided) views.");
+
+    Matrix *corner = init(m - 2, 5);
+    gemm(1.0, sliceView(view(a), 1, m - 1, 0, k), sliceView(view(b), 0, k, 40, 45), 0.0, view(corner));
+    ASSERT_TRUE(fabs(corner->grid[2][3] - reference->grid[3][43]) < 1e-9,
+                "gemm() multiplies sliced sub-views.");
+    ASSERT_TRUE(!gemm(1.0, view(a), view(a), 0.0, view(c)), "gemm() rejects incompatible dimensions.");
+
+    destroy(a);
+    destroy(b);
+    destroy(reference);
+    destroy(product);
+    destroy(c);
+    destroy(at);
+    destroy(bt);
+    destroy(ct);
+    destroy(ct_back);
+    destroy(corner);
+}
+
+double add_values(double a, double b)
+{
+    return a + b;
+}
+
+void test_thread_pool()
+{
+    TEST_CASE("setThreads(), getThreads() & parallel dot(), scalar(), elementwise(), determinant(), inverse()");
+    Matrix *a = random(300, 300, -0.003, 0.003);
+    Matrix *b = random(300, 300, -1.0, 1.0);
+    for (int i = 0; i < 300; i++)
+        a->grid[i][i] += 1.0; // diagonally dominant, so well conditioned with a moderate determinant
+
+    setThreads(1);
+    Matrix *serial_dot = dot(a, b);
+    Matrix *serial_sum = elementwise(a, b, add_values);
+    Matrix *serial_root = scalar(b, fabs);
+    double serial_det = determinant(a);
+    Matrix *serial_inverse = inverse(a);
+
+    setThreads(4);
+    ASSERT_TRUE(getThreads() == 4, "setThreads() changes the thread count reported by getThreads().");
+    Matrix *parallel_dot = dot(a, b);
+    ASSERT_TRUE(are_matrices_equal(parallel_dot, serial_dot, 1e-9), "dot() split into tiles matches the serial result.");
+    Matrix *parallel_sum = elementwise(a, b, add_values);
+    Matrix *parallel_root = scalar(b, fabs);
+    ASSERT_TRUE(are_matrices_equal(parallel_sum, serial_sum, 0.0) && are_matrices_equal(parallel_root, serial_root, 0.0),
+                "elementwise() and scalar() split into row blocks match the serial results.");
+    ASSERT_TRUE(fabs(determinant(a) - serial_det) < 1e-9 * fabs(serial_det) && serial_det != 0.0, "Parallel determinant() matches the serial result.");
+    Matrix *parallel_inverse = inverse(a);
+    ASSERT_TRUE(are_matrices_equal(parallel_inverse, serial_inverse, 1e-9), "Parallel inverse() matches the serial result.");
+
+    setThreads(0);
+    ASSERT_TRUE(getThreads() >= 1, "setThreads(0) falls back to the number of online processors.");
+
+    destroy(a);
+    destroy(b);
+    destroy(serial_dot);
+    destroy(serial_sum);
+    destroy(serial_root);
+    destroy(serial_inverse);
+    destroy(parallel_dot);
+    destroy(parallel_sum);
+    destroy(parallel_root);
+    destroy(parallel_inverse);
+}
+
+void test_lu_factor()
+{
+    TEST_CASE("factorize(), solve(), solveMany(), factorDeterminant(), factorInverse(), & destroyFactor()");
+    const int n = 250; // more than two LU_BLOCK panels
+    Matrix *a = random(n, n, -1.0, 1.0);
+    LUFactor *factor = factorize(a);
+    ASSERT_TRUE(factor != NULL && !factor->singular, "factorize() factorizes a random square matrix.");
+
+    Matrix *l = identity(n);
+    Matrix *u = init(n, n);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            if (j < i)
+                l->grid[i][j] = factor->lu->grid[i][j];
+            else
+                u->grid[i][j] = factor->lu->grid[i][j];
+    Matrix *product = dot(l, u);
+    int reconstructs = 1;
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            reconstructs = reconstructs && fabs(product->grid[i][j] - a->grid[factor->pivot[i]][j]) < 1e-9;
+    ASSERT_TRUE(reconstructs, "L * U equals the row-permuted matrix P * A.");
+
+    double b[250], residual = 0.0;
+    for (int i = 0; i < n; i++)
+        b[i] = i % 7 - 3.0;
+    double *x = solve(factor, b);
+    for (int i = 0; i < n; i++)
+    {
+        double row = -b[i];
+        for (int j = 0; j < n; j++)
+            row += a->grid[i][j] * x[j];
+        residual = fmax(residual, fabs(row));
+    }
+    ASSERT_TRUE(residual < 1e-8, "solve() returns x with A * x = b.");
+
+    Matrix *rhs = random(n, 5, -1.0, 1.0);
+    Matrix *many = solveMany(factor, rhs);
+    Matrix *check = dot(a, many);
+    ASSERT_TRUE(are_matrices_equal(check, rhs, 1e-8), "solveMany() solves every right-hand side column.");
+
+    Matrix *inv = factorInverse(factor);
+    Matrix *should_be_identity = dot(a, inv);
+    Matrix *eye = identity(n);
+    ASSERT_TRUE(are_matrices_equal(should_be_identity, eye, 1e-8), "factorInverse() returns the inverse.");
+
+    Matrix *small = populate(3, 3, (double[]){0, 2, 1, 1, 1, 1, 2, 1, 3});
+    LUFactor *small_factor = factorize(small);
+    ASSERT_TRUE(fabs(factorDeterminant(small_factor) - (-3.0)) < 1e-12, "factorDeterminant() accounts for the pivot sign.");
+
+    Matrix *singular = populate(2, 2, (double[]){1, 2, 2, 4});
+    LUFactor *singular_factor = factorize(singular);
+    ASSERT_TRUE(singular_factor != NULL && singular_factor->singular && solve(singular_factor, b) == NULL &&
+                    factorInverse(singular_factor) == NULL && factorDeterminant(singular_factor) == 0.0,
+                "A singular matrix is flagged; solve() and factorInverse() return NULL.");
+    ASSERT_TRUE(factorize(rhs) == NULL, "factorize() rejects non-square matrices.");
+
+    destroy(a);
+    destroy(l);
+    destroy(u);
+    destroy(product);
+    free(x);
+    destroy(rhs);
+    destroy(many);
+    destroy(check);
+    destroy(inv);
+    destroy(should_be_identity);
+    destroy(eye);
+    destroy(small);
+    destroy(singular);
+    destroyFactor(factor);
+    destroyFactor(small_factor);
+    destroyFactor(singular_factor);
+}
+
+Matrix *random_sparse_dense(const int rows, const int columns, const int percent)
+{
+    Matrix *m = init(rows, columns);
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < columns; j++)
+            if (rand() % 100 < percent)
+                m->grid[i][j] = (double)(rand() % 19) - 9.0;
+    return m;
+}
+
+void test_sparse_matrix()
+{
+    TEST_CASE("fromDense(), toDense(), sparseGet(), convertSparse(), sparseTranspose(), spmv(), & spmm()");
+    Matrix *dense = random_sparse_dense(40, 30, 10);
+    dense->grid[3][4] = 7.0;
+    SparseMatrix *csr = fromDense(dense, false);
+    SparseMatrix *csc = fromDense(dense, true);
+    Matrix *back_csr = toDense(csr);
+    Matrix *back_csc = toDense(csc);
+    ASSERT_TRUE(are_matrices_equal(back_csr, dense, 0.0) && are_matrices_equal(back_csc, dense, 0.0), "toDense(fromDense()) round-trips in CSR and CSC.");
+    ASSERT_TRUE(sparseGet(csr, 3, 4) == 7.0 && sparseGet(csc, 3, 4) == 7.0 && sparseGet(csr, 40, 0) == -1, "sparseGet() finds stored elements and rejects invalid indices.");
+
+    SparseMatrix *converted = convertSparse(csr);
+    int same_arrays = converted->axis && converted->nonzeros == csc->nonzeros &&
+                      memcmp(converted->offsets, csc->offsets, 31 * sizeof(int)) == 0 &&
+                      memcmp(converted->indices, csc->indices, csc->nonzeros * sizeof(int)) == 0 &&
+                      memcmp(converted->values, csc->values, csc->nonzeros * sizeof(double)) == 0;
+    ASSERT_TRUE(same_arrays, "convertSparse() turns CSR into the same arrays as fromDense(..., true).");
+
+    SparseMatrix *transposed = sparseTranspose(csr);
+    Matrix *transposed_dense = toDense(transposed);
+    Matrix *expected_transpose = transpose(dense);
+    ASSERT_TRUE(are_matrices_equal(transposed_dense, expected_transpose, 0.0), "sparseTranspose() matches transpose().");
+
+    double x[30];
+    for (int j = 0; j < 30; j++)
+        x[j] = j * 0.5 - 3.0;
+    Matrix *column = populate(30, 1, x);
+    Matrix *expected_product = dot(dense, column);
+    double *y_csr = spmv(csr, x);
+    double *y_csc = spmv(csc, x);
+    int spmv_ok = 1;
+    for (int i = 0; i < 40; i++)
+        spmv_ok = spmv_ok && fabs(y_csr[i] - expected_product->grid[i][0]) < 1e-9 && fabs(y_csc[i] - expected_product->grid[i][0]) < 1e-9;
+    ASSERT_TRUE(spmv_ok, "spmv() matches dot() with a column vector for CSR and CSC.");
+
+    Matrix *right = random(30, 7, -1.0, 1.0);
+    Matrix *expected_spmm = dot(dense, right);
+    Matrix *spmm_csr = spmm(csr, right);
+    Matrix *spmm_csc = spmm(csc, right);
+    ASSERT_TRUE(are_matrices_equal(spmm_csr, expected_spmm, 1e-9) && are_matrices_equal(spmm_csc, expected_spmm, 1e-9), "spmm() matches dot() for CSR and CSC.");
+    ASSERT_TRUE(spmm(csr, dense) == NULL, "spmm() rejects incompatible dimensions.");
+
+    Matrix *big = random_sparse_dense(600, 2000, 6);
+    for (int j = 0; j < 2000; j++)
+        big->grid[0][j] = 1.0; // a dense row, so splitting by nonzeros differs from splitting by rows
+    SparseMatrix *big_csr = fromDense(big, false);
+    double *ones = (double *)malloc(2000 * sizeof(double));
+    for (int j = 0; j < 2000; j++)
+        ones[j] = (double)(j % 5);
+    setThreads(1);
+    double *serial = spmv(big_csr, ones);
+    setThreads(4);
+    double *parallel = spmv(big_csr, ones);
+    setThreads(0);
+    ASSERT_TRUE(big_csr->nonzeros >= 65536 && are_arrays_equal(serial, parallel, 600, 0.0), "Multithreaded spmv() matches the serial result.");
+
+    destroy(dense);
+    destroySparse(csr);
+    destroySparse(csc);
+    destroy(back_csr);
+    destroy(back_csc);
+    destroySparse(converted);
+    destroySparse(transposed);
+    destroy(transposed_dense);
+    destroy(expected_transpose);
+    destroy(column);
+    destroy(expected_product);
+    free(y_csr);
+    free(y_csc);
+    destroy(right);
+    destroy(expected_spmm);
+    destroy(spmm_csr);
+    destroy(spmm_csc);
+    destroy(big);
+    destroySparse(big_csr);
+    free(ones);
+    free(serial);
+    free(parallel);
+}
+
+void test_sparse_triplets()
+{
+    TEST_CASE("sparseFromTriplets()");
+    // 200000 x 200000 doubles would need 320 GB dense; the triplets need a few MB.
+    const int n = 200000, count = 5 * n;
+    int *row_indices = (int *)malloc(count * sizeof(int));
+    int *column_indices = (int *)malloc(count * sizeof(int));
+    double *values = (double *)malloc(count * sizeof(double));
+    int t = 0;
+    for (int i = n - 1; i >= 0; i--) // rows in reverse, columns out of order within a row
+    {
+        int off_diagonal = (int)(((long long)i * 7 + 1) % n);
+        int cancelled = (i + 2) % n;
+        row_indices[t] = i, column_indices[t] = i, values[t++] = 2.0;
+        row_indices[t] = i, column_indices[t] = cancelled, values[t++] = 3.0;
+        row_indices[t] = i, column_indices[t] = off_diagonal, values[t++] = 1.0;
+        row_indices[t] = i, column_indices[t] = i, values[t++] = 2.0;
+        row_indices[t] = i, column_indices[t] = cancelled, values[t++] = -3.0;
+    }
+
+    SparseMatrix *csr = sparseFromTriplets(n, n, count, row_indices, column_indices, values, false);
+    SparseMatrix *csc = sparseFromTriplets(n, n, count, row_indices, column_indices, values, true);
+    ASSERT_TRUE(csr != NULL && csc != NULL && csr->nonzeros == 2 * n && csc->nonzeros == 2 * n, "Duplicates are summed and cancelled entries are dropped.");
+
+    int sorted = 1;
+    for (int g = 0; g < n; g++)
+        for (int p = csr->offsets[g] + 1; p < csr->offsets[g + 1]; p++)
+            sorted = sorted && csr->indices[p - 1] < csr->indices[p] && csc->indices[p - 1] < csc->indices[p];
+    ASSERT_TRUE(sorted, "Indices are ascending within every row (CSR) and column (CSC).");
+    ASSERT_TRUE(sparseGet(csr, 5, 5) == 4.0 && sparseGet(csc, 5, 36) == 1.0 && sparseGet(csr, 5, 7) == 0.0, "sparseGet() sees the summed, placed and cancelled entries.");
+
+    double *ones = (double *)malloc(n * sizeof(double));
+    for (int j = 0; j < n; j++)
+        ones[j] = 1.0;
+    double *y_csr = spmv(csr, ones);
+    double *y_csc = spmv(csc, ones);
+    int spmv_ok = 1;
+    for (int i = 0; i < n; i++)
+        spmv_ok = spmv_ok && y_csr[i] == 5.0 && y_csc[i] == 5.0;
+    ASSERT_TRUE(spmv_ok, "spmv() on the triplet-built matrices gives the row sums.");
+
+    SparseMatrix *converted = convertSparse(csr);
+    int same_arrays = converted->nonzeros == csc->nonzeros &&
+                      memcmp(converted->offsets, csc->offsets, (n + 1) * sizeof(int)) == 0 &&
+                      memcmp(converted->indices, csc->indices, csc->nonzeros * sizeof(int)) == 0 &&
+                      memcmp(converted->values, csc->values, csc->nonzeros * sizeof(double)) == 0;
+    ASSERT_TRUE(same_arrays, "convertSparse() of the CSR build equals the CSC build.");
+
+    int bad_rows[] = {0, 3}, bad_columns[] = {0, 1};
+    double bad_values[] = {1.0, 1.0};
+    ASSERT_TRUE(sparseFromTriplets(3, 3, 2, bad_rows, bad_columns, bad_values, false) == NULL, "Out-of-range indices are rejected.");
+    SparseMatrix *empty = sparseFromTriplets(3, 4, 0, NULL, NULL, NULL, false);
+    ASSERT_TRUE(empty != NULL && empty->nonzeros == 0 && empty->offsets[3] == 0, "An empty triplet list gives an all-zero matrix.");
+
+    free(row_indices);
+    free(column_indices);
+    free(values);
+    destroySparse(csr);
+    destroySparse(csc);
+    destroySparse(converted);
+    destroySparse(empty);
+    free(ones);
+    free(y_csr);
+    free(y_csc);
+}
+
+void test_expressions()
+{
+    TEST_CASE("exprLeaf(), exprConstant(), exprAdd(), exprMul(), exprFma(), exprScale(), exprRelu(), exprExp(), & evaluate()");
+    const int rows = 13, columns = 600; // several chunks per row, with a ragged tail
+    Matrix *a = random(rows, columns, -2.0, 2.0);
+    Matrix *b = random(rows, columns, -2.0, 2.0);
+    Matrix *c = random(rows, columns, -2.0, 2.0);
+    Matrix *result = init(rows, columns);
+
+    Expr *expr = exprScale(exprAdd(exprMul(exprLeaf(a), exprLeaf(b)), exprLeaf(c)), 0.5);
+    int ok = evaluate(expr, result);
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < columns; j++)
+            ok = ok && fabs(result->grid[i][j] - (a->grid[i][j] * b->grid[i][j] + c->grid[i][j]) * 0.5) < 1e-12;
+    ASSERT_TRUE(ok, "(A * B + C) * 0.5 is evaluated in one pass.");
+    destroyExpr(expr);
+
+    expr = exprExp(exprRelu(exprFma(exprLeaf(a), exprConstant(3.0), exprLeaf(b))));
+    ok = evaluate(expr, result);
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < columns; j++)
+            ok = ok && fabs(result->grid[i][j] - exp(fmax(a->grid[i][j] * 3.0 + b->grid[i][j], 0.0))) < 1e-9 * exp(8.0);
+    ASSERT_TRUE(ok, "exprFma(), exprConstant(), exprRelu() and exprExp() compose.");
+    destroyExpr(expr);
+
+    Matrix *expected = copy(a);
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < columns; j++)
+            expected->grid[i][j] = a->grid[i][j] + a->grid[i][j] * b->grid[i][j];
+    expr = exprAdd(exprLeaf(a), exprMul(exprLeaf(a), exprLeaf(b)));
+    ASSERT_TRUE(evaluate(expr, a) && are_matrices_equal(a, expected, 1e-12), "evaluate() can write in place into one of its leaves.");
+    destroyExpr(expr);
+
+    Matrix *small = init(2, 2);
+    ASSERT_TRUE(exprAdd(exprLeaf(a), exprLeaf(small)) == NULL && exprMul(exprLeaf(a), NULL) == NULL, "Builders reject mismatched shapes and missing operands.");
+    expr = exprLeaf(b);
+    ASSERT_TRUE(!evaluate(expr, small), "evaluate() rejects a destination of the wrong shape.");
+    destroyExpr(expr);
+
+    destroy(a);
+    destroy(b);
+    destroy(c);
+    destroy(result);
+    destroy(expected);
+    destroy(small);
+}
+
+void test_save_mmap_load()
+{
+    TEST_CASE("save() & mmapLoad()");
+    const char *path = "test_matrix.bin";
+    Matrix *m = random(37, 53, -10.0, 10.0);
+    ASSERT_TRUE(save(m, path), "save() writes the matrix to a file.");
+
+    Matrix *loaded = mmapLoad(path);
+    ASSERT_TRUE(loaded != NULL && loaded->rows == 37 && loaded->columns == 53 && are_matrices_equal(m, loaded, 0.0), "mmapLoad() returns the saved matrix bit for bit.");
+    ASSERT_TRUE(loaded != NULL && loaded->mapping != NULL && (uintptr_t)loaded->data % 64 == 0, "The elements are used in place, 64-byte aligned within the mapping.");
+
+    Matrix *writable = copy(loaded);
+    set(writable, 0, 0, 99.0);
+    ASSERT_TRUE(writable != NULL && writable->mapping == NULL && get(writable, 0, 0) == 99.0 && get(loaded, 0, 0) == get(m, 0, 0), "copy() of a loaded matrix is writable and independent.");
+
+    FILE *file = fopen(path, "w");
+    fputs("1 2 3\n4 5 6\n", file);
+    fclose(file);
+    ASSERT_TRUE(mmapLoad(path) == NULL && mmapLoad("missing_matrix.bin") == NULL && !save(NULL, path), "mmapLoad() rejects foreign and missing files.");
+
+    remove(path);
+    destroy(m);
+    destroy(loaded);
+    destroy(writable);
+}
+
+void test_blocked_transpose()
+{
+    TEST_CASE("transpose() & transposeInPlace() on multi-tile matrices");
+    Matrix *wide = random(70, 45, -1.0, 1.0); // ragged tiles in both directions
+    Matrix *flipped = transpose(wide);
+    int ok = flipped != NULL && flipped->rows == 45 && flipped->columns == 70;
+    for (int i = 0; ok && i < 70; i++)
+        for (int j = 0; j < 45; j++)
+            ok = ok && flipped->grid[j][i] == wide->grid[i][j];
+    ASSERT_TRUE(ok, "transpose() handles partial tiles on non-square matrices.");
+
+    Matrix *square = random(77, 77, -1.0, 1.0);
+    Matrix *expected = transpose(square);
+    ASSERT_TRUE(transposeInPlace(square) && are_matrices_equal(square, expected, 0.0), "transposeInPlace() matches transpose() on a square matrix.");
+    ASSERT_TRUE(!transposeInPlace(wide) && !transposeInPlace(NULL), "transposeInPlace() rejects non-square matrices.");
+
+    Matrix *big = random(300, 300, -1.0, 1.0); // above MATRIX_PARALLEL_CUTOFF
+    setThreads(1);
+    Matrix *serial = transpose(big);
+    setThreads(4);
+    Matrix *parallel = transpose(big);
+    Matrix *inPlace = copy(big);
+    transposeInPlace(inPlace);
+    setThreads(0);
+    ASSERT_TRUE(are_matrices_equal(serial, parallel, 0.0) && are_matrices_equal(serial, inPlace, 0.0), "Multithreaded transposes match the serial result.");
+
+    destroy(wide);
+    destroy(flipped);
+    destroy(square);
+    destroy(expected);
+    destroy(big);
+    destroy(serial);
+    destroy(parallel);
+    destroy(inPlace);
+}
+
+void test_strassen()
+{
+    TEST_CASE("strassen()");
+    Matrix *a = random(100, 100, -1.0, 1.0); // 100 -> 50 -> 25 (odd, peeled) -> 24 -> 12
+    Matrix *b = random(100, 100, -1.0, 1.0);
+    Matrix *expected = dot(a, b);
+    Matrix *product = strassen(a, b, 12);
+    ASSERT_TRUE(are_matrices_equal(product, expected, 1e-10), "strassen() matches dot() through even and odd levels.");
+
+    Matrix *c = random(129, 129, -1.0, 1.0);
+    Matrix *d = random(129, 129, -1.0, 1.0);
+    Matrix *expected_odd = dot(c, d);
+    Matrix *product_odd = strassen(c, d, 8);
+    Matrix *product_default = strassen(c, d, 0);
+    ASSERT_TRUE(are_matrices_equal(product_odd, expected_odd, 1e-10) && are_matrices_equal(product_default, expected_odd, 1e-12), "strassen() handles an odd top level and the default crossover.");
+
+    Matrix *wide = random(3, 5, -1.0, 1.0);
+    Matrix *tall = random(5, 4, -1.0, 1.0);
+    Matrix *expected_rect = dot(wide, tall);
+    Matrix *product_rect = strassen(wide, tall, 0);
+    ASSERT_TRUE(are_matrices_equal(product_rect, expected_rect, 1e-12) && strassen(a, wide, 0) == NULL, "Non-square products fall back to dot(); mismatched ones are rejected.");
+
+    destroy(a);
+    destroy(b);
+    destroy(expected);
+    destroy(product);
+    destroy(c);
+    destroy(d);
+    destroy(expected_odd);
+    destroy(product_odd);
+    destroy(product_default);
+    destroy(wide);
+    destroy(tall);
+    destroy(expected_rect);
+    destroy(product_rect);
+}
+
+MatrixBatch *random_batch(const int count, const int rows, const int columns)
+{
+    MatrixBatch *batch = batchInit(count, rows, columns);
+    for (size_t i = 0; i < (size_t)count * rows * columns; i++)
+        batch->data[i] = (double)rand() / RAND_MAX * 2.0 - 1.0;
+    return batch;
+}
+
+int batch_matches(const MatrixBatch *batch, const int index, const Matrix *expected, const double tolerance)
+{
+    Matrix *actual = materialize(batchView(batch, index));
+    int equal = are_matrices_equal(actual, expected, tolerance);
+    destroy(actual);
+    return equal;
+}
+
+void test_matrix_batch()
+{
+    TEST_CASE("batchInit(), batchView(), batchDot(), batchInverse(), batchDeterminant(), & batchTranspose()");
+    const int sizes[6] = {2, 3, 4, 5, 8, 9}; // closed forms, unrolled kernels and the generic fallbacks
+    int dots = 1, inverses = 1, determinants = 1, transposes = 1;
+    for (int s = 0; s < 6; s++)
+    {
+        int n = sizes[s];
+        MatrixBatch *a = random_batch(7, n, n);
+        MatrixBatch *b = random_batch(7, n, n);
+        for (int k = 0; k < 7; k++)
+            for (int i = 0; i < n; i++)
+                a->data[(size_t)k * n * n + i * n + i] += n; // well conditioned
+        MatrixBatch *products = batchDot(a, b);
+        MatrixBatch *inverted = batchInverse(a);
+        MatrixBatch *transposed = batchTranspose(a);
+        double *dets = batchDeterminant(a);
+        for (int k = 0; k < 7; k++)
+        {
+            Matrix *left = materialize(batchView(a, k));
+            Matrix *right = materialize(batchView(b, k));
+            Matrix *product = dot(left, right);
+            Matrix *inv = inverse(left);
+            Matrix *flipped = transpose(left);
+            dots = dots && batch_matches(products, k, product, 1e-12);
+            inverses = inverses && batch_matches(inverted, k, inv, 1e-12);
+            transposes = transposes && batch_matches(transposed, k, flipped, 0.0);
+            determinants = determinants && fabs(dets[k] - determinant(left)) <= 1e-10 * fabs(dets[k]);
+            destroy(left);
+            destroy(right);
+            destroy(product);
+            destroy(inv);
+            destroy(flipped);
+        }
+        destroyBatch(a);
+        destroyBatch(b);
+        destroyBatch(products);
+        destroyBatch(inverted);
+        destroyBatch(transposed);
+        free(dets);
+    }
+    ASSERT_TRUE(dots, "batchDot() matches dot() for 2, 3, 4, 5, 8 and 9 square matrices.");
+    ASSERT_TRUE(inverses, "batchInverse() matches inverse().");
+    ASSERT_TRUE(determinants, "batchDeterminant() matches determinant().");
+    ASSERT_TRUE(transposes, "batchTranspose() matches transpose().");
+
+    MatrixBatch *wide = random_batch(3, 2, 3);
+    MatrixBatch *tall = random_batch(3, 3, 4);
+    MatrixBatch *products = batchDot(wide, tall);
+    Matrix *left = materialize(batchView(wide, 2));
+    Matrix *right = materialize(batchView(tall, 2));
+    Matrix *expected = dot(left, right);
+    ASSERT_TRUE(products->rows == 2 && products->columns == 4 && batch_matches(products, 2, expected, 1e-12) && batchDot(wide, wide) == NULL && batchInverse(wide) == NULL,
+                "Non-square batches multiply; mismatched shapes and non-square inverses are rejected.");
+
+    MatrixBatch *singular = batchInit(2, 4, 4);
+    for (int i = 0; i < 4; i++)
+        singular->data[16 + i * 4 + i] = 1.0; // matrix 0 is all zeros, matrix 1 the identity
+    MatrixBatch *inverted = batchInverse(singular);
+    ASSERT_TRUE(isnan(inverted->data[0]) && inverted->data[16] == 1.0 && batchView(singular, 2).data == NULL, "A singular matrix inverts to NaN without failing the batch.");
+
+    int agree = 1;
+    for (int n = 2; n <= 5; n++)
+    {
+        MatrixBatch *near = random_batch(2, n, n);
+        for (int i = 0; i < n; i++)
+            near->data[i * n + i] += n; // well conditioned, so only the last row makes it singular
+        for (int j = 0; j < n; j++)
+        {
+            near->data[(size_t)(n - 1) * n + j] = near->data[j] + (j == 0 ? 1e-14 : 0.0); // last row ~ first row
+            for (int i = 0; i < n; i++)
+                near->data[(size_t)n * n + i * n + j] = i == j ? 1e-5 : 0.0; // tiny but regular pivots
+        }
+        MatrixBatch *near_inverses = batchInverse(near);
+        double *near_dets = batchDeterminant(near);
+        Matrix *nearly_singular = materialize(batchView(near, 0));
+        Matrix *small = materialize(batchView(near, 1));
+        Matrix *small_inverse = inverse(small);
+        agree = agree && inverse(nearly_singular) == NULL && isnan(near_inverses->data[0]) && near_dets[0] == 0.0 &&
+                determinant(nearly_singular) == 0.0 && batch_matches(near_inverses, 1, small_inverse, 1e-12 * 1e5) &&
+                fabs(near_dets[1] - determinant(small)) <= 1e-12 * fabs(near_dets[1]) && near_dets[1] != 0.0;
+        destroyBatch(near);
+        destroyBatch(near_inverses);
+        free(near_dets);
+        destroy(nearly_singular);
+        destroy(small);
+        destroy(small_inverse);
+    }
+    ASSERT_TRUE(agree, "Near-singular matrices give NaN inverses and zero determinants, like inverse() and determinant().");
+
+    MatrixBatch *many = random_batch(5000, 4, 4); // above MATRIX_PARALLEL_CUTOFF
+    setThreads(1);
+    MatrixBatch *serial = batchInverse(many);
+    setThreads(4);
+    MatrixBatch *parallel = batchInverse(many);
+    setThreads(0);
+    ASSERT_TRUE(memcmp(serial->data, parallel->data, 5000 * 16 * sizeof(double)) == 0, "Multithreaded batches match the serial result.");
+
+    destroyBatch(wide);
+    destroyBatch(tall);
+    destroyBatch(products);
+    destroy(left);
+    destroy(right);
+    destroy(expected);
+    destroyBatch(singular);
+    destroyBatch(inverted);
+    destroyBatch(many);
+    destroyBatch(serial);
+    destroyBatch(parallel);
+}
+
+void *read_every_tile(void *arg)
+{
+    const DiskMatrix *disk = (const DiskMatrix *)arg;
+    double *tile = (double *)malloc((size_t)disk->tile * disk->tile * sizeof(double));
+    intptr_t mismatches = 0;
+    for (int round = 0; round < 50; round++)
+        for (int i = 0; i < disk->tileRows; i++)
+            for (int j = 0; j < disk->tileColumns; j++)
+            {
+                double index = i * disk->tileColumns + j; // tile (i, j) is filled with its own index
+                mismatches += !diskReadTile(disk, i, j, tile) || tile[0] != index || tile[disk->tile * disk->tile - 1] != index;
+            }
+    free(tile);
+    return (void *)mismatches;
+}
+
+void test_disk_matrix()
+{
+    TEST_CASE("diskCreate(), diskOpen(), toDisk(), fromDisk(), diskDot(), diskTranspose(), & diskScalar()");
+    const char *paths[6] = {"test_disk_a.bin", "test_disk_b.bin", "test_disk_c.bin", "test_disk_d.bin", "test_disk_t.bin", "test_disk_s.bin"};
+    Matrix *a = random(150, 70, -1.0, 1.0); // ragged 32 x 32 tiles in every direction
+    Matrix *b = random(70, 90, -1.0, 1.0);
+    DiskMatrix *diskA = toDisk(a, paths[0], 32);
+    DiskMatrix *diskB = toDisk(b, paths[1], 32);
+    Matrix *back = fromDisk(diskA);
+    ASSERT_TRUE(diskA != NULL && diskA->tileRows == 5 && diskA->tileColumns == 3 && are_matrices_equal(back, a, 0.0), "toDisk() and fromDisk() round-trip a matrix through tiles.");
+
+    Matrix *expected = dot(a, b);
+    DiskMatrix *tight = diskDot(diskA, diskB, paths[2], 5 * 32 * 32 * sizeof(double)); // one result tile per panel
+    DiskMatrix *roomy = diskDot(diskA, diskB, paths[3], 0);
+    Matrix *product_tight = fromDisk(tight);
+    Matrix *product_roomy = fromDisk(roomy);
+    ASSERT_TRUE(are_matrices_equal(product_tight, expected, 1e-12) && are_matrices_equal(product_roomy, expected, 1e-12), "diskDot() matches dot() with a tight and a default memory budget.");
+
+    FILE *stray = NULL;
+    ASSERT_TRUE(diskTranspose(diskA, "test_disk_small.bin", 32 * 32 * sizeof(double) - 1) == NULL && diskScalar(diskA, "test_disk_small.bin", fabs, 2 * 32 * 32 * sizeof(double)) == NULL &&
+                    diskDot(diskA, diskB, "test_disk_small.bin", 4 * 32 * 32 * sizeof(double)) == NULL && (stray = fopen("test_disk_small.bin", "rb")) == NULL,
+                "Budgets below the tiles an operation needs are rejected before any file is created.");
+    if (stray != NULL)
+        fclose(stray);
+
+    DiskMatrix *flipped = diskTranspose(diskA, paths[4], 3 * 32 * 32 * sizeof(double));
+    DiskMatrix *absolute = diskScalar(diskA, paths[5], fabs, 0);
+    Matrix *transposed = fromDisk(flipped);
+    Matrix *scaled = fromDisk(absolute);
+    Matrix *expected_transposed = transpose(a);
+    Matrix *expected_scaled = scalar(a, fabs);
+    ASSERT_TRUE(are_matrices_equal(transposed, expected_transposed, 0.0) && are_matrices_equal(scaled, expected_scaled, 0.0), "diskTranspose() and diskScalar() match transpose() and scalar().");
+
+    diskClose(flipped);
+    DiskMatrix *reopened = diskOpen(paths[4]);
+    Matrix *reread = fromDisk(reopened);
+    save(a, paths[5]);
+    ASSERT_TRUE(reopened != NULL && reopened->rows == 70 && are_matrices_equal(reread, expected_transposed, 0.0) && mmapLoad(paths[4]) == NULL && diskOpen(paths[5]) == NULL && diskDot(diskA, diskA, paths[2], 0) == NULL,
+                "diskOpen() reopens a tiled file; row-major and tiled files are not confused; mismatched shapes are rejected.");
+
+    // 17000 x 17000 in 256 x 256 tiles is a 2.3 GB (sparse) file: the last tile lies past 2 GiB.
+    DiskMatrix *huge = diskCreate("test_disk_huge.bin", 17000, 17000, 0);
+    double *tile = (double *)malloc(256 * 256 * sizeof(double));
+    double *tile_back = (double *)calloc(256 * 256, sizeof(double));
+    for (int k = 0; k < 256 * 256; k++)
+        tile[k] = k * 0.25;
+    int last = huge != NULL ? huge->tileRows - 1 : 0;
+    ASSERT_TRUE(huge != NULL && diskWriteTile(huge, last, last, tile) && diskReadTile(huge, last, last, tile_back) &&
+                    memcmp(tile, tile_back, 256 * 256 * sizeof(double)) == 0 && diskReadTile(huge, 0, 0, tile_back) && tile_back[0] == 0.0,
+                "Tiles beyond 2 GiB are written and read back at their own offset.");
+    diskClose(huge);
+    remove("test_disk_huge.bin");
+
+    DiskMatrix *shared = diskCreate("test_disk_shared.bin", 128, 128, 16);
+    double *fill = (double *)malloc(16 * 16 * sizeof(double));
+    for (int t = 0; shared != NULL && t < 64; t++)
+    {
+        for (int k = 0; k < 16 * 16; k++)
+            fill[k] = t;
+        diskWriteTile(shared, t / 8, t % 8, fill);
+    }
+    pthread_t readers[4];
+    intptr_t mismatches = shared == NULL;
+    for (int t = 0; shared != NULL && t < 4; t++)
+        pthread_create(&readers[t], NULL, read_every_tile, shared);
+    for (int t = 0; shared != NULL && t < 4; t++)
+    {
+        void *result;
+        pthread_join(readers[t], &result);
+        mismatches += (intptr_t)result;
+    }
+    ASSERT_TRUE(mismatches == 0, "Threads reading tiles of the same DiskMatrix at once do not move each other's file offset.");
+    diskClose(shared);
+    remove("test_disk_shared.bin");
+    free(fill);
+    free(tile);
+    free(tile_back);
+
+    diskClose(diskA);
+    diskClose(diskB);
+    diskClose(tight);
+    diskClose(roomy);
+    diskClose(absolute);
+    diskClose(reopened);
+    for (int i = 0; i < 6; i++)
+        remove(paths[i]);
+    destroy(a);
+    destroy(b);
+    destroy(back);
+    destroy(expected);
+    destroy(product_tight);
+    destroy(product_roomy);
+    destroy(transposed);
+    destroy(scaled);
+    destroy(expected_transposed);
+    destroy(expected_scaled);
+    destroy(reread);
+}
+
+void test_arena_and_into()
+{
+    TEST_CASE("arenaInit(), useArena(), arenaReset(), arenaDestroy() & the Into variants");
+    Matrix *a = random(40, 30, -1.0, 1.0);
+    Matrix *b = random(30, 20, -1.0, 1.0);
+    Matrix *expected_product = dot(a, b);
+    Matrix *expected_transpose = transpose(a);
+
+    MatrixArena *arena = arenaInit(4096); // too small for one round: the rest overflows
+    MatrixArena *previous = useArena(arena);
+    Matrix *product = dot(a, b);
+    Matrix *transposed = transpose(a);
+    Matrix *copied = copy(a);
+    ASSERT_TRUE(previous == NULL && product->arena == arena && are_matrices_equal(product, expected_product, 1e-12) && are_matrices_equal(transposed, expected_transpose, 0.0) && are_matrices_equal(copied, a, 0.0),
+                "Matrix-producing functions allocate from the arena in use.");
+    destroy(product); // a no-op for arena matrices
+    ASSERT_TRUE(arena->overflow != NULL && (uintptr_t)copied->data % MATRIX_ALIGNMENT == 0, "Allocations that do not fit overflow and stay aligned.");
+
+    arenaReset(arena);
+    size_t size = arena->size;
+    product = dot(a, b);
+    transposed = transpose(a);
+    copied = copy(a);
+    ASSERT_TRUE(arena->overflow == NULL && arena->size == size && are_matrices_equal(product, expected_product, 1e-12), "After a reset the enlarged block serves the whole round without malloc.");
+    useArena(NULL);
+    Matrix *heap = copy(a);
+    ASSERT_TRUE(heap->arena == NULL, "useArena(NULL) goes back to calloc.");
+    arenaDestroy(arena);
+
+    Matrix *destination = init(40, 20);
+    Matrix *flipped = init(30, 40);
+    Matrix *part = init(10, 5);
+    Matrix *stacked = init(80, 30);
+    Matrix *expected_stacked = join(a, a, false);
+    Matrix *expected_part = slice(a, 3, 13, 7, 12);
+    ASSERT_TRUE(dotInto(destination, a, b) && are_matrices_equal(destination, expected_product, 1e-12) &&
+                    transposeInto(flipped, a) && are_matrices_equal(flipped, expected_transpose, 0.0) &&
+                    sliceInto(part, a, 3, 7) && are_matrices_equal(part, expected_part, 0.0) &&
+                    joinInto(stacked, a, a, false) && are_matrices_equal(stacked, expected_stacked, 0.0),
+                "dotInto(), transposeInto(), sliceInto() and joinInto() write into preallocated matrices.");
+
+    Matrix *expected_root = scalar(a, fabs);
+    Matrix *expected_sum = elementwise(a, a, add_values);
+    Matrix *in_place = copy(a);
+    Matrix *sum = init(40, 30);
+    ASSERT_TRUE(scalarInto(in_place, in_place, fabs) && are_matrices_equal(in_place, expected_root, 0.0) &&
+                    elementwiseInto(sum, a, a, add_values) && are_matrices_equal(sum, expected_sum, 0.0) && copyInto(sum, in_place) && are_matrices_equal(sum, in_place, 0.0),
+                "scalarInto() works in place; elementwiseInto() and copyInto() write into existing matrices.");
+    double field[40];
+    for (int i = 0; i < 40; i++)
+        field[i] = i + 0.5;
+    Matrix *expected_wider = insertField(a, 4, true, field);
+    Matrix *expected_shorter = discardField(a, 39, false);
+    Matrix *wider = init(40, 31);
+    Matrix *shorter = init(39, 30);
+    ASSERT_TRUE(insertFieldInto(wider, a, 4, true, field) && are_matrices_equal(wider, expected_wider, 0.0) && wider->grid[7][4] == 7.5 &&
+                    discardFieldInto(shorter, a, 39, false) && are_matrices_equal(shorter, expected_shorter, 0.0),
+                "insertFieldInto() and discardFieldInto() write into preallocated matrices.");
+    ASSERT_TRUE(!insertFieldInto(wider, a, 0, false, field) && !discardFieldInto(shorter, a, 0, true) && !insertFieldInto(a, a, 0, true, field),
+                "insertFieldInto() and discardFieldInto() reject mismatched shapes and aliasing.");
+
+    ASSERT_TRUE(!dotInto(destination, a, a) && !transposeInto(a, a) && !sliceInto(part, a, 35, 0) && !copyInto(b, a) && !dotInto(destination, destination, b),
+                "Into variants reject mismatched shapes and aliasing.");
+
+    destroy(a);
+    destroy(b);
+    destroy(expected_product);
+    destroy(expected_transpose);
+    destroy(heap);
+    destroy(destination);
+    destroy(flipped);
+    destroy(part);
+    destroy(stacked);
+    destroy(expected_stacked);
+    destroy(expected_part);
+    destroy(expected_root);
+    destroy(expected_sum);
+    destroy(in_place);
+    destroy(sum);
+    destroy(expected_wider);
+    destroy(expected_shorter);
+    destroy(wider);
+    destroy(shorter);
+}
+
+void test_in_place_growth()
+{
+    TEST_CASE("reserve(), insertFieldInPlace(), discardFieldInPlace() & joinInPlace()");
+    Matrix *a = random(5, 4, -1.0, 1.0);
+    Matrix *grown = copy(a);
+    Matrix *expected = copy(a);
+    int reallocations = 0, capacity = grown->capacity;
+    for (int i = 0; i < 1000; i++)
+    {
+        double row[4] = {i, -i, 0.5 * i, 1.0};
+        Matrix *single = init(1, 4);
+        memcpy(single->grid[0], row, sizeof(row));
+        Matrix *next = join(expected, single, false);
+        destroy(expected);
+        destroy(single);
+        expected = next;
+        insertFieldInPlace(grown, grown->rows, false, row);
+        reallocations += grown->capacity != capacity;
+        capacity = grown->capacity;
+    }
+    ASSERT_TRUE(are_matrices_equal(grown, expected, 0.0), "Appending rows in place matches join().");
+    ASSERT_TRUE(reallocations <= 8 && grown->capacity >= grown->rows && grown->capacity < 2 * grown->rows, "Row capacity grows geometrically.");
+
+    double column[5] = {1, 2, 3, 4, 5};
+    Matrix *narrow = copy(a);
+    Matrix *expected_wide = insertField(a, 2, true, column);
+    ASSERT_TRUE(insertFieldInPlace(narrow, 2, true, column) && are_matrices_equal(narrow, expected_wide, 0.0) && narrow->stride == 8,
+                "Inserting a column shifts the tail of each row and doubles the stride.");
+    Matrix *expected_narrow = discardField(expected_wide, 0, true);
+    Matrix *expected_short = discardField(expected_narrow, 3, false);
+    ASSERT_TRUE(discardFieldInPlace(narrow, 0, true) && discardFieldInPlace(narrow, 3, false) && are_matrices_equal(narrow, expected_short, 0.0),
+                "discardFieldInPlace() matches discardField().");
+
+    Matrix *b = random(4, 6, -1.0, 1.0);
+    Matrix *compact = copy(narrow);
+    Matrix *expected_product = dot(compact, b);
+    Matrix *product = dot(narrow, b);
+    MatrixView window = sliceView(view(narrow), 1, 3, 1, 4);
+    ASSERT_TRUE(narrow->stride > narrow->columns && compact->stride == compact->columns && are_matrices_equal(product, expected_product, 1e-12) && window.rowStride == narrow->stride && window.data[0] == narrow->grid[1][1],
+                "Views and products still work on a matrix with spare column capacity.");
+
+    Matrix *twice = copy(a);
+    Matrix *expected_twice = join(a, a, true);
+    ASSERT_TRUE(joinInPlace(twice, twice, true) && are_matrices_equal(twice, expected_twice, 0.0) && !joinInPlace(twice, b, false),
+                "joinInPlace() appends a matrix to itself and rejects mismatched shapes.");
+    Matrix *reserved = init(2, 2);
+    Matrix *lone = init(1, 3);
+    double **grid = NULL;
+    ASSERT_TRUE(reserve(reserved, 100, 2) && (grid = reserved->grid) != NULL && insertFieldInPlace(reserved, 0, false, column) && reserved->grid == grid && !discardFieldInPlace(lone, 0, false),
+                "reserve() makes later appends allocation-free; the last row cannot be discarded.");
+
+    Matrix *duplicated = copy(a); // full, so the first insertion reallocates
+    Matrix *expected_duplicated = insertField(a, 0, false, a->grid[1]);
+    Matrix *expected_again = insertField(expected_duplicated, 0, false, expected_duplicated->grid[3]);
+    ASSERT_TRUE(insertFieldInPlace(duplicated, 0, false, duplicated->grid[1]) && are_matrices_equal(duplicated, expected_duplicated, 0.0) &&
+                    insertFieldInPlace(duplicated, 0, false, duplicated->grid[3]) && are_matrices_equal(duplicated, expected_again, 0.0),
+                "insertFieldInPlace() copies a row of the matrix itself before growing or shifting.");
+    destroy(duplicated);
+    destroy(expected_duplicated);
+    destroy(expected_again);
+
+    destroy(a);
+    destroy(grown);
+    destroy(expected);
+    destroy(narrow);
+    destroy(expected_wide);
+    destroy(expected_narrow);
+    destroy(expected_short);
+    destroy(b);
+    destroy(expected_product);
+    destroy(product);
+    destroy(twice);
+    destroy(expected_twice);
+    destroy(reserved);
+    destroy(lone);
+    destroy(compact);
+}
+
 int main()
 {
     printf(BOLD BLUE "Starting matrix library test suite...\n" RESET);
@@ -344,6 +1261,34 @@ int main()
     test_dot_determinant_inverse();
     printf("\n");
     test_meshgrid();
+    printf("\n");
+    test_contiguous_views();
+    printf("\n");
+    test_gemm();
+    printf("\n");
+    test_thread_pool();
+    printf("\n");
+    test_lu_factor();
+    printf("\n");
+    test_sparse_matrix();
+    printf("\n");
+    test_sparse_triplets();
+    printf("\n");
+    test_expressions();
+    printf("\n");
+    test_save_mmap_load();
+    printf("\n");
+    test_blocked_transpose();
+    printf("\n");
+    test_strassen();
+    printf("\n");
+    test_matrix_batch();
+    printf("\n");
+    test_disk_matrix();
+    printf("\n");
+    test_arena_and_into();
+    printf("\n");
+    test_in_place_growth();
     printf(BOLD BLUE "\nTest suite finished.\n" RESET);
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,300 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "adt_Matrix.h"
+#include "adt_TypedMatrix.h"
+
+#define RESET "\033[0m"
+#define RED "\033[31m"
+#define GREEN "\033[32m"
+#define YELLOW "\033[33m"
+#define BLUE "\033[34m"
+#define BOLD "\033[1m"
+
+#define TEST_CASE(name)                                                \
+    printf(BOLD YELLOW "--- Running Test Case: %s ---\n" RESET, name); \
+    int test_passed = 1;
+
+#define ASSERT_TRUE(condition, message)                  \
+    if (!(condition))                                    \
+    {                                                    \
+        printf(RED "[FAILED] " RESET "%s\n", message);   \
+        test_passed = 0;                                 \
+    }                                                    \
+    else                                                 \
+    {                                                    \
+        printf(GREEN "[PASSED] " RESET "%s\n", message); \
+    }
+
+DEFINE_MATRIX(I8Matrix, int8_t, int32_t)
+DEFINE_MATRIX_WIDE(I8Matrix, I32Matrix)
+
+static float negate_float(float x)
+{
+    return -x;
+}
+
+static int32_t max_int(int32_t a, int32_t b)
+{
+    return a > b ? a : b;
+}
+
+void test_f32_matrix()
+{
+    TEST_CASE("F32Matrix: init(), populate(), slice(), join(), transpose(), scalar(), & dot()");
+    F32Matrix *m = F32Matrix_populate(2, 3, (float[]){1, 2, 3, 4, 5, 6});
+    ASSERT_TRUE(m != NULL && F32Matrix_get(m, 1, 2) == 6.0f && ((uintptr_t)m->data % TYPED_MATRIX_ALIGNMENT) == 0,
+                "populate() stores the elements in aligned, contiguous storage.");
+
+    F32Matrix *t = F32Matrix_transpose(m);
+    F32Matrix *product = F32Matrix_dot(m, t);
+    ASSERT_TRUE(product->rows == 2 && product->columns == 2 && product->grid[0][0] == 14.0f && product->grid[0][1] == 32.0f &&
+                    product->grid[1][1] == 77.0f,
+                "dot() with the transpose computes M * M^T.");
+
+    F32Matrix *joined = F32Matrix_join(m, m, true);
+    F32Matrix *sliced = F32Matrix_slice(joined, 0, 2, 2, 4);
+    ASSERT_TRUE(sliced->grid[0][0] == 3.0f && sliced->grid[0][1] == 1.0f && sliced->grid[1][1] == 4.0f,
+                "join() and slice() match their double-precision counterparts.");
+
+    F32Matrix *negated = F32Matrix_scalar(m, negate_float);
+    ASSERT_TRUE(negated->grid[1][0] == -4.0f && F32Matrix_dot(m, m) == NULL, "scalar() applies the function and dot() rejects bad shapes.");
+
+    F32Matrix *a = F32Matrix_random(133, 301, -1.0, 1.0); // odd sizes exercise the padded panels
+    F32Matrix *b = F32Matrix_random(301, 77, -1.0, 1.0);
+    F64Matrix *a64 = F32Matrix_toF64Matrix(a);
+    F64Matrix *b64 = F32Matrix_toF64Matrix(b);
+    F64Matrix *expected = F64Matrix_dot(a64, b64);
+    setThreads(4);
+    F32Matrix *threaded = F32Matrix_dot(a, b);
+    setThreads(1);
+    F32Matrix *serial = F32Matrix_dot(a, b);
+    bool close = threaded != NULL && serial != NULL && memcmp(threaded->data, serial->data, sizeof(float) * 133 * 77) == 0;
+    for (int i = 0; close && i < 133; i++)
+        for (int j = 0; j < 77; j++)
+            close = close && fabs(serial->grid[i][j] - expected->grid[i][j]) <= 1e-4 * 301;
+    ASSERT_TRUE(close, "dot() through the packed float GEMM matches the double product, serial and on 4 threads.");
+
+    F32Matrix_destroy(a);
+    F32Matrix_destroy(b);
+    F64Matrix_destroy(a64);
+    F64Matrix_destroy(b64);
+    F64Matrix_destroy(expected);
+    F32Matrix_destroy(threaded);
+    F32Matrix_destroy(serial);
+    F32Matrix_destroy(m);
+    F32Matrix_destroy(t);
+    F32Matrix_destroy(product);
+    F32Matrix_destroy(joined);
+    F32Matrix_destroy(sliced);
+    F32Matrix_destroy(negated);
+}
+
+void test_i32_matrix()
+{
+    TEST_CASE("I32Matrix and I8Matrix: wide accumulation, elementwise(), getField(), swapField(), & reshape()");
+    I32Matrix *a = I32Matrix_fill(1, 4, 2000000000);
+    I32Matrix *b = I32Matrix_populate(4, 1, (int32_t[]){1, 1, -1, -1});
+    I32Matrix *product = I32Matrix_dot(a, b);
+    ASSERT_TRUE(product->grid[0][0] == 0, "dot() accumulates in int64_t, so intermediate sums above INT32_MAX do not overflow.");
+
+    I8Matrix *row = I8Matrix_fill(1, 64, 100);
+    I8Matrix *signs = I8Matrix_fill(64, 1, 1);
+    for (int i = 32; i < 64; i++)
+        I8Matrix_set(signs, i, 0, -1);
+    I8Matrix_set(signs, 0, 0, 0);
+    I8Matrix *dot8 = I8Matrix_dot(row, signs);
+    ASSERT_TRUE(dot8->grid[0][0] == -100, "A user-defined int8_t matrix accumulates in int32_t (partial sums reach 3100).");
+
+    I32Matrix *c = I32Matrix_populate(2, 2, (int32_t[]){1, 7, 5, 3});
+    I32Matrix *d = I32Matrix_populate(2, 2, (int32_t[]){4, 2, 6, 8});
+    I32Matrix *maximum = I32Matrix_elementwise(c, d, max_int);
+    int32_t *column = I32Matrix_getField(maximum, 1, true);
+    ASSERT_TRUE(column[0] == 7 && column[1] == 8, "elementwise() and getField() work on integers.");
+
+    I32Matrix *left = I32Matrix_random(150, 300, -1000.0, 1000.0); // crosses the MC, KC and NC block edges
+    I32Matrix *right = I32Matrix_random(300, 270, -1000.0, 1000.0);
+    I32Matrix *blocked = I32Matrix_dot(left, right);
+    bool exact = blocked != NULL;
+    for (int i = 0; exact && i < 150; i++)
+        for (int j = 0; j < 270; j++)
+        {
+            int64_t sum = 0;
+            for (int k = 0; k < 300; k++)
+                sum += (int64_t)left->grid[i][k] * right->grid[k][j];
+            exact = exact && blocked->grid[i][j] == (int32_t)sum;
+        }
+    ASSERT_TRUE(exact, "The cache-blocked integer dot() matches a reference triple loop.");
+
+    I32Matrix *big = I32Matrix_fill(3, 300, 2000000000);
+    I32Matrix *ones = I32Matrix_fill(300, 2, 1);
+    I32Matrix_set(ones, 0, 1, -1);
+    I64Matrix *wide = I32Matrix_dotWide(big, ones);
+    ASSERT_TRUE(wide != NULL && wide->grid[2][0] == 600000000000LL && wide->grid[2][1] == 596000000000LL,
+                "dotWide() returns int64_t sums far past INT32_MAX instead of narrowing them to int32_t.");
+    I8Matrix *row8 = I8Matrix_fill(1, 64, 100);
+    I8Matrix *column8 = I8Matrix_fill(64, 1, 100);
+    I32Matrix *wide8 = I8Matrix_dotWide(row8, column8);
+    ASSERT_TRUE(wide8 != NULL && wide8->grid[0][0] == 640000, "An int8_t matrix paired with I32Matrix returns its int32_t sums from dotWide().");
+
+    I32Matrix_swapField(c, 0, 1, false);
+    I32Matrix *reshaped = I32Matrix_reshape(c, 1, 4);
+    ASSERT_TRUE(reshaped->grid[0][0] == 5 && reshaped->grid[0][3] == 7, "swapField() and reshape() move whole rows.");
+
+    I32Matrix_destroy(a);
+    I32Matrix_destroy(b);
+    I32Matrix_destroy(product);
+    I8Matrix_destroy(row);
+    I8Matrix_destroy(signs);
+    I8Matrix_destroy(dot8);
+    I32Matrix_destroy(c);
+    I32Matrix_destroy(d);
+    I32Matrix_destroy(maximum);
+    free(column);
+    I32Matrix_destroy(reshaped);
+    I32Matrix_destroy(left);
+    I32Matrix_destroy(right);
+    I32Matrix_destroy(blocked);
+    I32Matrix_destroy(big);
+    I32Matrix_destroy(ones);
+    I64Matrix_destroy(wide);
+    I8Matrix_destroy(row8);
+    I8Matrix_destroy(column8);
+    I32Matrix_destroy(wide8);
+}
+
+void test_conversions()
+{
+    TEST_CASE("F64Matrix_toF32Matrix(), F32Matrix_toI32Matrix(), I32Matrix_toF64Matrix(), _fromMatrix(), & _toMatrix()");
+    Matrix *source = populate(2, 2, (double[]){1.75, -2.5, 3.0, 1e-10});
+    F64Matrix *f64 = F64Matrix_fromMatrix(source);
+    F32Matrix *f32 = F64Matrix_toF32Matrix(f64);
+    ASSERT_TRUE(f32->grid[0][0] == 1.75f && f32->grid[1][1] == 1e-10f, "F64 to F32 rounds to the nearest float.");
+
+    I32Matrix *i32 = F32Matrix_toI32Matrix(f32);
+    ASSERT_TRUE(i32->grid[0][0] == 1 && i32->grid[0][1] == -2 && i32->grid[1][0] == 3, "F32 to I32 truncates toward zero.");
+
+    F64Matrix *back = I32Matrix_toF64Matrix(i32);
+    Matrix *dense = F64Matrix_toMatrix(back);
+    ASSERT_TRUE(dense->grid[0][1] == -2.0 && dense->grid[1][1] == 0.0, "I32 to F64 and F64 to Matrix are exact.");
+
+    destroy(source);
+    F64Matrix_destroy(f64);
+    F32Matrix_destroy(f32);
+    I32Matrix_destroy(i32);
+    F64Matrix_destroy(back);
+    destroy(dense);
+}
+
+static int32_t add_index(int32_t i, int32_t j)
+{
+    return 10 * i + j;
+}
+
+static float halve_float(float x)
+{
+    return x / 2.0f;
+}
+
+static float add_float(float a, float b)
+{
+    return a + b;
+}
+
+void test_typed_api()
+{
+    TEST_CASE("insertField(), discardField(), shuffle(), meshgrid(), scalarField(), elementwiseField(), determinant(), & inverse()");
+    I32Matrix *grid = I32Matrix_meshgrid(3, 4, add_index);
+    I32Matrix *wider = I32Matrix_insertField(grid, 1, true, (int32_t[]){-1, -2, -3});
+    I32Matrix *taller = I32Matrix_insertField(wider, 99, false, (int32_t[]){7, 7, 7, 7, 7});
+    I32Matrix *shorter = I32Matrix_discardField(taller, 0, false);
+    ASSERT_TRUE(grid->grid[2][3] == 23 && wider->columns == 5 && wider->grid[2][1] == -3 && wider->grid[2][2] == 21 &&
+                    taller->rows == 4 && taller->grid[3][4] == 7 && shorter->rows == 3 && shorter->grid[0][0] == 10,
+                "meshgrid(), insertField() and discardField() match their Matrix counterparts, with clamped indices.");
+
+    I32Matrix *shuffled = I32Matrix_shuffle(grid);
+    long long sum = 0, shuffled_sum = 0;
+    for (int k = 0; k < 12; k++)
+    {
+        sum += grid->data[k];
+        shuffled_sum += shuffled->data[k];
+    }
+    ASSERT_TRUE(shuffled->rows == 3 && shuffled->columns == 4 && sum == shuffled_sum, "shuffle() permutes the elements.");
+
+    F32Matrix *m = F32Matrix_populate(2, 3, (float[]){1, 2, 3, 4, 5, 6});
+    float *halves = F32Matrix_scalarField(m, 2, true, halve_float);
+    float *sums = F32Matrix_elementwiseField(m, 1, false, (float[]){1, 1, 1}, add_float);
+    ASSERT_TRUE(halves[0] == 1.5f && halves[1] == 3.0f && sums[0] == 5.0f && sums[2] == 7.0f, "scalarField() and elementwiseField() return new arrays.");
+
+    Matrix *dense = random(6, 6, -1.0, 1.0);
+    F64Matrix *typed = F64Matrix_fromMatrix(dense);
+    Matrix *expected = inverse(dense);
+    F64Matrix *inverted = F64Matrix_inverse(typed);
+    bool close = fabs(F64Matrix_determinant(typed) - determinant(dense)) <= 1e-12 * (1.0 + fabs(determinant(dense)));
+    for (int i = 0; close && i < 6; i++)
+        for (int j = 0; j < 6; j++)
+            close = close && fabs(inverted->grid[i][j] - expected->grid[i][j]) <= 1e-9 * (1.0 + fabs(expected->grid[i][j]));
+    I32Matrix *unimodular = I32Matrix_populate(2, 2, (int32_t[]){2, 1, 1, 1});
+    I32Matrix *integral = I32Matrix_inverse(unimodular);
+    I32Matrix *singular = I32Matrix_fill(2, 2, 3);
+    ASSERT_TRUE(close && I32Matrix_determinant(unimodular) == 1.0 && integral->grid[0][0] == 1 && integral->grid[0][1] == -1 &&
+                    integral->grid[1][1] == 2 && I32Matrix_inverse(singular) == NULL && I32Matrix_determinant(singular) == 0.0,
+                "determinant() and inverse() agree with Matrix, round integer inverses, and reject singular matrices.");
+    I32Matrix_traverse(integral);
+
+    I32Matrix *doubled = I32Matrix_populate(3, 3, (int32_t[]){2, 0, 0, 0, 2, 0, 0, 0, 2});
+    F64Matrix *near_singular = F64Matrix_populate(2, 2, (double[]){1.0, 1.0, 1.0, 1.0 + 1e-14});
+    Matrix *near_singular_dense = F64Matrix_toMatrix(near_singular);
+    ASSERT_TRUE(I32Matrix_inverse(doubled) == NULL && I32Matrix_determinant(doubled) == 8.0,
+                "inverse() rejects an integer matrix whose inverse is not integral (2 * I).");
+    ASSERT_TRUE(F64Matrix_inverse(near_singular) == NULL && F64Matrix_determinant(near_singular) == 0.0 &&
+                    inverse(near_singular_dense) == NULL,
+                "inverse() and determinant() treat pivots below 1e-12 as singular, like Matrix.");
+
+    Matrix *right = random(6, 9, -1.0, 1.0);
+    F64Matrix *typed_right = F64Matrix_fromMatrix(right);
+    Matrix *expected_product = dot(dense, right);
+    F64Matrix *product = F64Matrix_dot(typed, typed_right);
+    bool same = product != NULL;
+    for (int i = 0; same && i < 6; i++)
+        for (int j = 0; j < 9; j++)
+            same = same && fabs(product->grid[i][j] - expected_product->grid[i][j]) <= 1e-12;
+    ASSERT_TRUE(same, "F64Matrix dot() runs through gemm() and matches dot().");
+
+    I32Matrix_destroy(grid);
+    I32Matrix_destroy(wider);
+    I32Matrix_destroy(taller);
+    I32Matrix_destroy(shorter);
+    I32Matrix_destroy(shuffled);
+    F32Matrix_destroy(m);
+    free(halves);
+    free(sums);
+    destroy(dense);
+    F64Matrix_destroy(typed);
+    destroy(expected);
+    F64Matrix_destroy(inverted);
+    I32Matrix_destroy(unimodular);
+    I32Matrix_destroy(integral);
+    I32Matrix_destroy(singular);
+    I32Matrix_destroy(doubled);
+    F64Matrix_destroy(near_singular);
+    destroy(near_singular_dense);
+    destroy(right);
+    F64Matrix_destroy(typed_right);
+    destroy(expected_product);
+    F64Matrix_destroy(product);
+}
+
+int main()
+{
+    printf(BOLD BLUE "Starting typed matrix test suite...\n" RESET);
+    test_f32_matrix();
+    printf("\n");
+    test_i32_matrix();
+    printf("\n");
+    test_conversions();
+    printf("\n");
+    test_typed_api();
+    printf(BOLD BLUE "\nTest suite finished.\n" RESET);
+    return 0;
+}
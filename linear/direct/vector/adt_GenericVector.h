@@ -0,0 +1,892 @@
+#ifndef GENERIC_VECTOR_H
+#define GENERIC_VECTOR_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief Length of the runs that merge sort builds with insertion sort before merging.
+ * @note Define this before including the header to override the default. Shared with adt_Vector.h.
+ */
+#ifndef MERGE_SORT_CUTOFF
+#define MERGE_SORT_CUTOFF 32
+#endif
+
+/**
+ * @brief Range length below which quick sort hands over to insertion sort.
+ * @note Define this before including the header to override the default. Shared with adt_Vector.h.
+ */
+#ifndef QUICK_SORT_CUTOFF
+#define QUICK_SORT_CUTOFF 16
+#endif
+
+/**
+ * @brief Default strict weak ordering used by DEFINE_VECTOR.
+ * @param a The left operand.
+ * @param b The right operand.
+ * @note Works for any type with a built-in `<` operator.
+ */
+#define VECTOR_LESS(a, b) ((a) < (b))
+
+/**
+ * @brief Defines a typed vector `name` of elements `T` ordered by the built-in `<` operator.
+ * @param name The name of the generated struct; also the prefix of every generated function.
+ * @param T The element type.
+ * @note See DEFINE_VECTOR_CMP for the generated API.
+ */
+#define DEFINE_VECTOR(name, T) DEFINE_VECTOR_CMP(name, T, VECTOR_LESS)
+
+/**
+ * @brief Defines a typed vector `name` of elements `T` ordered by a custom comparator.
+ * @param name The name of the generated struct; also the prefix of every generated function.
+ * @param T The element type. Any copyable type works, including structs.
+ * @param less A function-like macro or inline function `less(a, b)` that returns true when `a`
+ * orders strictly before `b`. Two elements are equal when neither orders before the other.
+ * @details Generates `name_init`, `name_copy`, `name_clear`, `name_destroy`, `name_slice`,
+ * `name_join`, `name_isEmpty`, `name_get`, `name_set`, `name_append`, `name_insert`, `name_pop`,
+ * `name_discard`, `name_populate`, `name_fill`, `name_reverse`, `name_shuffle`,
+ * `name_linearSearch`, `name_binarySearch`, `name_ternarySearch`, `name_jumpSearch`,
+ * `name_bubbleSort`, `name_selectionSort`, `name_insertionSort`, `name_heapSort`,
+ * `name_mergeSort`, `name_quickSort`, `name_map`, `name_filter`, `name_max`, `name_min`,
+ * `name_count`, `name_contains`, `name_replace`, `name_reserve`, `name_shrinkToFit`,
+ * `name_insertRange`, `name_eraseRange`, `name_eraseIf`, `name_popAll`, `name_nthElement`,
+ * `name_partialSort` and `name_topK`, with the same semantics as their counterparts in
+ * adt_Vector.h. The comparator is expanded inline into every search and sort, so the compiler
+ * specializes them for `T` instead of calling through a function pointer.
+ * @note Limitations: interpolationSearch needs arithmetic on keys (see
+ * DEFINE_VECTOR_INTERPOLATION) and sum, prod, any and all need arithmetic on elements (see
+ * DEFINE_VECTOR_ARITHMETIC). The following are intentionally left out: traverse, which has no
+ * printf format for an arbitrary `T`; countSort and radixSort, which index by integer key and
+ * have no comparator form; parallelSort, which depends on POSIX threads; and the SIMD reductions
+ * and 64-bit variants, which are specific to `int`. nthElement picks pivots by median of three
+ * rather than the Floyd-Rivest sampling in adt_Vector.h, so the header needs no libm.
+ */
+#define DEFINE_VECTOR_CMP(name, T, less)                                                        \
+    typedef struct                                                                              \
+    {                                                                                           \
+        T *array;                                                                               \
+        int length;                                                                             \
+        int capacity;                                                                           \
+    } name;                                                                                     \
+                                                                                                \
+    name name##_init(const int capacity)                                                        \
+    {                                                                                           \
+        if (capacity <= 0)                                                                      \
+        {                                                                                       \
+            perror("Invalid capacity for " #name);                                              \
+            exit(EXIT_FAILURE);                                                                 \
+        }                                                                                       \
+        name result;                                                                            \
+        result.array = (T *)malloc(capacity * sizeof(T));                                       \
+        if (result.array == NULL)                                                               \
+        {                                                                                       \
+            perror("Failed to initialize " #name);                                              \
+            exit(EXIT_FAILURE);                                                                 \
+        }                                                                                       \
+        result.length = 0;                                                                      \
+        result.capacity = capacity;                                                             \
+        return result;                                                                          \
+    }                                                                                           \
+                                                                                                \
+    name name##_copy(const name *vector)                                                        \
+    {                                                                                           \
+        if (vector == NULL)                                                                     \
+            return name##_init(1);                                                              \
+        name copied = name##_init(vector->capacity);                                            \
+        memcpy(copied.array, vector->array, vector->length * sizeof(T));                        \
+        copied.length = vector->length;                                                         \
+        return copied;                                                                          \
+    }                                                                                           \
+                                                                                                \
+    void name##_clear(name *vector)                                                             \
+    {                                                                                           \
+        if (vector == NULL)                                                                     \
+            return;                                                                             \
+        vector->length = 0;                                                                     \
+    }                                                                                           \
+                                                                                                \
+    void name##_destroy(name *vector)                                                           \
+    {                                                                                           \
+        if (vector == NULL)                                                                     \
+            return;                                                                             \
+        free(vector->array);                                                                    \
+        vector->array = NULL;                                                                   \
+        vector->length = 0;                                                                     \
+        vector->capacity = 0;                                                                   \
+    }                                                                                           \
+                                                                                                \
+    name name##_slice(const name *vector, const int start, const int end)                       \
+    {                                                                                           \
+        if (vector == NULL || start < 0 || end > vector->length || start >= end)                \
+            return name##_init(1);                                                              \
+        name sliced = name##_init(end - start);                                                 \
+        memcpy(sliced.array, vector->array + start, (end - start) * sizeof(T));                 \
+        sliced.length = end - start;                                                            \
+        return sliced;                                                                          \
+    }                                                                                           \
+                                                                                                \
+    name name##_join(const name *front, const name *rear)                                       \
+    {                                                                                           \
+        if (front == NULL || rear == NULL)                                                      \
+            return name##_init(1);                                                              \
+        name joined = name##_init(front->length + rear->length + 1);                            \
+        memcpy(joined.array, front->array, front->length * sizeof(T));                          \
+        memcpy(joined.array + front->length, rear->array, rear->length * sizeof(T));            \
+        joined.length = front->length + rear->length;                                           \
+        return joined;                                                                          \
+    }                                                                                           \
+                                                                                                \
+    bool name##_isEmpty(const name *vector)                                                     \
+    {                                                                                           \
+        if (vector == NULL)                                                                     \
+            return true;                                                                        \
+        return vector->length == 0;                                                             \
+    }                                                                                           \
+                                                                                                \
+    T name##_get(const name *vector, const int index)                                           \
+    {                                                                                           \
+        T zero = {0};                                                                           \
+        if (vector == NULL || index < 0 || index >= vector->length)                             \
+            return zero;                                                                        \
+        return vector->array[index];                                                            \
+    }                                                                                           \
+                                                                                                \
+    void name##_set(name *vector, const T value, const int index)                               \
+    {                                                                                           \
+        if (vector == NULL || index < 0 || index >= vector->length)                             \
+            return;                                                                             \
+        vector->array[index] = value;                                                           \
+    }                                                                                           \
+                                                                                                \
+    void __##name##_expand__(name *vector)                                                      \
+    {                                                                                           \
+        int newCapacity = vector->capacity == 0 ? 1 : vector->capacity * 2;                     \
+        T *newArray = (T *)realloc(vector->array, newCapacity * sizeof(T));                     \
+        if (newArray == NULL)                                                                   \
+        {                                                                                       \
+            perror("Failed to expand " #name);                                                  \
+            exit(EXIT_FAILURE);                                                                 \
+        }                                                                                       \
+        vector->array = newArray;                                                               \
+        vector->capacity = newCapacity;                                                         \
+    }                                                                                           \
+                                                                                                \
+    void name##_append(name *vector, const T value)                                             \
+    {                                                                                           \
+        if (vector == NULL)                                                                     \
+            return;                                                                             \
+        if (vector->length == vector->capacity)                                                 \
+            __##name##_expand__(vector);                                                        \
+        vector->array[vector->length++] = value;                                                \
+    }                                                                                           \
+                                                                                                \
+    void name##_insert(name *vector, const T value, const int index)                            \
+    {                                                                                           \
+        if (vector == NULL || index < 0 || index > vector->length)                              \
+            return;                                                                             \
+        if (vector->length == vector->capacity)                                                 \
+            __##name##_expand__(vector);                                                        \
+        memmove(vector->array + index + 1, vector->array + index,                               \
+                (vector->length - index) * sizeof(T));                                          \
+        vector->array[index] = value;                                                           \
+        vector->length++;                                                                       \
+    }                                                                                           \
+                                                                                                \
+    T name##_discard(name *vector, const int index)                                             \
+    {                                                                                           \
+        T value = name##_get(vector, index);                                                    \
+        if (vector == NULL || index < 0 || index >= vector->length)                             \
+            return value;                                                                       \
+        memmove(vector->array + index, vector->array + index + 1,                               \
+                (vector->length - index - 1) * sizeof(T));                                      \
+        vector->length--;                                                                       \
+        return value;                                                                           \
+    }                                                                                           \
+                                                                                                \
+    int name##_linearSearch(const name *vector, const T value, const int index)                 \
+    {                                                                                           \
+        if (vector == NULL || index < 0 || index >= vector->length)                             \
+            return -1;                                                                          \
+        for (int i = index; i < vector->length; i++)                                            \
+            if (!less(vector->array[i], value) && !less(value, vector->array[i]))               \
+                return i;                                                                       \
+        return -1;                                                                              \
+    }                                                                                           \
+                                                                                                \
+    void name##_pop(name *vector, const T value)                                                \
+    {                                                                                           \
+        int index = name##_linearSearch(vector, value, 0);                                      \
+        if (index >= 0)                                                                         \
+            name##_discard(vector, index);                                                      \
+    }                                                                                           \
+                                                                                                \
+    name name##_populate(const T *array, const int length)                                      \
+    {                                                                                           \
+        if (array == NULL || length <= 0)                                                       \
+        {                                                                                       \
+            perror("Invalid input for " #name "_populate");                                     \
+            exit(EXIT_FAILURE);                                                                 \
+        }                                                                                       \
+        name result = name##_init(length);                                                      \
+        memcpy(result.array, array, length * sizeof(T));                                        \
+        result.length = length;                                                                 \
+        return result;                                                                          \
+    }                                                                                           \
+                                                                                                \
+    void name##_fill(name *vector, const int quantity, const T value)                           \
+    {                                                                                           \
+        if (vector == NULL || quantity < 0)                                                     \
+            return;                                                                             \
+        name##_clear(vector);                                                                   \
+        for (int i = 0; i < quantity; i++)                                                      \
+            name##_append(vector, value);                                                       \
+    }                                                                                           \
+                                                                                                \
+    void __##name##_swap__(T *a, T *b)                                                          \
+    {                                                                                           \
+        T temp = *a;                                                                            \
+        *a = *b;                                                                                \
+        *b = temp;                                                                              \
+    }                                                                                           \
+                                                                                                \
+    void name##_reverse(name *vector)                                                           \
+    {                                                                                           \
+        if (vector == NULL || vector->length <= 1)                                              \
+            return;                                                                             \
+        for (int i = 0; i < vector->length / 2; i++)                                            \
+            __##name##_swap__(&vector->array[i], &vector->array[vector->length - i - 1]);        \
+    }                                                                                           \
+                                                                                                \
+    void name##_shuffle(name *vector)                                                           \
+    {                                                                                           \
+        static int seeded = 0;                                                                  \
+        if (vector == NULL || vector->length <= 1)                                              \
+            return;                                                                             \
+        if (!seeded)                                                                            \
+        {                                                                                       \
+            srand((unsigned int)time(NULL));                                                    \
+            seeded = 1;                                                                         \
+        }                                                                                       \
+        for (int i = vector->length - 1; i > 0; i--)                                            \
+            __##name##_swap__(&vector->array[i], &vector->array[rand() % (i + 1)]);             \
+    }                                                                                           \
+                                                                                                \
+    int name##_binarySearch(const name *vector, const T value, const int index)                 \
+    {                                                                                           \
+        if (vector == NULL || index < 0 || index >= vector->length)                             \
+            return -1;                                                                          \
+        const T *base = vector->array + index;                                                  \
+        int length = vector->length - index;                                                    \
+        while (length > 1)                                                                      \
+        {                                                                                       \
+            int half = length / 2;                                                              \
+            base = less(base[half - 1], value) ? base + half : base;                            \
+            length -= half;                                                                     \
+        }                                                                                       \
+        base += less(*base, value);                                                             \
+        int position = (int)(base - vector->array);                                             \
+        if (position < vector->length && !less(value, *base))                                   \
+            return position;                                                                    \
+        return -1;                                                                              \
+    }                                                                                           \
+                                                                                                \
+    int name##_ternarySearch(const name *vector, const T value, const int index)                \
+    {                                                                                           \
+        if (vector == NULL || index < 0 || index >= vector->length)                             \
+            return -1;                                                                          \
+        int start = index, end = vector->length - 1;                                            \
+        while (start <= end)                                                                    \
+        {                                                                                       \
+            int mid1 = start + (end - start) / 3;                                               \
+            int mid2 = end - (end - start) / 3;                                                 \
+            if (less(value, vector->array[mid1]))                                               \
+                end = mid1 - 1;                                                                 \
+            else if (!less(vector->array[mid1], value))                                         \
+                return mid1;                                                                    \
+            else if (less(vector->array[mid2], value))                                          \
+                start = mid2 + 1;                                                               \
+            else if (!less(value, vector->array[mid2]))                                         \
+                return mid2;                                                                    \
+            else                                                                                \
+            {                                                                                   \
+                start = mid1 + 1;                                                               \
+                end = mid2 - 1;                                                                 \
+            }                                                                                   \
+        }                                                                                       \
+        return -1;                                                                              \
+    }                                                                                           \
+                                                                                                \
+    int name##_jumpSearch(const name *vector, const T value, const int index)                   \
+    {                                                                                           \
+        if (vector == NULL || index < 0 || index >= vector->length)                             \
+            return -1;                                                                          \
+        int jump = 1;                                                                           \
+        while ((long long)(jump + 1) * (jump + 1) <= vector->length)                            \
+            jump++;                                                                             \
+        int start = index, end = start + jump;                                                  \
+        while (end < vector->length && !less(value, vector->array[end]))                        \
+        {                                                                                       \
+            start = end;                                                                        \
+            end += jump;                                                                        \
+        }                                                                                       \
+        if (end > vector->length)                                                               \
+            end = vector->length;                                                               \
+        for (int i = start; i < end; i++)                                                       \
+            if (!less(vector->array[i], value) && !less(value, vector->array[i]))               \
+                return i;                                                                       \
+        return -1;                                                                              \
+    }                                                                                           \
+                                                                                                \
+                                                                                                \
+    void __##name##_insertionSort__(T *array, const int start, const int end)                   \
+    {                                                                                           \
+        for (int i = start + 1; i < end; i++)                                                   \
+        {                                                                                       \
+            T curr = array[i];                                                                  \
+            int j = i - 1;                                                                      \
+            while (j >= start && less(curr, array[j]))                                          \
+            {                                                                                   \
+                array[j + 1] = array[j];                                                        \
+                j--;                                                                            \
+            }                                                                                   \
+            array[j + 1] = curr;                                                                \
+        }                                                                                       \
+    }                                                                                           \
+                                                                                                \
+    void name##_insertionSort(name *vector)                                                     \
+    {                                                                                           \
+        if (vector == NULL || vector->length <= 1)                                              \
+            return;                                                                             \
+        __##name##_insertionSort__(vector->array, 0, vector->length);                           \
+    }                                                                                           \
+                                                                                                \
+    void name##_bubbleSort(name *vector)                                                        \
+    {                                                                                           \
+        if (vector == NULL || vector->length <= 1)                                              \
+            return;                                                                             \
+        for (int i = 1; i < vector->length; i++)                                                \
+        {                                                                                       \
+            bool isSorted = true;                                                               \
+            for (int j = 0; j < vector->length - i; j++)                                        \
+                if (less(vector->array[j + 1], vector->array[j]))                               \
+                {                                                                               \
+                    __##name##_swap__(&vector->array[j], &vector->array[j + 1]);                \
+                    isSorted = false;                                                           \
+                }                                                                               \
+            if (isSorted)                                                                       \
+                break;                                                                          \
+        }                                                                                       \
+    }                                                                                           \
+                                                                                                \
+    void name##_selectionSort(name *vector)                                                     \
+    {                                                                                           \
+        if (vector == NULL || vector->length <= 1)                                              \
+            return;                                                                             \
+        for (int i = 0; i < vector->length - 1; i++)                                            \
+        {                                                                                       \
+            int minIndex = i;                                                                   \
+            for (int j = i + 1; j < vector->length; j++)                                        \
+                if (less(vector->array[j], vector->array[minIndex]))                            \
+                    minIndex = j;                                                               \
+            if (minIndex != i)                                                                  \
+                __##name##_swap__(&vector->array[i], &vector->array[minIndex]);                 \
+        }                                                                                       \
+    }                                                                                           \
+                                                                                                \
+    void __##name##_heapify__(T *array, const int size, int index)                              \
+    {                                                                                           \
+        T value = array[index];                                                                 \
+        while (true)                                                                            \
+        {                                                                                       \
+            int child = 2 * index + 1;                                                          \
+            if (child >= size)                                                                  \
+                break;                                                                          \
+            if (child + 1 < size && less(array[child], array[child + 1]))                       \
+                child++;                                                                        \
+            if (!less(value, array[child]))                                                     \
+                break;                                                                          \
+            array[index] = array[child];                                                        \
+            index = child;                                                                      \
+        }                                                                                       \
+        array[index] = value;                                                                   \
+    }                                                                                           \
+                                                                                                \
+    void __##name##_heapSort__(T *array, const int length)                                      \
+    {                                                                                           \
+        for (int i = length / 2 - 1; i >= 0; i--)                                               \
+            __##name##_heapify__(array, length, i);                                             \
+        for (int i = length - 1; i > 0; i--)                                                    \
+        {                                                                                       \
+            __##name##_swap__(&array[0], &array[i]);                                            \
+            __##name##_heapify__(array, i, 0);                                                  \
+        }                                                                                       \
+    }                                                                                           \
+                                                                                                \
+    void name##_heapSort(name *vector)                                                          \
+    {                                                                                           \
+        if (vector == NULL || vector->length <= 1)                                              \
+            return;                                                                             \
+        __##name##_heapSort__(vector->array, vector->length);                                   \
+    }                                                                                           \
+                                                                                                \
+    void name##_mergeSort(name *vector)                                                         \
+    {                                                                                           \
+        if (vector == NULL || vector->length <= 1)                                              \
+            return;                                                                             \
+        int length = vector->length;                                                            \
+        T *buffer = (T *)malloc(length * sizeof(T));                                            \
+        if (buffer == NULL)                                                                     \
+        {                                                                                       \
+            perror("Failed to allocate memory for Scratch Buffer in " #name "_mergeSort");      \
+            exit(EXIT_FAILURE);                                                                 \
+        }                                                                                       \
+        for (int start = 0; start < length; start += MERGE_SORT_CUTOFF)                         \
+            __##name##_insertionSort__(vector->array, start, length - start < MERGE_SORT_CUTOFF ? length : start + MERGE_SORT_CUTOFF); \
+        T *source = vector->array, *destination = buffer;                                       \
+        for (long long width = MERGE_SORT_CUTOFF; width < length; width *= 2)                   \
+        {                                                                                       \
+            for (long long start = 0; start < length; start += 2 * width)                       \
+            {                                                                                   \
+                int mid = start + width < length ? (int)(start + width) : length;               \
+                int end = start + 2 * width < length ? (int)(start + 2 * width) : length;       \
+                int l = (int)start, r = mid, i = (int)start;                                    \
+                while (l < mid && r < end)                                                      \
+                    destination[i++] = less(source[r], source[l]) ? source[r++] : source[l++];  \
+                while (l < mid)                                                                 \
+                    destination[i++] = source[l++];                                             \
+                while (r < end)                                                                 \
+                    destination[i++] = source[r++];                                             \
+            }                                                                                   \
+            T *temp = source;                                                                   \
+            source = destination;                                                               \
+            destination = temp;                                                                 \
+        }                                                                                       \
+        if (source != vector->array)                                                            \
+            memcpy(vector->array, source, length * sizeof(T));                                  \
+        free(buffer);                                                                           \
+    }                                                                                           \
+                                                                                                \
+    void __##name##_introSort__(T *array, int start, int end, int depth)                        \
+    {                                                                                           \
+        while (end - start > QUICK_SORT_CUTOFF)                                                 \
+        {                                                                                       \
+            if (depth-- == 0)                                                                   \
+            {                                                                                   \
+                __##name##_heapSort__(array + start, end - start);                              \
+                return;                                                                         \
+            }                                                                                   \
+            int mid = start + (end - start) / 2;                                                \
+            if (less(array[mid], array[start]))                                                 \
+                __##name##_swap__(&array[mid], &array[start]);                                  \
+            if (less(array[end - 1], array[mid]))                                               \
+                __##name##_swap__(&array[end - 1], &array[mid]);                                \
+            if (less(array[mid], array[start]))                                                 \
+                __##name##_swap__(&array[mid], &array[start]);                                  \
+            T pivot = array[mid];                                                               \
+            int lt = start, i = start, gt = end;                                                \
+            while (i < gt)                                                                      \
+            {                                                                                   \
+                if (less(array[i], pivot))                                                      \
+                    __##name##_swap__(&array[lt++], &array[i++]);                               \
+                else if (less(pivot, array[i]))                                                 \
+                    __##name##_swap__(&array[i], &array[--gt]);                                 \
+                else                                                                            \
+                    i++;                                                                        \
+            }                                                                                   \
+            if (lt - start < end - gt)                                                          \
+            {                                                                                   \
+                __##name##_introSort__(array, start, lt, depth);                                \
+                start = gt;                                                                     \
+            }                                                                                   \
+            else                                                                                \
+            {                                                                                   \
+                __##name##_introSort__(array, gt, end, depth);                                  \
+                end = lt;                                                                       \
+            }                                                                                   \
+        }                                                                                       \
+        __##name##_insertionSort__(array, start, end);                                          \
+    }                                                                                           \
+                                                                                                \
+    void name##_quickSort(name *vector)                                                         \
+    {                                                                                           \
+        if (vector == NULL || vector->length <= 1)                                              \
+            return;                                                                             \
+        int depth = 0;                                                                          \
+        for (int length = vector->length; length > 1; length >>= 1)                             \
+            depth += 2;                                                                         \
+        __##name##_introSort__(vector->array, 0, vector->length, depth);                        \
+    }                                                                                           \
+                                                                                                \
+    void name##_map(name *vector, T (*func)(T))                                                 \
+    {                                                                                           \
+        if (vector == NULL || func == NULL)                                                     \
+            return;                                                                             \
+        for (int i = 0; i < vector->length; i++)                                                \
+            vector->array[i] = func(vector->array[i]);                                          \
+    }                                                                                           \
+                                                                                                \
+    void name##_filter(name *vector, bool (*func)(T))                                           \
+    {                                                                                           \
+        if (vector == NULL || func == NULL)                                                     \
+            return;                                                                             \
+        int index = 0;                                                                          \
+        for (int i = 0; i < vector->length; i++)                                                \
+            if (func(vector->array[i]))                                                         \
+                vector->array[index++] = vector->array[i];                                      \
+        vector->length = index;                                                                 \
+    }                                                                                           \
+                                                                                                \
+    T name##_max(const name *vector)                                                            \
+    {                                                                                           \
+        if (name##_isEmpty(vector))                                                             \
+            return name##_get(NULL, 0);                                                         \
+        T maximum = vector->array[0];                                                           \
+        for (int i = 1; i < vector->length; i++)                                                \
+            if (less(maximum, vector->array[i]))                                                \
+                maximum = vector->array[i];                                                     \
+        return maximum;                                                                         \
+    }                                                                                           \
+                                                                                                \
+    T name##_min(const name *vector)                                                            \
+    {                                                                                           \
+        if (name##_isEmpty(vector))                                                             \
+            return name##_get(NULL, 0);                                                         \
+        T minimum = vector->array[0];                                                           \
+        for (int i = 1; i < vector->length; i++)                                                \
+            if (less(vector->array[i], minimum))                                                \
+                minimum = vector->array[i];                                                     \
+        return minimum;                                                                         \
+    }                                                                                           \
+                                                                                                \
+    int name##_count(const name *vector, const T value)                                         \
+    {                                                                                           \
+        if (name##_isEmpty(vector))                                                             \
+            return 0;                                                                           \
+        int freq = 0;                                                                           \
+        for (int i = 0; i < vector->length; i++)                                                \
+            freq += !less(vector->array[i], value) && !less(value, vector->array[i]);           \
+        return freq;                                                                            \
+    }                                                                                           \
+                                                                                                \
+    bool name##_contains(const name *vector, const T value)                                     \
+    {                                                                                           \
+        return name##_linearSearch(vector, value, 0) >= 0;                                      \
+    }                                                                                           \
+                                                                                                \
+    void name##_replace(name *vector, const T newVal, const T oldVal, const int index)          \
+    {                                                                                           \
+        if (vector == NULL || index < 0 || index >= vector->length)                             \
+            return;                                                                             \
+        for (int i = index; i < vector->length; i++)                                            \
+            if (!less(vector->array[i], oldVal) && !less(oldVal, vector->array[i]))             \
+            {                                                                                   \
+                vector->array[i] = newVal;                                                      \
+                return;                                                                         \
+            }                                                                                   \
+    }                                                                                           \
+                                                                                                \
+    void name##_reserve(name *vector, const int capacity)                                       \
+    {                                                                                           \
+        if (vector == NULL || capacity <= vector->capacity)                                     \
+            return;                                                                             \
+        T *newArray = (T *)realloc(vector->array, capacity * sizeof(T));                        \
+        if (newArray == NULL)                                                                   \
+        {                                                                                       \
+            perror("Failed to reserve " #name);                                                 \
+            exit(EXIT_FAILURE);                                                                 \
+        }                                                                                       \
+        vector->array = newArray;                                                               \
+        vector->capacity = capacity;                                                            \
+    }                                                                                           \
+                                                                                                \
+    void name##_shrinkToFit(name *vector)                                                       \
+    {                                                                                           \
+        if (vector == NULL)                                                                     \
+            return;                                                                             \
+        int capacity = vector->length > 0 ? vector->length : 1;                                 \
+        if (capacity == vector->capacity)                                                       \
+            return;                                                                             \
+        T *newArray = (T *)realloc(vector->array, capacity * sizeof(T));                        \
+        if (newArray == NULL)                                                                   \
+        {                                                                                       \
+            perror("Failed to shrink " #name);                                                  \
+            exit(EXIT_FAILURE);                                                                 \
+        }                                                                                       \
+        vector->array = newArray;                                                               \
+        vector->capacity = capacity;                                                            \
+    }                                                                                           \
+                                                                                                \
+    void name##_insertRange(name *vector, const T *values, const int count, const int index)    \
+    {                                                                                           \
+        if (vector == NULL || values == NULL || count <= 0 || index < 0 || index > vector->length) \
+            return;                                                                             \
+        T *source = (T *)values;                                                                \
+        bool aliased = values >= vector->array && values < vector->array + vector->capacity;    \
+        if (aliased)                                                                            \
+        {                                                                                       \
+            source = (T *)malloc(count * sizeof(T));                                            \
+            if (source == NULL)                                                                 \
+            {                                                                                   \
+                perror("Failed to allocate memory for Values in " #name "_insertRange");        \
+                exit(EXIT_FAILURE);                                                             \
+            }                                                                                   \
+            memcpy(source, values, count * sizeof(T));                                          \
+        }                                                                                       \
+        if (vector->length + count > vector->capacity)                                          \
+        {                                                                                       \
+            int doubled = vector->capacity * 2;                                                 \
+            name##_reserve(vector, vector->length + count > doubled ? vector->length + count : doubled); \
+        }                                                                                       \
+        memmove(vector->array + index + count, vector->array + index,                           \
+                (vector->length - index) * sizeof(T));                                          \
+        memcpy(vector->array + index, source, count * sizeof(T));                               \
+        vector->length += count;                                                                \
+        if (aliased)                                                                            \
+            free(source);                                                                       \
+    }                                                                                           \
+                                                                                                \
+    void name##_eraseRange(name *vector, const int start, const int end)                        \
+    {                                                                                           \
+        if (vector == NULL || start < 0 || end > vector->length || start >= end)                \
+            return;                                                                             \
+        memmove(vector->array + start, vector->array + end, (vector->length - end) * sizeof(T)); \
+        vector->length -= end - start;                                                          \
+    }                                                                                           \
+                                                                                                \
+    int name##_eraseIf(name *vector, bool (*func)(T))                                           \
+    {                                                                                           \
+        if (vector == NULL || func == NULL)                                                     \
+            return 0;                                                                           \
+        int index = 0;                                                                          \
+        for (int i = 0; i < vector->length; i++)                                                \
+        {                                                                                       \
+            T value = vector->array[i];                                                         \
+            vector->array[index] = value;                                                       \
+            index += !func(value);                                                              \
+        }                                                                                       \
+        int removed = vector->length - index;                                                   \
+        vector->length = index;                                                                 \
+        return removed;                                                                         \
+    }                                                                                           \
+                                                                                                \
+    int name##_popAll(name *vector, const T value)                                              \
+    {                                                                                           \
+        if (vector == NULL)                                                                     \
+            return 0;                                                                           \
+        int index = 0;                                                                          \
+        for (int i = 0; i < vector->length; i++)                                                \
+        {                                                                                       \
+            T current = vector->array[i];                                                       \
+            vector->array[index] = current;                                                     \
+            index += less(current, value) || less(value, current);                              \
+        }                                                                                       \
+        int removed = vector->length - index;                                                   \
+        vector->length = index;                                                                 \
+        return removed;                                                                         \
+    }                                                                                           \
+                                                                                                \
+    void __##name##_introSelect__(T *array, int start, int end, const int nth, int depth)       \
+    {                                                                                           \
+        while (end - start > QUICK_SORT_CUTOFF)                                                 \
+        {                                                                                       \
+            if (depth-- == 0)                                                                   \
+            {                                                                                   \
+                __##name##_heapSort__(array + start, end - start);                              \
+                return;                                                                         \
+            }                                                                                   \
+            int mid = start + (end - start) / 2;                                                \
+            if (less(array[mid], array[start]))                                                 \
+                __##name##_swap__(&array[mid], &array[start]);                                  \
+            if (less(array[end - 1], array[mid]))                                               \
+                __##name##_swap__(&array[end - 1], &array[mid]);                                \
+            if (less(array[mid], array[start]))                                                 \
+                __##name##_swap__(&array[mid], &array[start]);                                  \
+            T pivot = array[mid];                                                               \
+            int lt = start, i = start, gt = end;                                                \
+            while (i < gt)                                                                      \
+            {                                                                                   \
+                if (less(array[i], pivot))                                                      \
+                    __##name##_swap__(&array[lt++], &array[i++]);                               \
+                else if (less(pivot, array[i]))                                                 \
+                    __##name##_swap__(&array[i], &array[--gt]);                                 \
+                else                                                                            \
+                    i++;                                                                        \
+            }                                                                                   \
+            if (nth < lt)                                                                       \
+                end = lt;                                                                       \
+            else if (nth >= gt)                                                                 \
+                start = gt;                                                                     \
+            else                                                                                \
+                return;                                                                         \
+        }                                                                                       \
+        __##name##_insertionSort__(array, start, end);                                          \
+    }                                                                                           \
+                                                                                                \
+    int __##name##_depthLimit__(const int length)                                               \
+    {                                                                                           \
+        int depth = 0;                                                                          \
+        for (int remaining = length; remaining > 1; remaining >>= 1)                            \
+            depth += 2;                                                                         \
+        return depth;                                                                           \
+    }                                                                                           \
+                                                                                                \
+    void name##_nthElement(name *vector, const int n)                                           \
+    {                                                                                           \
+        if (vector == NULL || n < 0 || n >= vector->length)                                     \
+            return;                                                                             \
+        __##name##_introSelect__(vector->array, 0, vector->length, n,                           \
+                                 __##name##_depthLimit__(vector->length));                      \
+    }                                                                                           \
+                                                                                                \
+    void name##_partialSort(name *vector, int k)                                                \
+    {                                                                                           \
+        if (vector == NULL || k <= 0 || vector->length <= 1)                                    \
+            return;                                                                             \
+        if (k > vector->length)                                                                 \
+            k = vector->length;                                                                 \
+        if (k < vector->length)                                                                 \
+            __##name##_introSelect__(vector->array, 0, vector->length, k - 1,                   \
+                                     __##name##_depthLimit__(vector->length));                  \
+        __##name##_introSort__(vector->array, 0, k, __##name##_depthLimit__(k));                \
+    }                                                                                           \
+                                                                                                \
+    void __##name##_siftDownMin__(T *array, const int size, int index)                          \
+    {                                                                                           \
+        T value = array[index];                                                                 \
+        while (true)                                                                            \
+        {                                                                                       \
+            int child = 2 * index + 1;                                                          \
+            if (child >= size)                                                                  \
+                break;                                                                          \
+            if (child + 1 < size && less(array[child + 1], array[child]))                       \
+                child++;                                                                        \
+            if (!less(array[child], value))                                                     \
+                break;                                                                          \
+            array[index] = array[child];                                                        \
+            index = child;                                                                      \
+        }                                                                                       \
+        array[index] = value;                                                                   \
+    }                                                                                           \
+                                                                                                \
+    name name##_topK(const name *vector, int k)                                                 \
+    {                                                                                           \
+        if (name##_isEmpty(vector) || k <= 0)                                                   \
+            return name##_init(1);                                                              \
+        if (k > vector->length)                                                                 \
+            k = vector->length;                                                                 \
+        name heap = name##_init(k);                                                             \
+        memcpy(heap.array, vector->array, k * sizeof(T));                                       \
+        heap.length = k;                                                                        \
+        for (int i = k / 2 - 1; i >= 0; i--)                                                    \
+            __##name##_siftDownMin__(heap.array, k, i);                                         \
+        for (int i = k; i < vector->length; i++)                                                \
+            if (less(heap.array[0], vector->array[i]))                                          \
+            {                                                                                   \
+                heap.array[0] = vector->array[i];                                               \
+                __##name##_siftDownMin__(heap.array, k, 0);                                     \
+            }                                                                                   \
+        for (int i = k - 1; i > 0; i--)                                                         \
+        {                                                                                       \
+            __##name##_swap__(&heap.array[0], &heap.array[i]);                                  \
+            __##name##_siftDownMin__(heap.array, i, 0);                                         \
+        }                                                                                       \
+        return heap;                                                                            \
+    }
+
+/**
+ * @brief Identity key for DEFINE_VECTOR_INTERPOLATION on arithmetic element types.
+ * @param x The element.
+ */
+#define VECTOR_KEY(x) (x)
+
+/**
+ * @brief Adds `name_interpolationSearch` to a vector defined by DEFINE_VECTOR or DEFINE_VECTOR_CMP.
+ * @param name The name of the vector.
+ * @param T The element type.
+ * @param key A function-like macro or inline function mapping an element to the number it is
+ * sorted by, e.g. VECTOR_KEY for integers and floating-point types or `EDGE_KEY(e) ((e).key)`.
+ * @note Separate from DEFINE_VECTOR_CMP because interpolation needs arithmetic on keys, which a
+ * comparator cannot provide. The vector must be sorted by `key`.
+ */
+#define DEFINE_VECTOR_INTERPOLATION(name, T, key)                                               \
+    int name##_interpolationSearch(const name *vector, const T value, const int index)          \
+    {                                                                                           \
+        if (vector == NULL || index < 0 || index >= vector->length)                             \
+            return -1;                                                                          \
+        double target = (double)key(value);                                                     \
+        int start = index, end = vector->length - 1;                                            \
+        while (start <= end && target >= (double)key(vector->array[start]) && target <= (double)key(vector->array[end])) \
+        {                                                                                       \
+            double low = (double)key(vector->array[start]), high = (double)key(vector->array[end]); \
+            if (low == high)                                                                    \
+                break;                                                                          \
+            int pos = start + (int)((end - start) * ((target - low) / (high - low)));           \
+            if (pos < start || pos > end)                                                       \
+                break;                                                                          \
+            double probe = (double)key(vector->array[pos]);                                     \
+            if (probe == target)                                                                \
+                return pos;                                                                     \
+            else if (probe < target)                                                            \
+                start = pos + 1;                                                                \
+            else                                                                                \
+                end = pos - 1;                                                                  \
+        }                                                                                       \
+        if (start <= end && (double)key(vector->array[start]) == target)                        \
+            return start;                                                                       \
+        return -1;                                                                              \
+    }
+
+/**
+ * @brief Adds `name_sum`, `name_prod`, `name_any` and `name_all` to a vector defined by
+ * DEFINE_VECTOR or DEFINE_VECTOR_CMP.
+ * @param name The name of the vector.
+ * @param T An arithmetic element type.
+ * @note Separate from DEFINE_VECTOR_CMP because these need `+`, `*` and truthiness on `T`, which a
+ * comparator cannot provide. sum returns 0 and prod returns 1 for an empty vector; both accumulate
+ * in `T`. any and all test elements as non-zero, as in adt_Vector.h.
+ */
+#define DEFINE_VECTOR_ARITHMETIC(name, T)                                                       \
+    T name##_sum(const name *vector)                                                            \
+    {                                                                                           \
+        T total = 0;                                                                            \
+        if (name##_isEmpty(vector))                                                             \
+            return total;                                                                       \
+        for (int i = 0; i < vector->length; i++)                                                \
+            total += vector->array[i];                                                          \
+        return total;                                                                           \
+    }                                                                                           \
+                                                                                                \
+    T name##_prod(const name *vector)                                                           \
+    {                                                                                           \
+        T product = 1;                                                                          \
+        if (name##_isEmpty(vector))                                                             \
+            return product;                                                                     \
+        for (int i = 0; i < vector->length; i++)                                                \
+            product *= vector->array[i];                                                        \
+        return product;                                                                         \
+    }                                                                                           \
+                                                                                                \
+    bool name##_any(const name *vector)                                                         \
+    {                                                                                           \
+        if (name##_isEmpty(vector))                                                             \
+            return false;                                                                       \
+        for (int i = 0; i < vector->length; i++)                                                \
+            if (vector->array[i])                                                               \
+                return true;                                                                    \
+        return false;                                                                           \
+    }                                                                                           \
+                                                                                                \
+    bool name##_all(const name *vector)                                                         \
+    {                                                                                           \
+        if (name##_isEmpty(vector))                                                             \
+            return true;                                                                        \
+        for (int i = 0; i < vector->length; i++)                                                \
+            if (!vector->array[i])                                                              \
+                return false;                                                                   \
+        return true;                                                                            \
+    }
+
+#endif // GENERIC_VECTOR_H
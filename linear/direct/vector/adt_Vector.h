@@ -4,9 +4,35 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include <string.h>
 #include <math.h>
 #include <time.h>
 
+/**
+ * @brief Opt-in POSIX features. Define these before including the header to enable them.
+ * @details VECTOR_THREADS enables parallelSort and pipeThreads (POSIX threads; link with
+ * -pthread). VECTOR_MMAP enables MappedVector (mmap and POSIX file descriptors). Without them
+ * the header needs nothing beyond the C standard library.
+ */
+#ifdef VECTOR_THREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#ifdef VECTOR_MMAP
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(VECTOR_NO_SIMD)
+#include <immintrin.h>
+#define VECTOR_SIMD
+#endif
+
 /**
  * @brief Represents a dynamic array (vector) of integers.
  * @details This struct holds a pointer to the array, the number of elements
@@ -257,8 +283,7 @@ void insert(Vector *vector, const int value, const int index)
         return;
     if (__isFull__(vector))
         __expand__(vector);
-    for (int i = vector->length; i > index; i--)
-        vector->array[i] = vector->array[i - 1];
+    memmove(vector->array + index + 1, vector->array + index, (vector->length - index) * sizeof(int));
     vector->array[index] = value;
     vector->length++;
 }
@@ -276,8 +301,7 @@ void pop(Vector *vector, const int value)
     {
         if (vector->array[i] == value)
         {
-            for (int j = i; j < vector->length - 1; j++)
-                vector->array[j] = vector->array[j + 1];
+            memmove(vector->array + i, vector->array + i + 1, (vector->length - i - 1) * sizeof(int));
             vector->length--;
             return;
         }
@@ -295,12 +319,167 @@ int discard(Vector *vector, const int index)
     if (isEmpty(vector) || index < 0 || index >= vector->length)
         return -1;
     int value = vector->array[index];
-    for (int i = index; i < vector->length - 1; i++)
-        vector->array[i] = vector->array[i + 1];
+    memmove(vector->array + index, vector->array + index + 1, (vector->length - index - 1) * sizeof(int));
     vector->length--;
     return value;
 }
 
+/**
+ * @brief Grows the vector's capacity to at least the requested number of elements.
+ * @param vector A pointer to the vector.
+ * @param capacity The minimum capacity the vector should have.
+ * @note Does nothing if the vector already has that much capacity. Appending up to `capacity`
+ * elements afterwards never reallocates.
+ * @note Exits the program if realloc fails.
+ */
+void reserve(Vector *vector, const int capacity)
+{
+    if (vector == NULL || capacity <= vector->capacity)
+        return;
+    int *newArray = (int *)realloc(vector->array, capacity * sizeof(int));
+    if (newArray == NULL)
+    {
+        perror("Failed to reserve Vector");
+        exit(EXIT_FAILURE);
+    }
+    vector->array = newArray;
+    vector->capacity = capacity;
+}
+
+/**
+ * @brief Releases the capacity the vector is not using.
+ * @param vector A pointer to the vector.
+ * @note The capacity becomes the current length, or 1 for an empty vector.
+ * @note Exits the program if realloc fails.
+ */
+void shrinkToFit(Vector *vector)
+{
+    if (vector == NULL)
+        return;
+    int capacity = vector->length > 0 ? vector->length : 1;
+    if (capacity == vector->capacity)
+        return;
+    int *newArray = (int *)realloc(vector->array, capacity * sizeof(int));
+    if (newArray == NULL)
+    {
+        perror("Failed to shrink Vector");
+        exit(EXIT_FAILURE);
+    }
+    vector->array = newArray;
+    vector->capacity = capacity;
+}
+
+/**
+ * @brief Makes room for a number of additional elements, growing the capacity geometrically.
+ * @param vector A pointer to the vector.
+ * @param count The number of elements about to be added.
+ * @note This is a private helper function. The capacity at least doubles whenever it grows, so
+ * a sequence of range insertions costs amortized O(1) per element.
+ */
+void __reserveFor__(Vector *vector, const int count)
+{
+    if (vector->length + count <= vector->capacity)
+        return;
+    int doubled = vector->capacity * 2;
+    reserve(vector, vector->length + count > doubled ? vector->length + count : doubled);
+}
+
+/**
+ * @brief Inserts a block of values at a specific index, shifting existing elements once.
+ * @param vector A pointer to the vector.
+ * @param values A pointer to the values to insert. It may point into the vector itself.
+ * @param count The number of values to insert.
+ * @param index The index at which the first value is inserted.
+ * @note Costs O(length + count) regardless of `count`, instead of `count` separate shifts.
+ * @note Exits the program if memory allocation fails.
+ */
+void insertRange(Vector *vector, const int *values, const int count, const int index)
+{
+    if (vector == NULL || values == NULL || count <= 0 || index < 0 || index > vector->length)
+        return;
+    int *source = (int *)values;
+    bool aliased = values >= vector->array && values < vector->array + vector->capacity;
+    if (aliased)
+    {
+        source = (int *)malloc(count * sizeof(int));
+        if (source == NULL)
+        {
+            perror("Failed to allocate memory for Values in insertRange");
+            exit(EXIT_FAILURE);
+        }
+        memcpy(source, values, count * sizeof(int));
+    }
+
+    __reserveFor__(vector, count);
+    memmove(vector->array + index + count, vector->array + index, (vector->length - index) * sizeof(int));
+    memcpy(vector->array + index, source, count * sizeof(int));
+    vector->length += count;
+
+    if (aliased)
+        free(source);
+}
+
+/**
+ * @brief Removes the elements in a range, shifting the tail once.
+ * @param vector A pointer to the vector.
+ * @param start The index of the first element to remove (inclusive).
+ * @param end The index one past the last element to remove (exclusive).
+ * @note This function does nothing if the range is invalid.
+ */
+void eraseRange(Vector *vector, const int start, const int end)
+{
+    if (vector == NULL || start < 0 || end > vector->length || start >= end)
+        return;
+    memmove(vector->array + start, vector->array + end, (vector->length - end) * sizeof(int));
+    vector->length -= end - start;
+}
+
+/**
+ * @brief Removes every element for which a predicate returns true, in one pass.
+ * @param vector A pointer to the vector.
+ * @param func A function pointer that takes an integer and returns a boolean.
+ * @return The number of elements removed.
+ * @note The remaining elements keep their relative order.
+ */
+int eraseIf(Vector *vector, bool (*func)(int))
+{
+    if (vector == NULL || func == NULL)
+        return 0;
+    int index = 0;
+    for (int i = 0; i < vector->length; i++)
+    {
+        int value = vector->array[i];
+        vector->array[index] = value;
+        index += !func(value);
+    }
+    int removed = vector->length - index;
+    vector->length = index;
+    return removed;
+}
+
+/**
+ * @brief Removes every occurrence of a specific value, in one pass.
+ * @param vector A pointer to the vector.
+ * @param value The value to remove.
+ * @return The number of elements removed.
+ * @note The remaining elements keep their relative order.
+ */
+int popAll(Vector *vector, const int value)
+{
+    if (vector == NULL)
+        return 0;
+    int index = 0;
+    for (int i = 0; i < vector->length; i++)
+    {
+        int current = vector->array[i];
+        vector->array[index] = current;
+        index += current != value;
+    }
+    int removed = vector->length - index;
+    vector->length = index;
+    return removed;
+}
+
 /**
  * @brief Creates a new vector populated with elements from a given C-style array.
  * @param array A pointer to the source array.
@@ -561,6 +740,225 @@ int jumpSearch(const Vector *vector, const int value, const int index)
     return -1;
 }
 
+/**
+ * @brief Issues a read prefetch for an address, where the compiler supports it.
+ * @note This is a private helper macro.
+ */
+#if defined(__GNUC__)
+#define __PREFETCH__(address) __builtin_prefetch(address)
+#else
+#define __PREFETCH__(address) ((void)0)
+#endif
+
+/**
+ * @brief Performs a branchless binary search for a value in a sorted vector starting from a given index.
+ * @param vector A pointer to the vector to search.
+ * @param value The value to search for.
+ * @param index The starting index for the search.
+ * @return The index of the first occurrence of the value, or -1 if not found.
+ * @note The loop runs a fixed log2(n) steps and narrows the range with a conditional move
+ * instead of a branch, prefetching both candidate midpoints of the next step.
+ */
+int branchlessSearch(const Vector *vector, const int value, const int index)
+{
+    if (vector == NULL || index < 0 || index >= vector->length)
+        return -1;
+
+    const int *base = vector->array + index;
+    int length = vector->length - index;
+    while (length > 1)
+    {
+        int half = length / 2;
+        __PREFETCH__(base + half / 2);
+        __PREFETCH__(base + half + half / 2);
+        base = base[half - 1] < value ? base + half : base;
+        length -= half;
+    }
+    base += *base < value;
+
+    int position = (int)(base - vector->array);
+    return position < vector->length && *base == value ? position : -1;
+}
+
+/**
+ * @brief Represents a read-only search index over a sorted vector in Eytzinger (BFS) order.
+ * @details The tree holds the sorted elements laid out level by level from index 1, padded with
+ * INT_MAX up to a complete tree so every lookup runs exactly `depth` steps. `rank` maps each tree
+ * slot back to the index of that element in the source vector (-1 for padding).
+ */
+typedef struct
+{
+    int *tree;
+    int *rank;
+    int size;
+    int depth;
+} SearchIndex;
+
+/**
+ * @brief Fills tree slots with sorted elements using an in-order walk of the implicit tree.
+ * @param array A pointer to the sorted source array.
+ * @param length The number of source elements.
+ * @param index A pointer to the next source position to place.
+ * @param tree A pointer to the destination tree.
+ * @param rank A pointer to the destination rank table.
+ * @param slot The tree slot being visited.
+ * @param size The number of tree slots.
+ * @note This is a private helper function. Slots are size_t because the children of the last
+ * level, 2 * slot and 2 * slot + 1, exceed INT_MAX once the tree holds 2^30 or more elements.
+ */
+void __eytzinger__(const int *array, const int length, int *index, int *tree, int *rank, const size_t slot, const size_t size)
+{
+    if (slot > size)
+        return;
+    __eytzinger__(array, length, index, tree, rank, 2 * slot, size);
+    if (*index < length)
+    {
+        tree[slot] = array[*index];
+        rank[slot] = *index;
+    }
+    else
+    {
+        tree[slot] = 0x7fffffff;
+        rank[slot] = -1;
+    }
+    (*index)++;
+    __eytzinger__(array, length, index, tree, rank, 2 * slot + 1, size);
+}
+
+/**
+ * @brief Builds a search index from a sorted vector.
+ * @param vector A pointer to the sorted vector. It is not modified and may be destroyed afterwards.
+ * @return A new SearchIndex instance.
+ * @note Exits the program if the vector is NULL or empty, or if memory allocation fails.
+ * @note The tree size is computed in size_t, so vectors of up to INT_MAX elements are supported
+ * wherever the (size + 1) slots of the tree and the rank table fit in memory.
+ */
+SearchIndex buildIndex(const Vector *vector)
+{
+    if (isEmpty(vector))
+    {
+        perror("Invalid input for buildIndex");
+        exit(EXIT_FAILURE);
+    }
+
+    SearchIndex index;
+    index.depth = 0;
+    size_t size = 0;
+    while (size < (size_t)vector->length)
+    {
+        size = 2 * size + 1;
+        index.depth++;
+    }
+    index.size = (int)size; // at most 2^31 - 1, since the length is an int
+
+    // Slot 0 is unused, so slot k's children 16k..16k+15 (four levels down) share a cache line.
+    size_t slots = size + 1;
+    if (slots > (SIZE_MAX - 63) / sizeof(int))
+    {
+        perror("Failed to initialize SearchIndex: vector too long for this platform");
+        exit(EXIT_FAILURE);
+    }
+    size_t bytes = (slots * sizeof(int) + 63) / 64 * 64;
+    index.tree = (int *)aligned_alloc(64, bytes);
+    index.rank = (int *)malloc(slots * sizeof(int));
+    if (index.tree == NULL || index.rank == NULL)
+    {
+        perror("Failed to initialize SearchIndex");
+        exit(EXIT_FAILURE);
+    }
+
+    int position = 0;
+    __eytzinger__(vector->array, vector->length, &position, index.tree, index.rank, 1, size);
+    return index;
+}
+
+/**
+ * @brief Destroys a search index and frees its memory.
+ * @param index A pointer to the index to destroy.
+ */
+void destroyIndex(SearchIndex *index)
+{
+    if (index == NULL)
+        return;
+    free(index->tree);
+    free(index->rank);
+    index->tree = NULL;
+    index->rank = NULL;
+    index->size = 0;
+    index->depth = 0;
+}
+
+/**
+ * @brief Maps the final slot of an Eytzinger descent back to a source index.
+ * @param index A pointer to the search index.
+ * @param slot The slot reached after `depth` steps.
+ * @param value The value that was searched for.
+ * @return The index of the first occurrence in the source vector, or -1 if not found.
+ * @note This is a private helper function. Shifting out the trailing ones undoes the
+ * right turns taken after the last left turn, which lands on the lower bound. With
+ * duplicates the lower bound is always the first occurrence, so its rank is the answer.
+ */
+int __resolveSlot__(const SearchIndex *index, unsigned int slot, const int value)
+{
+    while (slot & 1u)
+        slot >>= 1;
+    slot >>= 1;
+    if (slot == 0 || index->tree[slot] != value)
+        return -1;
+    return index->rank[slot];
+}
+
+/**
+ * @brief Looks up a value in a search index.
+ * @param index A pointer to the search index.
+ * @param value The value to search for.
+ * @return The index of the first occurrence of the value in the source vector, or -1 if not found.
+ */
+int indexSearch(const SearchIndex *index, const int value)
+{
+    if (index == NULL || index->tree == NULL)
+        return -1;
+    unsigned int slot = 1;
+    for (int level = 0; level < index->depth; level++)
+    {
+        __PREFETCH__(index->tree + 16 * slot);
+        slot = 2 * slot + (index->tree[slot] < value);
+    }
+    return __resolveSlot__(index, slot, value);
+}
+
+/**
+ * @brief Looks up many values in a search index at once.
+ * @param index A pointer to the search index.
+ * @param values A pointer to the values to search for.
+ * @param results A pointer to an array receiving, for each value, the index of its first
+ * occurrence in the source vector or -1.
+ * @param count The number of values.
+ * @note Lookups advance in lockstep groups so the cache misses of a group overlap.
+ */
+void indexSearchBatch(const SearchIndex *index, const int *values, int *results, const int count)
+{
+    if (index == NULL || index->tree == NULL || values == NULL || results == NULL)
+        return;
+
+    enum { GROUP = 32 };
+    unsigned int slots[GROUP];
+    for (int base = 0; base < count; base += GROUP)
+    {
+        int group = count - base < GROUP ? count - base : GROUP;
+        for (int j = 0; j < group; j++)
+            slots[j] = 1;
+        for (int level = 0; level < index->depth; level++)
+            for (int j = 0; j < group; j++)
+            {
+                slots[j] = 2 * slots[j] + (index->tree[slots[j]] < values[base + j]);
+                __PREFETCH__(index->tree + 16 * slots[j]);
+            }
+        for (int j = 0; j < group; j++)
+            results[base + j] = __resolveSlot__(index, slots[j], values[base + j]);
+    }
+}
+
 /**
  * @brief Sorts the vector using the bubble sort algorithm.
  * @param vector A pointer to the vector to sort.
@@ -607,26 +1005,38 @@ void selectionSort(Vector *vector)
 }
 
 /**
- * @brief Sorts the vector using the insertion sort algorithm.
- * @param vector A pointer to the vector to sort.
+ * @brief Sorts a range of an array using the insertion sort algorithm.
+ * @param array A pointer to the array.
+ * @param start The starting index of the range (inclusive).
+ * @param end The ending index of the range (exclusive).
+ * @note This is a private helper function shared by insertionSort and the hybrid sorts.
  */
-void insertionSort(Vector *vector)
+void __insertionSort__(int *array, const int start, const int end)
 {
-    if (vector == NULL || vector->length <= 1)
-        return;
-    for (int i = 1; i < vector->length; i++)
+    for (int i = start + 1; i < end; i++)
     {
-        int curr = vector->array[i];
+        int curr = array[i];
         int j = i - 1;
-        while (j >= 0 && vector->array[j] > curr)
+        while (j >= start && array[j] > curr)
         {
-            vector->array[j + 1] = vector->array[j];
+            array[j + 1] = array[j];
             j--;
         }
-        vector->array[j + 1] = curr;
+        array[j + 1] = curr;
     }
 }
 
+/**
+ * @brief Sorts the vector using the insertion sort algorithm.
+ * @param vector A pointer to the vector to sort.
+ */
+void insertionSort(Vector *vector)
+{
+    if (vector == NULL || vector->length <= 1)
+        return;
+    __insertionSort__(vector->array, 0, vector->length);
+}
+
 /**
  * @brief Sorts the vector using the counting sort algorithm.
  * @param vector A pointer to the vector to sort.
@@ -684,155 +1094,218 @@ void countSort(Vector *vector)
 }
 
 /**
- * @brief Sorts the vector using the radix sort algorithm.
+ * @brief Sorts the vector using a least-significant-digit binary radix sort.
  * @param vector A pointer to the vector to sort.
- * @note This algorithm is stable and efficient for large numbers with few digits.
+ * @note Keys are split into 8-bit digits for short vectors and 11-bit digits otherwise, with the
+ * sign bit flipped so negative numbers sort correctly. All digit histograms are built in one
+ * pre-pass, passes in which every key shares the same digit are skipped, and each remaining pass
+ * scatters between the vector and a single scratch buffer using prefix-summed offsets.
+ * @note This algorithm is stable. Exits the program if memory allocation fails.
  */
 void radixSort(Vector *vector)
 {
     if (vector == NULL || vector->length <= 1)
         return;
 
-    int max = vector->array[0];
-    for (int i = 1; i < vector->length; i++)
-        if (vector->array[i] > max)
-            max = vector->array[i];
+    const unsigned int sign = 0x80000000u;
+    int length = vector->length;
+    int bits = length < 65536 ? 8 : 11;
+    int radix = 1 << bits;
+    int passes = (32 + bits - 1) / bits;
+    unsigned int mask = (unsigned int)radix - 1;
 
-    for (int place = 1; max / place > 0; place *= 10)
+    int *counter = (int *)calloc(passes * radix, sizeof(int));
+    unsigned int *buffer = (unsigned int *)malloc(length * sizeof(unsigned int));
+    if (counter == NULL || buffer == NULL)
     {
-        int counter[10] = {0};
+        perror("Failed to allocate memory for Histograms in radixSort");
+        free(counter);
+        free(buffer);
+        exit(EXIT_FAILURE);
+    }
 
-        for (int i = 0; i < vector->length; i++)
-            counter[(vector->array[i] / place) % 10]++;
+    unsigned int *source = (unsigned int *)vector->array;
+    for (int i = 0; i < length; i++)
+    {
+        unsigned int key = source[i] ^ sign;
+        source[i] = key;
+        for (int pass = 0; pass < passes; pass++)
+            counter[pass * radix + ((key >> (pass * bits)) & mask)]++;
+    }
 
-        for (int i = 1; i < 10; i++)
-            counter[i] += counter[i - 1];
+    unsigned int *destination = buffer;
+    for (int pass = 0; pass < passes; pass++)
+    {
+        int shift = pass * bits;
+        int *count = counter + pass * radix;
+        if (count[(source[0] >> shift) & mask] == length)
+            continue;
 
-        int *result = (int *)malloc(vector->length * sizeof(int));
-        if (result == NULL)
+        int offset = 0;
+        for (int digit = 0; digit < radix; digit++)
         {
-            perror("Failed to allocate memory for Result Array in radixSort");
-            exit(EXIT_FAILURE);
+            int temp = count[digit];
+            count[digit] = offset;
+            offset += temp;
         }
 
-        for (int i = vector->length - 1; i >= 0; i--)
+        for (int i = 0; i < length; i++)
         {
-            int digit = (vector->array[i] / place) % 10;
-            result[--counter[digit]] = vector->array[i];
+            unsigned int key = source[i];
+            destination[count[(key >> shift) & mask]++] = key;
         }
 
-        for (int i = 0; i < vector->length; i++)
-            vector->array[i] = result[i];
-
-        free(result);
+        unsigned int *temp = source;
+        source = destination;
+        destination = temp;
     }
+
+    unsigned int *result = (unsigned int *)vector->array;
+    for (int i = 0; i < length; i++)
+        result[i] = source[i] ^ sign;
+
+    free(counter);
+    free(buffer);
 }
 
 /**
- * @brief Merges two sorted vectors into a single sorted vector.
- * @param vector A pointer to the destination vector.
- * @param left A pointer to the first sorted vector (subarray).
- * @param right A pointer to the second sorted vector (subarray).
+ * @brief Length of the runs that merge sort builds with insertion sort before merging.
+ * @note Define this before including the header to override the default.
+ */
+#ifndef MERGE_SORT_CUTOFF
+#define MERGE_SORT_CUTOFF 32
+#endif
+
+/**
+ * @brief Merges two adjacent sorted runs of a source array into a destination array.
+ * @param source A pointer to the array holding both runs.
+ * @param destination A pointer to the array receiving the merged run.
+ * @param start The starting index of the left run (inclusive).
+ * @param mid The starting index of the right run.
+ * @param end The ending index of the right run (exclusive).
  * @note This is a private helper function for mergeSort.
  */
-void __merge__(Vector *vector, const Vector *left, const Vector *right)
+void __merge__(const int *source, int *destination, const int start, const int mid, const int end)
 {
-    int l = 0, r = 0, i = 0;
+    if (mid == end || source[mid - 1] <= source[mid])
+    {
+        memcpy(destination + start, source + start, (end - start) * sizeof(int));
+        return;
+    }
 
-    while (l < left->length && r < right->length)
+    int l = start, r = mid, i = start;
+    while (l < mid && r < end)
     {
-        if (left->array[l] <= right->array[r])
-            vector->array[i++] = left->array[l++];
+        if (source[l] <= source[r])
+            destination[i++] = source[l++];
         else
-            vector->array[i++] = right->array[r++];
+            destination[i++] = source[r++];
     }
 
-    while (l < left->length)
-        vector->array[i++] = left->array[l++];
-    while (r < right->length)
-        vector->array[i++] = right->array[r++];
+    memcpy(destination + i, source + l, (mid - l) * sizeof(int));
+    i += mid - l;
+    memcpy(destination + i, source + r, (end - r) * sizeof(int));
 }
 
 /**
- * @brief Sorts the vector using the merge sort algorithm.
+ * @brief Sorts the vector using a bottom-up merge sort with a caller-supplied scratch buffer.
  * @param vector A pointer to the vector to sort.
- * @note This is a recursive, top-down implementation.
+ * @param buffer A scratch array of at least `vector->length` integers, or NULL to allocate one internally.
+ * @note Runs of MERGE_SORT_CUTOFF elements are insertion sorted first, then merged while
+ * ping-ponging between the vector and the buffer, so no allocation happens per level.
+ * @note Exits the program if the internal buffer cannot be allocated.
  */
-void mergeSort(Vector *vector)
+void mergeSortBuffered(Vector *vector, int *buffer)
 {
     if (vector == NULL || vector->length <= 1)
         return;
 
-    int mid = vector->length / 2;
-    Vector left = slice(vector, 0, mid);
-    Vector right = slice(vector, mid, vector->length);
-
-    mergeSort(&left);
-    mergeSort(&right);
-
-    __merge__(vector, &left, &right);
-
-    destroy(&left);
-    destroy(&right);
-}
-
-/**
- * @brief Partitions the vector for the quick sort algorithm.
- * @param vector A pointer to the vector.
- * @param start The starting index of the partition.
- * @param end The ending index of the partition.
- * @note This is a private helper function.
- */
-void __partition__(Vector *vector, const int start, const int end)
-{
-    if (end - start <= 0)
-        return;
+    int length = vector->length;
+    int *owned = NULL;
+    if (buffer == NULL)
+    {
+        owned = (int *)malloc(length * sizeof(int));
+        if (owned == NULL)
+        {
+            perror("Failed to allocate memory for Scratch Buffer in mergeSort");
+            exit(EXIT_FAILURE);
+        }
+        buffer = owned;
+    }
 
-    int pivot = vector->array[end];
-    int i = start - 1;
+    for (int start = 0; start < length; start += MERGE_SORT_CUTOFF)
+        __insertionSort__(vector->array, start, length - start < MERGE_SORT_CUTOFF ? length : start + MERGE_SORT_CUTOFF);
 
-    for (int j = start; j <= end; j++)
-        if (vector->array[j] <= pivot)
-            __swap__(&vector->array[++i], &vector->array[j]);
+    int *source = vector->array;
+    int *destination = buffer;
+    for (long long width = MERGE_SORT_CUTOFF; width < length; width *= 2)
+    {
+        for (long long start = 0; start < length; start += 2 * width)
+        {
+            int mid = start + width < length ? (int)(start + width) : length;
+            int end = start + 2 * width < length ? (int)(start + 2 * width) : length;
+            __merge__(source, destination, (int)start, mid, end);
+        }
+        int *temp = source;
+        source = destination;
+        destination = temp;
+    }
 
-    __partition__(vector, start, i - 1);
-    __partition__(vector, i + 1, end);
+    if (source != vector->array)
+        memcpy(vector->array, source, length * sizeof(int));
+    free(owned);
 }
 
 /**
- * @brief Sorts the vector using the quick sort algorithm.
+ * @brief Sorts the vector using the merge sort algorithm.
  * @param vector A pointer to the vector to sort.
+ * @note This is a bottom-up implementation that allocates a single scratch buffer per call.
  */
-void quickSort(Vector *const vector)
+void mergeSort(Vector *vector)
 {
-    if (vector == NULL || vector->length <= 1)
-        return;
-    __partition__(vector, 0, vector->length - 1);
+    mergeSortBuffered(vector, NULL);
 }
 
 /**
- * @brief Helper function to build a max-heap.
- * @param vector A pointer to the vector.
+ * @brief Restores the max-heap property by sifting an element down.
+ * @param array A pointer to the array holding the heap.
  * @param size The current size of the heap.
  * @param index The root of the subtree to heapify.
  * @note This is a private helper function for heapSort.
  */
-void __heapify__(Vector *vector, const int size, const int index)
+void __heapify__(int *array, const int size, int index)
 {
-    int largest = index;
-    int left = 2 * index + 1;
-    int right = 2 * index + 2;
-
-    if (left < size && vector->array[left] > vector->array[largest])
-        largest = left;
+    int value = array[index];
+    while (true)
+    {
+        int child = 2 * index + 1;
+        if (child >= size)
+            break;
+        if (child + 1 < size && array[child + 1] > array[child])
+            child++;
+        if (array[child] <= value)
+            break;
+        array[index] = array[child];
+        index = child;
+    }
+    array[index] = value;
+}
 
-    if (right < size && vector->array[right] > vector->array[largest])
-        largest = right;
+/**
+ * @brief Sorts an array using the heap sort algorithm.
+ * @param array A pointer to the array.
+ * @param length The number of elements to sort.
+ * @note This is a private helper function shared by heapSort and quickSort.
+ */
+void __heapSort__(int *array, const int length)
+{
+    for (int i = length / 2 - 1; i >= 0; i--)
+        __heapify__(array, length, i);
 
-    if (largest != index)
+    for (int i = length - 1; i > 0; i--)
     {
-        __swap__(&vector->array[index], &vector->array[largest]);
-        __heapify__(vector, size, largest);
+        __swap__(&array[0], &array[i]);
+        __heapify__(array, i, 0);
     }
 }
 
@@ -844,21 +1317,669 @@ void heapSort(Vector *vector)
 {
     if (vector == NULL || vector->length <= 1)
         return;
-
-    for (int i = vector->length / 2 - 1; i >= 0; i--)
-        __heapify__(vector, vector->length, i);
-
-    for (int i = vector->length - 1; i > 0; i--)
-    {
-        __swap__(&vector->array[0], &vector->array[i]);
-        __heapify__(vector, i, 0);
-    }
+    __heapSort__(vector->array, vector->length);
 }
 
 /**
- * @brief Applies a function to each element of the vector.
- * @param vector A pointer to the vector.
- * @param func A function pointer that takes an integer and returns an integer.
+ * @brief Range length below which quick sort hands over to insertion sort.
+ * @note Define this before including the header to override the default.
+ */
+#ifndef QUICK_SORT_CUTOFF
+#define QUICK_SORT_CUTOFF 16
+#endif
+
+/**
+ * @brief Returns the index holding the median of three array elements.
+ * @param array A pointer to the array.
+ * @param a The index of the first candidate.
+ * @param b The index of the second candidate.
+ * @param c The index of the third candidate.
+ * @return The index of the median candidate.
+ * @note This is a private helper function.
+ */
+int __medianOfThree__(const int *array, const int a, const int b, const int c)
+{
+    if (array[a] < array[b])
+        return array[b] < array[c] ? b : (array[a] < array[c] ? c : a);
+    return array[a] < array[c] ? a : (array[b] < array[c] ? c : b);
+}
+
+/**
+ * @brief Chooses a pivot for a range using median-of-three, or Tukey's ninther for large ranges.
+ * @param array A pointer to the array.
+ * @param start The starting index of the range (inclusive).
+ * @param end The ending index of the range (exclusive).
+ * @return The pivot value.
+ * @note This is a private helper function.
+ */
+int __pivot__(const int *array, const int start, const int end)
+{
+    int length = end - start;
+    int mid = start + length / 2;
+    if (length > 128)
+    {
+        int step = length / 8;
+        int a = __medianOfThree__(array, start, start + step, start + 2 * step);
+        int b = __medianOfThree__(array, mid - step, mid, mid + step);
+        int c = __medianOfThree__(array, end - 1 - 2 * step, end - 1 - step, end - 1);
+        return array[__medianOfThree__(array, a, b, c)];
+    }
+    return array[__medianOfThree__(array, start, mid, end - 1)];
+}
+
+/**
+ * @brief Partitions a range into elements less than, equal to, and greater than a pivot.
+ * @param array A pointer to the array.
+ * @param start The starting index of the range (inclusive).
+ * @param end The ending index of the range (exclusive).
+ * @param pivot The pivot value.
+ * @param lower Receives the first index of the elements equal to the pivot.
+ * @param upper Receives the first index of the elements greater than the pivot.
+ * @note This is a private helper function.
+ */
+void __partition__(int *array, const int start, const int end, const int pivot, int *lower, int *upper)
+{
+    // Bentley-McIlroy: equal keys are parked at both ends, then swapped into the middle.
+    int a = start, b = start, c = end - 1, d = end - 1;
+    while (true)
+    {
+        while (b <= c && array[b] <= pivot)
+        {
+            if (array[b] == pivot)
+                __swap__(&array[a++], &array[b]);
+            b++;
+        }
+        while (c >= b && array[c] >= pivot)
+        {
+            if (array[c] == pivot)
+                __swap__(&array[c], &array[d--]);
+            c--;
+        }
+        if (b > c)
+            break;
+        __swap__(&array[b++], &array[c--]);
+    }
+
+    int count = a - start < b - a ? a - start : b - a;
+    for (int i = 0; i < count; i++)
+        __swap__(&array[start + i], &array[b - count + i]);
+    count = d - c < end - 1 - d ? d - c : end - 1 - d;
+    for (int i = 0; i < count; i++)
+        __swap__(&array[b + i], &array[end - count + i]);
+
+    *lower = start + (b - a);
+    *upper = end - (d - c);
+}
+
+/**
+ * @brief Sorts a range using introsort.
+ * @param array A pointer to the array.
+ * @param start The starting index of the range (inclusive).
+ * @param end The ending index of the range (exclusive).
+ * @param depth The remaining partitioning depth before falling back to heap sort.
+ * @note This is a private helper function. It recurses only into the smaller side,
+ * so the stack depth stays logarithmic.
+ */
+void __introSort__(int *array, int start, int end, int depth)
+{
+    while (end - start > QUICK_SORT_CUTOFF)
+    {
+        if (depth-- == 0)
+        {
+            __heapSort__(array + start, end - start);
+            return;
+        }
+
+        int lower, upper;
+        __partition__(array, start, end, __pivot__(array, start, end), &lower, &upper);
+
+        if (lower - start < end - upper)
+        {
+            __introSort__(array, start, lower, depth);
+            start = upper;
+        }
+        else
+        {
+            __introSort__(array, upper, end, depth);
+            end = lower;
+        }
+    }
+    __insertionSort__(array, start, end);
+}
+
+/**
+ * @brief Computes the introsort depth limit of 2 * floor(log2(length)).
+ * @param length The number of elements to sort.
+ * @return The depth limit.
+ * @note This is a private helper function.
+ */
+int __depthLimit__(int length)
+{
+    int depth = 0;
+    while (length > 1)
+    {
+        length >>= 1;
+        depth += 2;
+    }
+    return depth;
+}
+
+/**
+ * @brief Sorts the vector using the quick sort algorithm.
+ * @param vector A pointer to the vector to sort.
+ * @note This is an introsort: ninther pivots, three-way partitioning for duplicate keys,
+ * and a heap sort fallback once the depth passes 2 * log2(n).
+ */
+void quickSort(Vector *const vector)
+{
+    if (vector == NULL || vector->length <= 1)
+        return;
+    __introSort__(vector->array, 0, vector->length, __depthLimit__(vector->length));
+}
+
+#ifdef VECTOR_THREADS
+
+/**
+ * @brief Returns the number of online processors.
+ * @return The processor count, or 1 if it cannot be determined.
+ * @note This is a private helper function.
+ */
+int __processorCount__()
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+}
+
+/**
+ * @brief Shared state of the persistent thread pool behind parallelSort and pipelines.
+ * @details Helper threads sleep on `wake` until `generation` changes, then pull task indices
+ * from `next` until `tasks` is reached. The calling thread works too and waits on `done` until
+ * every helper has finished. All fields are protected by `lock`.
+ * @note This is a private helper type.
+ */
+typedef struct
+{
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    pthread_t *handles;
+    int spawned;
+    int ready;
+    int pending;
+    unsigned long generation;
+    bool busy;
+    void (*func)(void *, int);
+    void *context;
+    int tasks;
+    int next;
+} __VectorPool__;
+
+/**
+ * @brief Returns the single thread pool shared by every parallel Vector operation.
+ * @return A pointer to the pool.
+ * @note This is a private helper function.
+ */
+__VectorPool__ *__vectorPool__()
+{
+    static __VectorPool__ pool = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER,
+                                  NULL, 0, 0, 0, 0, false, NULL, NULL, 0, 0};
+    return &pool;
+}
+
+/**
+ * @brief Runs tasks of the current job until none are left.
+ * @param pool The pool, unlocked on entry and on return.
+ * @note This is a private helper function.
+ */
+void __vectorPoolDrain__(__VectorPool__ *pool)
+{
+    pthread_mutex_lock(&pool->lock);
+    while (pool->next < pool->tasks)
+    {
+        int task = pool->next++;
+        void (*func)(void *, int) = pool->func;
+        void *context = pool->context;
+        pthread_mutex_unlock(&pool->lock);
+        func(context, task);
+        pthread_mutex_lock(&pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief Main loop of a helper thread: sleeps until a job is posted, helps finish it, and repeats.
+ * @param arg Unused.
+ * @return Never returns; helpers live as long as the process.
+ * @note This is a private helper function.
+ */
+void *__vectorPoolWorker__(void *arg)
+{
+    (void)arg;
+    __VectorPool__ *pool = __vectorPool__();
+    pthread_mutex_lock(&pool->lock);
+    unsigned long seen = pool->generation;
+    pool->ready++;
+    pthread_cond_broadcast(&pool->done);
+    while (true)
+    {
+        while (pool->generation == seen)
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+        __vectorPoolDrain__(pool);
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0)
+            pthread_cond_signal(&pool->done);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Runs `func(context, task)` for every task in [0, tasks) on the thread pool and waits for all of them.
+ * @param tasks The number of tasks, e.g. one per chunk of the input.
+ * @param func The function to run. Tasks of one call must not wait for each other, since they
+ * may run one after another on a single thread.
+ * @param context The shared context passed to every task.
+ * @note This is a private helper function. The pool starts one helper per extra online
+ * processor on first use and reuses them for every later call, so the phases of a parallelSort
+ * cost a wake-up each rather than a round of thread creation. Runs everything on the calling
+ * thread when there is a single task, a single processor, or the pool is already busy (a nested
+ * call, or a call from another application thread). If a thread cannot be created the pool
+ * simply runs with fewer helpers.
+ */
+void __parallelRun__(const int tasks, void (*func)(void *, int), void *context)
+{
+    __VectorPool__ *pool = __vectorPool__();
+    pthread_mutex_lock(&pool->lock);
+    if (pool->handles == NULL && !pool->busy && tasks > 1)
+    {
+        int helpers = __processorCount__() - 1;
+        pool->handles = (pthread_t *)malloc((helpers > 0 ? helpers : 1) * sizeof(pthread_t));
+        while (pool->handles != NULL && pool->spawned < helpers &&
+               pthread_create(&pool->handles[pool->spawned], NULL, __vectorPoolWorker__, NULL) == 0)
+            pool->spawned++;
+        while (pool->ready < pool->spawned)
+            pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    if (pool->busy || pool->spawned == 0 || tasks <= 1)
+    {
+        pthread_mutex_unlock(&pool->lock);
+        for (int task = 0; task < tasks; task++)
+            func(context, task);
+        return;
+    }
+
+    pool->busy = true;
+    pool->func = func;
+    pool->context = context;
+    pool->tasks = tasks;
+    pool->next = 0;
+    pool->pending = pool->spawned;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    __vectorPoolDrain__(pool);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0)
+        pthread_cond_wait(&pool->done, &pool->lock);
+    pool->busy = false;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief Shared state of one parallelSort call.
+ * @details Holds the array and its scratch buffer, the distinct splitters that define the
+ * buckets, and a threads x buckets table of per-chunk bucket counts that becomes scatter offsets.
+ * @note This is a private helper type.
+ */
+typedef struct
+{
+    int *array;
+    int *buffer;
+    int length;
+    int threads;
+    int *splitters;
+    int count;
+    int buckets;
+    int *offsets;
+} __SampleSort__;
+
+/**
+ * @brief Finds the bucket of a value among the 2 * count + 1 buckets defined by the splitters.
+ * @param splitters A pointer to the sorted, distinct splitters.
+ * @param count The number of splitters.
+ * @param value The value to classify.
+ * @return 2 * i + 1 if the value equals splitter i (an equal-key bucket), otherwise 2 * i, where
+ * i is the number of splitters strictly less than the value.
+ * @note This is a private helper function. Equal-key buckets hold a single repeated value, so
+ * they need no sorting; a dominant key therefore never ends up sorted by one thread.
+ */
+int __bucketOf__(const int *splitters, const int count, const int value)
+{
+    int bucket = 0;
+    for (int step = count; step > 0; step /= 2)
+        while (bucket + step <= count && splitters[bucket + step - 1] < value)
+            bucket += step;
+    return 2 * bucket + (bucket < count && splitters[bucket] == value);
+}
+
+/**
+ * @brief Counts how many elements of a worker's chunk fall into each bucket.
+ * @param context A pointer to the __SampleSort__ state.
+ * @param thread The worker index, which selects both the chunk and the row of the count table.
+ * @note This is a private helper function for parallelSort.
+ */
+void __sampleSortCount__(void *context, int thread)
+{
+    __SampleSort__ *job = (__SampleSort__ *)context;
+    int from = (int)((long long)job->length * thread / job->threads);
+    int to = (int)((long long)job->length * (thread + 1) / job->threads);
+    int *counts = job->offsets + thread * job->buckets;
+    for (int i = from; i < to; i++)
+        counts[__bucketOf__(job->splitters, job->count, job->array[i])]++;
+}
+
+/**
+ * @brief Scatters a worker's chunk into the scratch buffer at its precomputed bucket offsets.
+ * @param context A pointer to the __SampleSort__ state.
+ * @param thread The worker index.
+ * @note This is a private helper function for parallelSort.
+ */
+void __sampleSortScatter__(void *context, int thread)
+{
+    __SampleSort__ *job = (__SampleSort__ *)context;
+    int from = (int)((long long)job->length * thread / job->threads);
+    int to = (int)((long long)job->length * (thread + 1) / job->threads);
+    int *offsets = job->offsets + thread * job->buckets;
+    for (int i = from; i < to; i++)
+    {
+        int value = job->array[i];
+        job->buffer[offsets[__bucketOf__(job->splitters, job->count, value)]++] = value;
+    }
+}
+
+/**
+ * @brief Sorts one range bucket in the scratch buffer.
+ * @param context A pointer to the __SampleSort__ state.
+ * @param thread The worker index; worker t sorts range bucket 2 * t, if there is one.
+ * @note This is a private helper function for parallelSort. After scattering, the offsets
+ * of the last chunk hold the end of every bucket. There are at most `threads` range buckets.
+ */
+void __sampleSortBucket__(void *context, int thread)
+{
+    __SampleSort__ *job = (__SampleSort__ *)context;
+    int bucket = 2 * thread;
+    if (bucket >= job->buckets)
+        return;
+    const int *ends = job->offsets + (job->threads - 1) * job->buckets;
+    int from = bucket == 0 ? 0 : ends[bucket - 1];
+    int to = ends[bucket];
+    __introSort__(job->buffer, from, to, __depthLimit__(to - from));
+}
+
+/**
+ * @brief Copies a worker's chunk of the sorted scratch buffer back into the array.
+ * @param context A pointer to the __SampleSort__ state.
+ * @param thread The worker index, which selects the chunk.
+ * @note This is a private helper function for parallelSort. Copying by chunk rather than by
+ * bucket keeps the work even when one equal-key bucket holds most of the elements.
+ */
+void __sampleSortCopy__(void *context, int thread)
+{
+    __SampleSort__ *job = (__SampleSort__ *)context;
+    int from = (int)((long long)job->length * thread / job->threads);
+    int to = (int)((long long)job->length * (thread + 1) / job->threads);
+    memcpy(job->array + from, job->buffer + from, (to - from) * sizeof(int));
+}
+
+/**
+ * @brief Minimum length for which parallelSort uses the thread pool, and the number of elements
+ * each extra thread must have to work on.
+ * @note Define this before including the header to override the default.
+ */
+#ifndef PARALLEL_SORT_CUTOFF
+#define PARALLEL_SORT_CUTOFF 65536
+#endif
+
+/**
+ * @brief Sorts the vector on several threads using a parallel sample sort.
+ * @param vector A pointer to the vector to sort.
+ * @param threads The number of threads to use, or <= 0 to use every online processor. Clamped to
+ * the number of online processors and to one thread per PARALLEL_SORT_CUTOFF elements, so the
+ * bucket tables and the sample stay small relative to the vector.
+ * @note Splitters are drawn from an oversampled, sorted sample and deduplicated. Each thread
+ * then counts and scatters its chunk into per-bucket ranges of a scratch buffer, introsorts one
+ * bucket and copies its chunk back, so every phase runs in parallel. Each distinct splitter gets
+ * its own equal-key bucket, which needs no sorting, so duplicate-heavy input (a dominant value,
+ * a small key range) still spreads across the threads. The result is identical to quickSort.
+ * @note Runs on the persistent thread pool, so its four phases reuse the same threads.
+ * @note Exits the program if memory allocation fails.
+ */
+void parallelSort(Vector *vector, int threads)
+{
+    if (vector == NULL || vector->length <= 1)
+        return;
+    int processors = __processorCount__();
+    int limit = vector->length / PARALLEL_SORT_CUTOFF + 1;
+    if (threads <= 0 || threads > processors)
+        threads = processors;
+    if (threads > limit)
+        threads = limit;
+    if (threads == 1 || vector->length < PARALLEL_SORT_CUTOFF)
+    {
+        quickSort(vector);
+        return;
+    }
+
+    int oversampling = 64;
+    int samples = threads * oversampling;
+    __SampleSort__ job;
+    job.array = vector->array;
+    job.length = vector->length;
+    job.threads = threads;
+    job.buffer = (int *)malloc(vector->length * sizeof(int));
+    job.splitters = (int *)malloc(samples * sizeof(int));
+    job.offsets = (int *)calloc((size_t)threads * (2 * threads - 1), sizeof(int));
+    if (job.buffer == NULL || job.splitters == NULL || job.offsets == NULL)
+    {
+        perror("Failed to allocate memory for Buckets in parallelSort");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int i = 0; i < samples; i++)
+        job.splitters[i] = vector->array[(long long)vector->length * i / samples + (long long)vector->length / samples / 2];
+    __introSort__(job.splitters, 0, samples, __depthLimit__(samples));
+    job.count = 0;
+    for (int b = 1; b < threads; b++)
+        if (job.count == 0 || job.splitters[b * oversampling] != job.splitters[job.count - 1])
+            job.splitters[job.count++] = job.splitters[b * oversampling];
+    job.buckets = 2 * job.count + 1;
+
+    __parallelRun__(threads, __sampleSortCount__, &job);
+
+    int offset = 0;
+    for (int b = 0; b < job.buckets; b++)
+        for (int t = 0; t < threads; t++)
+        {
+            int count = job.offsets[t * job.buckets + b];
+            job.offsets[t * job.buckets + b] = offset;
+            offset += count;
+        }
+
+    __parallelRun__(threads, __sampleSortScatter__, &job);
+    __parallelRun__(threads, __sampleSortBucket__, &job);
+    __parallelRun__(threads, __sampleSortCopy__, &job);
+
+    free(job.buffer);
+    free(job.splitters);
+    free(job.offsets);
+}
+
+#endif // VECTOR_THREADS
+
+/**
+ * @brief Range length above which selection picks its pivot with Floyd-Rivest sampling.
+ * @note Define this before including the header to override the default.
+ */
+#ifndef SELECT_SAMPLE_CUTOFF
+#define SELECT_SAMPLE_CUTOFF 600
+#endif
+
+/**
+ * @brief Moves the element that belongs at `nth` in sorted order into place within a range.
+ * @param array A pointer to the array.
+ * @param start The starting index of the range (inclusive).
+ * @param end The ending index of the range (exclusive).
+ * @param nth The target index, with start <= nth < end.
+ * @param depth The remaining partitioning depth before falling back to heap sort.
+ * @note This is a private helper function. Afterwards no element before `nth` is greater than
+ * `array[nth]` and no element after it is smaller.
+ * @note On large ranges the pivot comes from Floyd-Rivest sampling: a recursive selection on a
+ * small window around `nth` whose result is almost always close to the target, so each pass
+ * discards most of the range. Smaller ranges use the introsort pivot and three-way partition.
+ */
+void __introSelect__(int *array, int start, int end, const int nth, int depth)
+{
+    while (end - start > QUICK_SORT_CUTOFF)
+    {
+        if (depth-- == 0)
+        {
+            __heapSort__(array + start, end - start);
+            return;
+        }
+
+        int pivot;
+        if (end - start > SELECT_SAMPLE_CUTOFF)
+        {
+            double n = end - start, i = nth - start + 1;
+            double z = log(n);
+            double sample = 0.5 * exp(2.0 * z / 3.0);
+            double deviation = 0.5 * sqrt(z * sample * (n - sample) / n) * (i < n / 2 ? -1.0 : 1.0);
+            int from = (int)(nth - i * sample / n + deviation);
+            int to = (int)(nth + (n - i) * sample / n + deviation) + 1;
+            from = from < start ? start : (from > nth ? nth : from);
+            to = to > end ? end : (to <= nth ? nth + 1 : to);
+            __introSelect__(array, from, to, nth, depth);
+            pivot = array[nth];
+        }
+        else
+            pivot = __pivot__(array, start, end);
+
+        int lower, upper;
+        __partition__(array, start, end, pivot, &lower, &upper);
+        if (nth < lower)
+            end = lower;
+        else if (nth >= upper)
+            start = upper;
+        else
+            return;
+    }
+    __insertionSort__(array, start, end);
+}
+
+/**
+ * @brief Partially sorts the vector so that the element at index n is the one a full sort would put there.
+ * @param vector A pointer to the vector.
+ * @param n The index to select, e.g. length / 2 for the median.
+ * @note Afterwards no element before index n is greater than it and no element after it is
+ * smaller; the order within either side is unspecified. Runs in expected O(n) time using
+ * introselect with Floyd-Rivest pivot sampling, falling back to heap sort on adversarial input.
+ * @note This function does nothing if n is out of bounds.
+ */
+void nthElement(Vector *vector, const int n)
+{
+    if (vector == NULL || n < 0 || n >= vector->length)
+        return;
+    __introSelect__(vector->array, 0, vector->length, n, __depthLimit__(vector->length));
+}
+
+/**
+ * @brief Sorts the k smallest elements of the vector into its first k positions.
+ * @param vector A pointer to the vector.
+ * @param k The number of leading elements to sort; clamped to the vector's length.
+ * @note The order of the remaining elements is unspecified. Runs in O(n + k log k) time: the k
+ * smallest are selected with nthElement, then only they are sorted.
+ */
+void partialSort(Vector *vector, int k)
+{
+    if (vector == NULL || k <= 0 || vector->length <= 1)
+        return;
+    if (k > vector->length)
+        k = vector->length;
+    if (k < vector->length)
+        __introSelect__(vector->array, 0, vector->length, k - 1, __depthLimit__(vector->length));
+    __introSort__(vector->array, 0, k, __depthLimit__(k));
+}
+
+/**
+ * @brief Restores the min-heap property by sifting an element down.
+ * @param array A pointer to the array holding the heap.
+ * @param size The current size of the heap.
+ * @param index The root of the subtree to sift.
+ * @note This is a private helper function for topK.
+ */
+void __siftDownMin__(int *array, const int size, int index)
+{
+    int value = array[index];
+    while (true)
+    {
+        int child = 2 * index + 1;
+        if (child >= size)
+            break;
+        if (child + 1 < size && array[child + 1] < array[child])
+            child++;
+        if (array[child] >= value)
+            break;
+        array[index] = array[child];
+        index = child;
+    }
+    array[index] = value;
+}
+
+/**
+ * @brief Returns the k largest elements of the vector in descending order.
+ * @param vector A pointer to the vector. It is not modified.
+ * @param k The number of elements to return; clamped to the vector's length.
+ * @return A new Vector holding the k largest elements, largest first.
+ * @note Streams the vector once through a min-heap bounded to k elements, so it runs in
+ * O(n log k) time and O(k) extra space. Most elements only cost one comparison with the root.
+ * @note Returns a new vector with capacity 1 if the vector is empty or k <= 0.
+ */
+Vector topK(const Vector *vector, int k)
+{
+    if (isEmpty(vector) || k <= 0)
+        return init(1);
+    if (k > vector->length)
+        k = vector->length;
+
+    Vector heap = init(k);
+    memcpy(heap.array, vector->array, k * sizeof(int));
+    heap.length = k;
+    for (int i = k / 2 - 1; i >= 0; i--)
+        __siftDownMin__(heap.array, k, i);
+    for (int i = k; i < vector->length; i++)
+    {
+        if (vector->array[i] > heap.array[0])
+        {
+            heap.array[0] = vector->array[i];
+            __siftDownMin__(heap.array, k, 0);
+        }
+    }
+
+    for (int i = k - 1; i > 0; i--)
+    {
+        __swap__(&heap.array[0], &heap.array[i]);
+        __siftDownMin__(heap.array, i, 0);
+    }
+    return heap;
+}
+
+/**
+ * @brief Applies a function to each element of the vector.
+ * @param vector A pointer to the vector.
+ * @param func A function pointer that takes an integer and returns an integer.
  */
 void map(Vector *vector, int (*func)(int))
 {
@@ -896,19 +2017,500 @@ bool any(const Vector *vector)
 }
 
 /**
- * @brief Checks if all elements in the vector are non-zero (true).
- * @param vector A pointer to the vector.
- * @return true if all elements are non-zero, false otherwise.
+ * @brief Checks if all elements in the vector are non-zero (true).
+ * @param vector A pointer to the vector.
+ * @return true if all elements are non-zero, false otherwise.
+ */
+bool all(const Vector *vector)
+{
+    if (isEmpty(vector))
+        return true;
+    for (int i = 0; i < vector->length; i++)
+        if (!vector->array[i])
+            return false;
+    return true;
+}
+
+/**
+ * @brief Detects the widest SIMD instruction set the reductions can use on this CPU.
+ * @return 2 for AVX2, 1 for SSE2, or 0 for the portable scalar loops.
+ * @note This is a private helper function. The answer is computed once and cached.
+ * @note Define VECTOR_NO_SIMD before including the header to always use the scalar loops.
+ */
+int __simdLevel__()
+{
+    static int level = -1;
+    if (level < 0)
+    {
+        int detected = 0;
+#ifdef VECTOR_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            detected = 2;
+        else if (__builtin_cpu_supports("sse2"))
+            detected = 1;
+#endif
+        level = detected;
+    }
+    return level;
+}
+
+/**
+ * @brief Sums an array, wrapping on overflow.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @return The wrapped sum.
+ * @note This is a private helper function.
+ */
+int __sumScalar__(const int *array, const int length)
+{
+    unsigned int total = 0;
+    for (int i = 0; i < length; i++)
+        total += (unsigned int)array[i];
+    return (int)total;
+}
+
+/**
+ * @brief Sums an array into a 64-bit accumulator.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @return The sum.
+ * @note This is a private helper function.
+ */
+long long __sum64Scalar__(const int *array, const int length)
+{
+    long long total = 0;
+    for (int i = 0; i < length; i++)
+        total += array[i];
+    return total;
+}
+
+/**
+ * @brief Multiplies the elements of an array, wrapping on overflow.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @return The wrapped product.
+ * @note This is a private helper function.
+ */
+int __prodScalar__(const int *array, const int length)
+{
+    unsigned int product = 1;
+    for (int i = 0; i < length; i++)
+        product *= (unsigned int)array[i];
+    return (int)product;
+}
+
+/**
+ * @brief Finds the maximum of a non-empty array.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @return The maximum value.
+ * @note This is a private helper function.
+ */
+int __maxScalar__(const int *array, const int length)
+{
+    int maximum = array[0];
+    for (int i = 1; i < length; i++)
+        if (maximum < array[i])
+            maximum = array[i];
+    return maximum;
+}
+
+/**
+ * @brief Finds the minimum of a non-empty array.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @return The minimum value.
+ * @note This is a private helper function.
+ */
+int __minScalar__(const int *array, const int length)
+{
+    int minimum = array[0];
+    for (int i = 1; i < length; i++)
+        if (minimum > array[i])
+            minimum = array[i];
+    return minimum;
+}
+
+/**
+ * @brief Counts the occurrences of a value in an array.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @param value The value to look for.
+ * @return The number of occurrences.
+ * @note This is a private helper function.
+ */
+int __countScalar__(const int *array, const int length, const int value)
+{
+    int freq = 0;
+    for (int i = 0; i < length; i++)
+        freq += array[i] == value;
+    return freq;
+}
+
+/**
+ * @brief Checks if a value occurs in an array.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @param value The value to look for.
+ * @return true if the value is found, false otherwise.
+ * @note This is a private helper function.
+ */
+bool __containsScalar__(const int *array, const int length, const int value)
+{
+    for (int i = 0; i < length; i++)
+        if (array[i] == value)
+            return true;
+    return false;
+}
+
+#ifdef VECTOR_SIMD
+/**
+ * @brief Sums an array four lanes at a time with SSE2, wrapping on overflow.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @return The wrapped sum.
+ * @note This is a private helper function.
+ */
+__attribute__((target("sse2"))) int __sumSSE2__(const int *array, const int length)
+{
+    __m128i a = _mm_setzero_si128(), b = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        a = _mm_add_epi32(a, _mm_loadu_si128((const __m128i *)(array + i)));
+        b = _mm_add_epi32(b, _mm_loadu_si128((const __m128i *)(array + i + 4)));
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i *)lanes, _mm_add_epi32(a, b));
+    return (int)((unsigned int)__sumScalar__(lanes, 4) + (unsigned int)__sumScalar__(array + i, length - i));
+}
+
+/**
+ * @brief Sums an array four lanes at a time with SSE2 into a 64-bit accumulator.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @return The sum.
+ * @note This is a private helper function.
+ */
+__attribute__((target("sse2"))) long long __sum64SSE2__(const int *array, const int length)
+{
+    __m128i a = _mm_setzero_si128(), b = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= length; i += 4)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i *)(array + i));
+        __m128i sign = _mm_srai_epi32(x, 31);
+        a = _mm_add_epi64(a, _mm_unpacklo_epi32(x, sign));
+        b = _mm_add_epi64(b, _mm_unpackhi_epi32(x, sign));
+    }
+    long long lanes[2];
+    _mm_storeu_si128((__m128i *)lanes, _mm_add_epi64(a, b));
+    return lanes[0] + lanes[1] + __sum64Scalar__(array + i, length - i);
+}
+
+/**
+ * @brief Multiplies four pairs of 32-bit lanes, keeping the low 32 bits of each product.
+ * @param a The first operand.
+ * @param b The second operand.
+ * @return The lane-wise low products.
+ * @note This is a private helper function. SSE2 has no 32-bit low multiply, so even and odd
+ * lanes go through the 64-bit one.
+ */
+__attribute__((target("sse2"))) __m128i __mulloSSE2__(const __m128i a, const __m128i b)
+{
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/**
+ * @brief Multiplies the elements of an array four lanes at a time with SSE2, wrapping on overflow.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @return The wrapped product.
+ * @note This is a private helper function.
+ */
+__attribute__((target("sse2"))) int __prodSSE2__(const int *array, const int length)
+{
+    __m128i product = _mm_set1_epi32(1);
+    int i = 0;
+    for (; i + 4 <= length; i += 4)
+        product = __mulloSSE2__(product, _mm_loadu_si128((const __m128i *)(array + i)));
+    int lanes[4];
+    _mm_storeu_si128((__m128i *)lanes, product);
+    return (int)((unsigned int)__prodScalar__(lanes, 4) * (unsigned int)__prodScalar__(array + i, length - i));
+}
+
+/**
+ * @brief Finds the maximum of a non-empty array four lanes at a time with SSE2.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @return The maximum value.
+ * @note This is a private helper function.
+ */
+__attribute__((target("sse2"))) int __maxSSE2__(const int *array, const int length)
+{
+    __m128i maximum = _mm_set1_epi32(array[0]);
+    int i = 0;
+    for (; i + 4 <= length; i += 4)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i *)(array + i));
+        __m128i greater = _mm_cmpgt_epi32(x, maximum);
+        maximum = _mm_or_si128(_mm_and_si128(greater, x), _mm_andnot_si128(greater, maximum));
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i *)lanes, maximum);
+    int result = __maxScalar__(lanes, 4);
+    for (; i < length; i++)
+        if (array[i] > result)
+            result = array[i];
+    return result;
+}
+
+/**
+ * @brief Finds the minimum of a non-empty array four lanes at a time with SSE2.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @return The minimum value.
+ * @note This is a private helper function.
+ */
+__attribute__((target("sse2"))) int __minSSE2__(const int *array, const int length)
+{
+    __m128i minimum = _mm_set1_epi32(array[0]);
+    int i = 0;
+    for (; i + 4 <= length; i += 4)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i *)(array + i));
+        __m128i less = _mm_cmplt_epi32(x, minimum);
+        minimum = _mm_or_si128(_mm_and_si128(less, x), _mm_andnot_si128(less, minimum));
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i *)lanes, minimum);
+    int result = __minScalar__(lanes, 4);
+    for (; i < length; i++)
+        if (array[i] < result)
+            result = array[i];
+    return result;
+}
+
+/**
+ * @brief Counts the occurrences of a value in an array four lanes at a time with SSE2.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @param value The value to look for.
+ * @return The number of occurrences.
+ * @note This is a private helper function.
+ */
+__attribute__((target("sse2"))) int __countSSE2__(const int *array, const int length, const int value)
+{
+    __m128i key = _mm_set1_epi32(value);
+    __m128i a = _mm_setzero_si128(), b = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        a = _mm_sub_epi32(a, _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(array + i)), key));
+        b = _mm_sub_epi32(b, _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(array + i + 4)), key));
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i *)lanes, _mm_add_epi32(a, b));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + __countScalar__(array + i, length - i, value);
+}
+
+/**
+ * @brief Checks if a value occurs in an array four lanes at a time with SSE2.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @param value The value to look for.
+ * @return true if the value is found, false otherwise.
+ * @note This is a private helper function.
+ */
+__attribute__((target("sse2"))) bool __containsSSE2__(const int *array, const int length, const int value)
+{
+    __m128i key = _mm_set1_epi32(value);
+    int i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i a = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(array + i)), key);
+        __m128i b = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(array + i + 4)), key);
+        __m128i c = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(array + i + 8)), key);
+        __m128i d = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(array + i + 12)), key);
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))))
+            return true;
+    }
+    return __containsScalar__(array + i, length - i, value);
+}
+
+/**
+ * @brief Sums an array eight lanes at a time with AVX2, wrapping on overflow.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @return The wrapped sum.
+ * @note This is a private helper function. Only called after __simdLevel__ reports AVX2.
+ */
+__attribute__((target("avx2"))) int __sumAVX2__(const int *array, const int length)
+{
+    __m256i a = _mm256_setzero_si256(), b = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        a = _mm256_add_epi32(a, _mm256_loadu_si256((const __m256i *)(array + i)));
+        b = _mm256_add_epi32(b, _mm256_loadu_si256((const __m256i *)(array + i + 8)));
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, _mm256_add_epi32(a, b));
+    return (int)((unsigned int)__sumScalar__(lanes, 8) + (unsigned int)__sumScalar__(array + i, length - i));
+}
+
+/**
+ * @brief Sums an array eight lanes at a time with AVX2 into a 64-bit accumulator.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @return The sum.
+ * @note This is a private helper function. Only called after __simdLevel__ reports AVX2.
+ */
+__attribute__((target("avx2"))) long long __sum64AVX2__(const int *array, const int length)
+{
+    __m256i a = _mm256_setzero_si256(), b = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(array + i));
+        a = _mm256_add_epi64(a, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x)));
+        b = _mm256_add_epi64(b, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1)));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, _mm256_add_epi64(a, b));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + __sum64Scalar__(array + i, length - i);
+}
+
+/**
+ * @brief Multiplies the elements of an array eight lanes at a time with AVX2, wrapping on overflow.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @return The wrapped product.
+ * @note This is a private helper function. Only called after __simdLevel__ reports AVX2.
+ */
+__attribute__((target("avx2"))) int __prodAVX2__(const int *array, const int length)
+{
+    __m256i a = _mm256_set1_epi32(1), b = _mm256_set1_epi32(1);
+    int i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        a = _mm256_mullo_epi32(a, _mm256_loadu_si256((const __m256i *)(array + i)));
+        b = _mm256_mullo_epi32(b, _mm256_loadu_si256((const __m256i *)(array + i + 8)));
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, _mm256_mullo_epi32(a, b));
+    return (int)((unsigned int)__prodScalar__(lanes, 8) * (unsigned int)__prodScalar__(array + i, length - i));
+}
+
+/**
+ * @brief Finds the maximum of a non-empty array eight lanes at a time with AVX2.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @return The maximum value.
+ * @note This is a private helper function. Only called after __simdLevel__ reports AVX2.
+ */
+__attribute__((target("avx2"))) int __maxAVX2__(const int *array, const int length)
+{
+    __m256i a = _mm256_set1_epi32(array[0]), b = a;
+    int i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        a = _mm256_max_epi32(a, _mm256_loadu_si256((const __m256i *)(array + i)));
+        b = _mm256_max_epi32(b, _mm256_loadu_si256((const __m256i *)(array + i + 8)));
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, _mm256_max_epi32(a, b));
+    int result = __maxScalar__(lanes, 8);
+    for (; i < length; i++)
+        if (array[i] > result)
+            result = array[i];
+    return result;
+}
+
+/**
+ * @brief Finds the minimum of a non-empty array eight lanes at a time with AVX2.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @return The minimum value.
+ * @note This is a private helper function. Only called after __simdLevel__ reports AVX2.
+ */
+__attribute__((target("avx2"))) int __minAVX2__(const int *array, const int length)
+{
+    __m256i a = _mm256_set1_epi32(array[0]), b = a;
+    int i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        a = _mm256_min_epi32(a, _mm256_loadu_si256((const __m256i *)(array + i)));
+        b = _mm256_min_epi32(b, _mm256_loadu_si256((const __m256i *)(array + i + 8)));
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, _mm256_min_epi32(a, b));
+    int result = __minScalar__(lanes, 8);
+    for (; i < length; i++)
+        if (array[i] < result)
+            result = array[i];
+    return result;
+}
+
+/**
+ * @brief Counts the occurrences of a value in an array eight lanes at a time with AVX2.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @param value The value to look for.
+ * @return The number of occurrences.
+ * @note This is a private helper function. Only called after __simdLevel__ reports AVX2.
+ */
+__attribute__((target("avx2"))) int __countAVX2__(const int *array, const int length, const int value)
+{
+    __m256i key = _mm256_set1_epi32(value);
+    __m256i a = _mm256_setzero_si256(), b = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        a = _mm256_sub_epi32(a, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(array + i)), key));
+        b = _mm256_sub_epi32(b, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(array + i + 8)), key));
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, _mm256_add_epi32(a, b));
+    return __sumScalar__(lanes, 8) + __countScalar__(array + i, length - i, value);
+}
+
+/**
+ * @brief Checks if a value occurs in an array eight lanes at a time with AVX2.
+ * @param array A pointer to the array.
+ * @param length The number of elements.
+ * @param value The value to look for.
+ * @return true if the value is found, false otherwise.
+ * @note This is a private helper function. Only called after __simdLevel__ reports AVX2.
+ */
+__attribute__((target("avx2"))) bool __containsAVX2__(const int *array, const int length, const int value)
+{
+    __m256i key = _mm256_set1_epi32(value);
+    int i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        __m256i a = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(array + i)), key);
+        __m256i b = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(array + i + 8)), key);
+        __m256i c = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(array + i + 16)), key);
+        __m256i d = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(array + i + 24)), key);
+        if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d))))
+            return true;
+    }
+    return __containsScalar__(array + i, length - i, value);
+}
+
+/**
+ * @brief Calls the AVX2, SSE2 or scalar variant of a reduction kernel, whichever the CPU supports.
+ * @note This is a private helper macro.
  */
-bool all(const Vector *vector)
-{
-    if (isEmpty(vector))
-        return true;
-    for (int i = 0; i < vector->length; i++)
-        if (!vector->array[i])
-            return false;
-    return true;
-}
+#define __DISPATCH__(kernel, ...) \
+    (__simdLevel__() == 2 ? kernel##AVX2__(__VA_ARGS__) : __simdLevel__() == 1 ? kernel##SSE2__(__VA_ARGS__) : kernel##Scalar__(__VA_ARGS__))
+#else
+#define __DISPATCH__(kernel, ...) kernel##Scalar__(__VA_ARGS__)
+#endif
 
 /**
  * @brief Finds the maximum value in the vector.
@@ -919,11 +2521,7 @@ int max(const Vector *vector)
 {
     if (isEmpty(vector))
         return -1;
-    int maximum = vector->array[0];
-    for (int i = 1; i < vector->length; i++)
-        if (maximum < vector->array[i])
-            maximum = vector->array[i];
-    return maximum;
+    return __DISPATCH__(__max, vector->array, vector->length);
 }
 
 /**
@@ -935,41 +2533,46 @@ int min(const Vector *vector)
 {
     if (isEmpty(vector))
         return -1;
-    int minimum = vector->array[0];
-    for (int i = 1; i < vector->length; i++)
-        if (minimum > vector->array[i])
-            minimum = vector->array[i];
-    return minimum;
+    return __DISPATCH__(__min, vector->array, vector->length);
 }
 
 /**
  * @brief Calculates the sum of all elements in the vector.
  * @param vector A pointer to the vector.
  * @return The sum of the elements, or 0 if the vector is empty.
+ * @note The sum wraps around on overflow; use sum64 for large vectors.
  */
 int sum(const Vector *vector)
 {
     if (isEmpty(vector))
         return 0;
-    int total = 0;
-    for (int i = 0; i < vector->length; i++)
-        total += vector->array[i];
-    return total;
+    return __DISPATCH__(__sum, vector->array, vector->length);
+}
+
+/**
+ * @brief Calculates the sum of all elements in the vector, accumulating in 64 bits.
+ * @param vector A pointer to the vector.
+ * @return The sum of the elements, or 0 if the vector is empty.
+ * @note Cannot overflow for any vector whose length fits in an int.
+ */
+long long sum64(const Vector *vector)
+{
+    if (isEmpty(vector))
+        return 0;
+    return __DISPATCH__(__sum64, vector->array, vector->length);
 }
 
 /**
  * @brief Calculates the product of all elements in the vector.
  * @param vector A pointer to the vector.
  * @return The product of the elements, or 1 if the vector is empty.
+ * @note The product wraps around on overflow.
  */
 int prod(const Vector *vector)
 {
     if (isEmpty(vector))
         return 1;
-    int product = 1;
-    for (int i = 0; i < vector->length; i++)
-        product *= vector->array[i];
-    return product;
+    return __DISPATCH__(__prod, vector->array, vector->length);
 }
 
 /**
@@ -982,11 +2585,7 @@ int count(const Vector *vector, const int value)
 {
     if (isEmpty(vector))
         return 0;
-    int freq = 0;
-    for (int i = 0; i < vector->length; i++)
-        if (vector->array[i] == value)
-            freq++;
-    return freq;
+    return __DISPATCH__(__count, vector->array, vector->length, value);
 }
 
 /**
@@ -999,10 +2598,575 @@ bool contains(const Vector *vector, const int value)
 {
     if (isEmpty(vector))
         return false;
-    for (int i = 0; i < vector->length; i++)
-        if (vector->array[i] == value)
-            return true;
-    return false;
+    return __DISPATCH__(__contains, vector->array, vector->length, value);
+}
+
+/**
+ * @brief Number of elements a Pipeline pushes through all of its stages at a time.
+ * @note 2048 ints are 8 KiB, so a chunk stays in the L1 cache while every stage runs over it.
+ * @note Define this before including the header to override the default.
+ */
+#ifndef PIPELINE_CHUNK
+#define PIPELINE_CHUNK 2048
+#endif
+
+/**
+ * @brief Maximum number of stages a Pipeline can record.
+ * @note Define this before including the header to override the default.
+ */
+#ifndef PIPELINE_MAX_STAGES
+#define PIPELINE_MAX_STAGES 16
+#endif
+
+/**
+ * @brief Minimum source length for which a Pipeline actually spawns threads.
+ * @note Define this before including the header to override the default.
+ */
+#ifndef PIPELINE_PARALLEL_CUTOFF
+#define PIPELINE_PARALLEL_CUTOFF 65536
+#endif
+
+/**
+ * @brief One recorded Pipeline stage; exactly one of the three callbacks is set.
+ * @note This is a private helper type.
+ */
+typedef struct
+{
+    int (*map)(int);
+    bool (*filter)(int);
+    int (*kernel)(int *, int);
+} __Stage__;
+
+/**
+ * @brief A lazy chain of map and filter stages over a source vector.
+ * @details Stages are only recorded by pipeMap, pipeFilter and pipeKernel. A terminal
+ * operation (pipeCollect, pipeSum, pipeCount) then streams the source through every stage
+ * one PIPELINE_CHUNK at a time, so the whole chain reads the source from memory once.
+ */
+typedef struct
+{
+    const Vector *source;
+    __Stage__ stages[PIPELINE_MAX_STAGES];
+    int length;
+    int threads;
+} Pipeline;
+
+/**
+ * @brief Defines a chunk kernel that replaces every element `x` with `expression`.
+ * @param name The name of the generated function, to be passed to pipeKernel.
+ * @param x The name the expression uses for the current element.
+ * @param expression An int expression of `x`, compiled inline into the loop.
+ */
+#define PIPE_MAP_KERNEL(name, x, expression) \
+    int name(int *chunk, int length)         \
+    {                                        \
+        for (int i = 0; i < length; i++)     \
+        {                                    \
+            int x = chunk[i];                \
+            chunk[i] = (expression);         \
+        }                                    \
+        return length;                       \
+    }
+
+/**
+ * @brief Defines a chunk kernel that keeps only the elements `x` for which `predicate` holds.
+ * @param name The name of the generated function, to be passed to pipeKernel.
+ * @param x The name the predicate uses for the current element.
+ * @param predicate A boolean expression of `x`, compiled inline into the loop.
+ * @note The generated loop compacts without branching on the predicate.
+ */
+#define PIPE_FILTER_KERNEL(name, x, predicate) \
+    int name(int *chunk, int length)           \
+    {                                          \
+        int kept = 0;                          \
+        for (int i = 0; i < length; i++)       \
+        {                                      \
+            int x = chunk[i];                  \
+            chunk[kept] = x;                   \
+            kept += (predicate) ? 1 : 0;       \
+        }                                      \
+        return kept;                           \
+    }
+
+/**
+ * @brief Starts an empty pipeline over a source vector.
+ * @param source A pointer to the vector to read. It is never modified.
+ * @return A Pipeline with no stages that runs on a single thread.
+ */
+Pipeline pipeline(const Vector *source)
+{
+    Pipeline result;
+    result.source = source;
+    result.length = 0;
+    result.threads = 1;
+    return result;
+}
+
+/**
+ * @brief Appends a stage to a pipeline.
+ * @param pipe A pointer to the pipeline.
+ * @param stage The stage to append.
+ * @note This is a private helper function.
+ * @note Exits the program if the pipeline already holds PIPELINE_MAX_STAGES stages.
+ */
+void __pipeStage__(Pipeline *pipe, const __Stage__ stage)
+{
+    if (pipe->length == PIPELINE_MAX_STAGES)
+    {
+        perror("Too many stages in Pipeline");
+        exit(EXIT_FAILURE);
+    }
+    pipe->stages[pipe->length++] = stage;
+}
+
+/**
+ * @brief Records a stage that applies a function to each element.
+ * @param pipe A pointer to the pipeline.
+ * @param func A function pointer that takes an integer and returns an integer.
+ */
+void pipeMap(Pipeline *pipe, int (*func)(int))
+{
+    if (pipe == NULL || func == NULL)
+        return;
+    __Stage__ stage = {func, NULL, NULL};
+    __pipeStage__(pipe, stage);
+}
+
+/**
+ * @brief Records a stage that keeps only the elements for which a function returns true.
+ * @param pipe A pointer to the pipeline.
+ * @param func A function pointer that takes an integer and returns a boolean.
+ */
+void pipeFilter(Pipeline *pipe, bool (*func)(int))
+{
+    if (pipe == NULL || func == NULL)
+        return;
+    __Stage__ stage = {NULL, func, NULL};
+    __pipeStage__(pipe, stage);
+}
+
+/**
+ * @brief Records a stage that transforms a whole chunk at once.
+ * @param pipe A pointer to the pipeline.
+ * @param kernel A function that rewrites `chunk[0..length)` in place and returns the number of
+ * elements it kept at the front of the chunk.
+ * @note The kernel is called once per chunk rather than once per element, so its loop body can
+ * be inlined and vectorized. PIPE_MAP_KERNEL and PIPE_FILTER_KERNEL generate such kernels.
+ */
+void pipeKernel(Pipeline *pipe, int (*kernel)(int *, int))
+{
+    if (pipe == NULL || kernel == NULL)
+        return;
+    __Stage__ stage = {NULL, NULL, kernel};
+    __pipeStage__(pipe, stage);
+}
+
+#ifdef VECTOR_THREADS
+
+/**
+ * @brief Sets how many threads the terminal operations of a pipeline use.
+ * @param pipe A pointer to the pipeline.
+ * @param threads The number of threads, or <= 0 to use every online processor.
+ * @note Every stage must then be safe to call concurrently. Sources shorter than
+ * PIPELINE_PARALLEL_CUTOFF are always processed on the calling thread.
+ */
+void pipeThreads(Pipeline *pipe, int threads)
+{
+    if (pipe == NULL)
+        return;
+    pipe->threads = threads <= 0 ? __processorCount__() : threads;
+}
+
+#endif // VECTOR_THREADS
+
+/**
+ * @brief Runs every stage of a pipeline over one chunk in place.
+ * @param pipe A pointer to the pipeline.
+ * @param chunk The elements to transform.
+ * @param length The number of elements in the chunk.
+ * @return The number of elements that survived, compacted at the front of the chunk.
+ * @note This is a private helper function.
+ */
+int __pipeChunk__(const Pipeline *pipe, int *chunk, int length)
+{
+    for (int s = 0; s < pipe->length && length > 0; s++)
+    {
+        const __Stage__ *stage = &pipe->stages[s];
+        if (stage->kernel != NULL)
+            length = stage->kernel(chunk, length);
+        else if (stage->map != NULL)
+            for (int i = 0; i < length; i++)
+                chunk[i] = stage->map(chunk[i]);
+        else
+        {
+            int kept = 0;
+            for (int i = 0; i < length; i++)
+                if (stage->filter(chunk[i]))
+                    chunk[kept++] = chunk[i];
+            length = kept;
+        }
+    }
+    return length;
+}
+
+/**
+ * @brief Shared state of one terminal pipeline operation.
+ * @details Each worker streams a contiguous range of the source through the stages. When
+ * `output` is set, a worker's results are written at its range's offset in `output`;
+ * otherwise they are only counted and summed.
+ * @note This is a private helper type.
+ */
+typedef struct
+{
+    const Pipeline *pipe;
+    int threads;
+    int *output;
+    int *kept;
+    long long *sums;
+} __PipelineJob__;
+
+/**
+ * @brief Worker body of a terminal pipeline operation.
+ * @param context A pointer to the shared __PipelineJob__.
+ * @param thread The index of this worker.
+ * @note This is a private helper function.
+ */
+void __pipelineWorker__(void *context, int thread)
+{
+    __PipelineJob__ *job = (__PipelineJob__ *)context;
+    const Vector *source = job->pipe->source;
+    int start = (int)((long long)source->length * thread / job->threads);
+    int end = (int)((long long)source->length * (thread + 1) / job->threads);
+    int buffer[PIPELINE_CHUNK];
+    int kept = 0;
+    long long total = 0;
+
+    for (int i = start; i < end; i += PIPELINE_CHUNK)
+    {
+        int length = end - i < PIPELINE_CHUNK ? end - i : PIPELINE_CHUNK;
+        int *chunk = job->output != NULL ? job->output + start + kept : buffer;
+        memcpy(chunk, source->array + i, length * sizeof(int));
+        length = __pipeChunk__(job->pipe, chunk, length);
+        for (int j = 0; j < length; j++)
+            total += chunk[j];
+        kept += length;
+    }
+    job->kept[thread] = kept;
+    job->sums[thread] = total;
+}
+
+/**
+ * @brief Runs a pipeline on its configured number of threads.
+ * @param pipe A pointer to the pipeline.
+ * @param output Where to write the surviving elements, or NULL to only count and sum them.
+ * @param sum Receives the sum of the surviving elements.
+ * @return The number of surviving elements, compacted at the front of `output` when given.
+ * @note This is a private helper function.
+ * @note Exits the program if memory allocation or thread creation fails.
+ */
+int __pipeRun__(const Pipeline *pipe, int *output, long long *sum)
+{
+    int threads = pipe->source->length < PIPELINE_PARALLEL_CUTOFF ? 1 : pipe->threads;
+    __PipelineJob__ job;
+    job.pipe = pipe;
+    job.threads = threads;
+    job.output = output;
+    job.kept = (int *)malloc(threads * sizeof(int));
+    job.sums = (long long *)malloc(threads * sizeof(long long));
+    if (job.kept == NULL || job.sums == NULL)
+    {
+        perror("Failed to allocate memory for Workers in Pipeline");
+        exit(EXIT_FAILURE);
+    }
+
+#ifdef VECTOR_THREADS
+    if (threads > 1)
+        __parallelRun__(threads, __pipelineWorker__, &job);
+    else
+#endif
+        __pipelineWorker__(&job, 0);
+
+    int length = 0;
+    *sum = 0;
+    for (int t = 0; t < threads; t++)
+    {
+        int start = (int)((long long)pipe->source->length * t / threads);
+        if (output != NULL && start != length)
+            memmove(output + length, output + start, job.kept[t] * sizeof(int));
+        length += job.kept[t];
+        *sum += job.sums[t];
+    }
+    free(job.kept);
+    free(job.sums);
+    return length;
+}
+
+/**
+ * @brief Runs a pipeline and collects the surviving elements into a new vector.
+ * @param pipe A pointer to the pipeline.
+ * @return A new Vector holding the results in source order.
+ * @note Returns a new vector with capacity 1 if the pipeline or its source is NULL.
+ * @note Exits the program if memory allocation or thread creation fails.
+ */
+Vector pipeCollect(const Pipeline *pipe)
+{
+    if (pipe == NULL || isEmpty(pipe->source))
+        return init(1);
+    Vector result = init(pipe->source->length);
+    long long sum;
+    result.length = __pipeRun__(pipe, result.array, &sum);
+    return result;
+}
+
+/**
+ * @brief Runs a pipeline and sums the surviving elements.
+ * @param pipe A pointer to the pipeline.
+ * @return The sum in a 64-bit accumulator, or 0 if the pipeline or its source is empty.
+ * @note Exits the program if memory allocation or thread creation fails.
+ */
+long long pipeSum(const Pipeline *pipe)
+{
+    if (pipe == NULL || isEmpty(pipe->source))
+        return 0;
+    long long sum;
+    __pipeRun__(pipe, NULL, &sum);
+    return sum;
+}
+
+/**
+ * @brief Runs a pipeline and counts the surviving elements.
+ * @param pipe A pointer to the pipeline.
+ * @return The number of elements that pass every filter, or 0 if the source is empty.
+ * @note Exits the program if memory allocation or thread creation fails.
+ */
+int pipeCount(const Pipeline *pipe)
+{
+    if (pipe == NULL || isEmpty(pipe->source))
+        return 0;
+    long long sum;
+    return __pipeRun__(pipe, NULL, &sum);
+}
+
+#ifdef VECTOR_MMAP
+
+/**
+ * @brief Identifies a file written by openMapped ("VEC1" in little-endian byte order).
+ */
+#define MAPPED_VECTOR_MAGIC 0x31434556u
+
+/**
+ * @brief Size in bytes of the header that precedes the elements in a mapped vector file.
+ * @note A full cache line, so the elements start 64-byte aligned within the mapping.
+ */
+#define MAPPED_VECTOR_HEADER 64
+
+/**
+ * @brief On-disk header of a mapped vector file.
+ * @note This is a private helper type. It occupies the first MAPPED_VECTOR_HEADER bytes.
+ */
+typedef struct
+{
+    unsigned int magic;
+    int length;
+    int capacity;
+} __MappedHeader__;
+
+/**
+ * @brief A vector whose elements live in a memory-mapped file.
+ * @details `vector` is an ordinary Vector whose array points into the mapping, so every
+ * function that works in place (get, set, the searches and sorts, map, filter, eraseRange, ...)
+ * can be called on `&mapped.vector` and writes straight through to the file. Functions that
+ * reallocate the array (append, insert, reserve, shrinkToFit, destroy, ...) must not be used on
+ * it; use appendMapped and reserveMapped instead.
+ */
+typedef struct
+{
+    Vector vector;
+    int descriptor;
+    void *mapping;
+    size_t size;
+} MappedVector;
+
+/**
+ * @brief Maps the first `size` bytes of the file into memory.
+ * @param mapped A pointer to the mapped vector whose file is mapped.
+ * @param size The number of bytes to map.
+ * @note This is a private helper function. Points `vector.array` into the new mapping.
+ * @note Exits the program if the mapping fails.
+ */
+void __mapFile__(MappedVector *mapped, const size_t size)
+{
+    void *mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, mapped->descriptor, 0);
+    if (mapping == MAP_FAILED)
+    {
+        perror("Failed to map MappedVector");
+        exit(EXIT_FAILURE);
+    }
+    mapped->mapping = mapping;
+    mapped->size = size;
+    mapped->vector.array = (int *)((char *)mapping + MAPPED_VECTOR_HEADER);
+}
+
+/**
+ * @brief Extends the file so it can hold `capacity` elements.
+ * @param descriptor The file descriptor.
+ * @param capacity The number of elements the file should hold.
+ * @note This is a private helper function. Writes the last byte, so the new space reads as zeros.
+ * @note Exits the program if the file cannot be extended.
+ */
+void __growFile__(const int descriptor, const int capacity)
+{
+    off_t size = MAPPED_VECTOR_HEADER + (off_t)capacity * sizeof(int);
+    if (lseek(descriptor, size - 1, SEEK_SET) < 0 || write(descriptor, "", 1) != 1)
+    {
+        perror("Failed to grow MappedVector file");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Opens a file-backed vector, creating the file if it does not exist.
+ * @param path The path of the file.
+ * @param capacity The initial capacity if the file is created. Ignored for an existing file.
+ * @return A MappedVector whose contents are the file's elements.
+ * @note Reopening an existing file only maps it: no element is read or copied until touched.
+ * @note Exits the program if the file cannot be opened, is not a mapped vector file, or cannot be
+ * mapped, or if capacity is invalid.
+ */
+MappedVector openMapped(const char *path, const int capacity)
+{
+    if (path == NULL || capacity <= 0)
+    {
+        perror("Invalid input for openMapped");
+        exit(EXIT_FAILURE);
+    }
+    MappedVector mapped;
+    mapped.descriptor = open(path, O_RDWR | O_CREAT, 0644);
+    struct stat info;
+    if (mapped.descriptor < 0 || fstat(mapped.descriptor, &info) != 0)
+    {
+        perror("Failed to open MappedVector file");
+        exit(EXIT_FAILURE);
+    }
+
+    if (info.st_size == 0)
+    {
+        __growFile__(mapped.descriptor, capacity);
+        __mapFile__(&mapped, MAPPED_VECTOR_HEADER + (size_t)capacity * sizeof(int));
+        __MappedHeader__ *header = (__MappedHeader__ *)mapped.mapping;
+        header->magic = MAPPED_VECTOR_MAGIC;
+        header->length = 0;
+        header->capacity = capacity;
+    }
+    else
+    {
+        __MappedHeader__ header;
+        if (info.st_size < MAPPED_VECTOR_HEADER || lseek(mapped.descriptor, 0, SEEK_SET) != 0 ||
+            read(mapped.descriptor, &header, sizeof(header)) != sizeof(header))
+        {
+            perror("Failed to read MappedVector header");
+            exit(EXIT_FAILURE);
+        }
+        if (header.magic != MAPPED_VECTOR_MAGIC || header.capacity < 0 || header.length < 0 || header.length > header.capacity ||
+            info.st_size < MAPPED_VECTOR_HEADER + (off_t)header.capacity * (off_t)sizeof(int))
+        {
+            perror("Invalid MappedVector file");
+            exit(EXIT_FAILURE);
+        }
+        __mapFile__(&mapped, MAPPED_VECTOR_HEADER + (size_t)header.capacity * sizeof(int));
+    }
+
+    __MappedHeader__ *header = (__MappedHeader__ *)mapped.mapping;
+    mapped.vector.length = header->length;
+    mapped.vector.capacity = header->capacity;
+    return mapped;
+}
+
+/**
+ * @brief Grows a mapped vector's file so it holds at least `capacity` elements.
+ * @param mapped A pointer to the mapped vector.
+ * @param capacity The minimum capacity.
+ * @note Extends the file and remaps it, so pointers into the old mapping become invalid.
+ * @note Exits the program if the file cannot be extended or remapped.
+ */
+void reserveMapped(MappedVector *mapped, const int capacity)
+{
+    if (mapped == NULL || mapped->mapping == NULL || capacity <= mapped->vector.capacity)
+        return;
+    __MappedHeader__ *header = (__MappedHeader__ *)mapped->mapping;
+    header->length = mapped->vector.length;
+    header->capacity = capacity;
+    __growFile__(mapped->descriptor, capacity);
+    munmap(mapped->mapping, mapped->size);
+    __mapFile__(mapped, MAPPED_VECTOR_HEADER + (size_t)capacity * sizeof(int));
+    mapped->vector.capacity = capacity;
+}
+
+/**
+ * @brief Appends a value to a mapped vector, growing its file when it is full.
+ * @param mapped A pointer to the mapped vector.
+ * @param value The value to append.
+ * @note The file doubles in size whenever it grows, so appends cost amortized O(1). Growth is
+ * computed in 64 bits and capped at INT_MAX elements.
+ * @note Exits the program if the file cannot be extended or remapped, or already holds INT_MAX elements.
+ */
+void appendMapped(MappedVector *mapped, const int value)
+{
+    if (mapped == NULL || mapped->mapping == NULL)
+        return;
+    if (__isFull__(&mapped->vector))
+    {
+        int64_t capacity = mapped->vector.capacity == 0 ? 1 : (int64_t)mapped->vector.capacity * 2;
+        if (mapped->vector.capacity == INT_MAX)
+        {
+            perror("Failed to expand MappedVector: capacity limit reached");
+            exit(EXIT_FAILURE);
+        }
+        reserveMapped(mapped, capacity > INT_MAX ? INT_MAX : (int)capacity);
+    }
+    mapped->vector.array[mapped->vector.length++] = value;
 }
 
-#endif // VECTOR_H
\ No newline at end of file
+/**
+ * @brief Writes a mapped vector's length and elements to its file and waits for the disk.
+ * @param mapped A pointer to the mapped vector.
+ * @note Call this after modifying the vector to make the changes durable. Without it, the
+ * operating system still writes the pages back eventually, but the header may hold a stale length.
+ * @note Exits the program if the data cannot be written back.
+ */
+void syncMapped(MappedVector *mapped)
+{
+    if (mapped == NULL || mapped->mapping == NULL)
+        return;
+    __MappedHeader__ *header = (__MappedHeader__ *)mapped->mapping;
+    header->length = mapped->vector.length;
+    if (msync(mapped->mapping, mapped->size, MS_SYNC) != 0)
+    {
+        perror("Failed to sync MappedVector");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Syncs a mapped vector, unmaps it and closes its file.
+ * @param mapped A pointer to the mapped vector to close.
+ * @note The mapped vector's members are set to NULL or 0 afterwards.
+ */
+void closeMapped(MappedVector *mapped)
+{
+    if (mapped == NULL || mapped->mapping == NULL)
+        return;
+    syncMapped(mapped);
+    munmap(mapped->mapping, mapped->size);
+    close(mapped->descriptor);
+    mapped->mapping = NULL;
+    mapped->size = 0;
+    mapped->descriptor = -1;
+    mapped->vector.array = NULL;
+    mapped->vector.length = 0;
+    mapped->vector.capacity = 0;
+}
+
+#endif // VECTOR_MMAP
+
+#endif // VECTOR_H
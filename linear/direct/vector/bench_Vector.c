@@ -0,0 +1,758 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#define VECTOR_THREADS
+#define VECTOR_MMAP
+#include "adt_Vector.h"
+#include "adt_GenericVector.h"
+
+#define GREEN "\x1b[32m"
+#define RED "\x1b[31m"
+#define YELLOW "\x1b[33m"
+#define BLUE "\x1b[34m"
+#define RESET "\x1b[0m"
+
+// Function prototypes for benchmark groups
+void benchMergeSort(const int maxLength);
+void benchQuickSort(const int maxLength);
+void benchParallelSort(const int maxLength);
+void benchRadixSort(const int maxLength);
+void benchReductions(const int maxLength);
+void benchSearch(const int maxLength);
+void benchGeneric(const int maxLength);
+void benchPipeline(const int maxLength);
+void benchRange(const int maxLength);
+void benchMapped(const int maxLength);
+void benchSelect(const int maxLength);
+
+// Helper functions for benchmarking
+double wallTime()
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+bool isSorted(const Vector *v)
+{
+    for (int i = 1; i < v->length; i++)
+        if (v->array[i - 1] > v->array[i])
+            return false;
+    return true;
+}
+
+void printResult(const char *name, const int length, const double seconds, const bool correct)
+{
+    printf("  %-24s n=%-10d %10.4f s %10.1f Melem/s  %s\n", name, length, seconds,
+           length / seconds / 1e6, correct ? GREEN "ok" RESET : RED "WRONG" RESET);
+}
+
+// ========================================
+// Baselines: the original implementations
+// ========================================
+void baselineMerge(Vector *vector, const Vector *left, const Vector *right)
+{
+    int l = 0, r = 0, i = 0;
+    while (l < left->length && r < right->length)
+    {
+        if (left->array[l] <= right->array[r])
+            vector->array[i++] = left->array[l++];
+        else
+            vector->array[i++] = right->array[r++];
+    }
+    while (l < left->length)
+        vector->array[i++] = left->array[l++];
+    while (r < right->length)
+        vector->array[i++] = right->array[r++];
+}
+
+void baselineMergeSort(Vector *vector)
+{
+    if (vector == NULL || vector->length <= 1)
+        return;
+    int mid = vector->length / 2;
+    Vector left = slice(vector, 0, mid);
+    Vector right = slice(vector, mid, vector->length);
+    baselineMergeSort(&left);
+    baselineMergeSort(&right);
+    baselineMerge(vector, &left, &right);
+    destroy(&left);
+    destroy(&right);
+}
+
+void baselinePartition(Vector *vector, const int start, const int end)
+{
+    if (end - start <= 0)
+        return;
+    int pivot = vector->array[end];
+    int i = start - 1;
+    for (int j = start; j <= end; j++)
+        if (vector->array[j] <= pivot)
+            __swap__(&vector->array[++i], &vector->array[j]);
+    baselinePartition(vector, start, i - 1);
+    baselinePartition(vector, i + 1, end);
+}
+
+void baselineQuickSort(Vector *vector)
+{
+    if (vector == NULL || vector->length <= 1)
+        return;
+    baselinePartition(vector, 0, vector->length - 1);
+}
+
+void baselineRadixSort(Vector *vector)
+{
+    if (vector == NULL || vector->length <= 1)
+        return;
+    int max = vector->array[0];
+    for (int i = 1; i < vector->length; i++)
+        if (vector->array[i] > max)
+            max = vector->array[i];
+    for (int place = 1; max / place > 0; place *= 10)
+    {
+        int counter[10] = {0};
+        for (int i = 0; i < vector->length; i++)
+            counter[(vector->array[i] / place) % 10]++;
+        for (int i = 1; i < 10; i++)
+            counter[i] += counter[i - 1];
+        int *result = (int *)malloc(vector->length * sizeof(int));
+        for (int i = vector->length - 1; i >= 0; i--)
+        {
+            int digit = (vector->array[i] / place) % 10;
+            result[--counter[digit]] = vector->array[i];
+        }
+        for (int i = 0; i < vector->length; i++)
+            vector->array[i] = result[i];
+        free(result);
+        if (max / place < 10) // stop before place overflows on keys near INT_MAX
+            break;
+    }
+}
+
+int baselineSum(const Vector *vector)
+{
+    int total = 0;
+    for (int i = 0; i < vector->length; i++)
+        total += vector->array[i];
+    return total;
+}
+
+int baselineMax(const Vector *vector)
+{
+    int maximum = vector->array[0];
+    for (int i = 1; i < vector->length; i++)
+        if (maximum < vector->array[i])
+            maximum = vector->array[i];
+    return maximum;
+}
+
+int baselineMin(const Vector *vector)
+{
+    int minimum = vector->array[0];
+    for (int i = 1; i < vector->length; i++)
+        if (minimum > vector->array[i])
+            minimum = vector->array[i];
+    return minimum;
+}
+
+int baselineProd(const Vector *vector)
+{
+    unsigned int product = 1;
+    for (int i = 0; i < vector->length; i++)
+        product *= (unsigned int)vector->array[i];
+    return (int)product;
+}
+
+int baselineCount(const Vector *vector, const int value)
+{
+    int freq = 0;
+    for (int i = 0; i < vector->length; i++)
+        if (vector->array[i] == value)
+            freq++;
+    return freq;
+}
+
+bool baselineContains(const Vector *vector, const int value)
+{
+    for (int i = 0; i < vector->length; i++)
+        if (vector->array[i] == value)
+            return true;
+    return false;
+}
+
+// Typed vector instantiated for the generic benchmark
+DEFINE_VECTOR(LongVector, long long)
+
+int compareLongLong(const void *a, const void *b)
+{
+    long long x = *(const long long *)a, y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+// Stages for the pipeline benchmark
+int scaleStage(int x)
+{
+    return 3 * x + 1;
+}
+
+bool oddStage(int x)
+{
+    return x & 1;
+}
+
+PIPE_MAP_KERNEL(scaleKernel, x, 3 * x + 1)
+PIPE_FILTER_KERNEL(oddKernel, x, x & 1)
+
+// Main function to execute benchmarks
+// Usage: ./bench_Vector [benchmark|all] [maxLength]
+int main(int argc, char **argv)
+{
+    const char *which = argc > 1 ? argv[1] : "all";
+    int maxLength = argc > 2 ? atoi(argv[2]) : 10000000;
+    if (maxLength < 1000)
+        maxLength = 1000;
+
+    printf(BLUE "========================================\n" RESET);
+    printf(BLUE "       Running Vector ADT Benchmarks\n" RESET);
+    printf(BLUE "========================================\n\n" RESET);
+
+    if (!strcmp(which, "all") || !strcmp(which, "merge"))
+        benchMergeSort(maxLength);
+    if (!strcmp(which, "all") || !strcmp(which, "quick"))
+        benchQuickSort(maxLength);
+    if (!strcmp(which, "all") || !strcmp(which, "parallel"))
+        benchParallelSort(maxLength);
+    if (!strcmp(which, "all") || !strcmp(which, "radix"))
+        benchRadixSort(maxLength);
+    if (!strcmp(which, "all") || !strcmp(which, "reduce"))
+        benchReductions(maxLength);
+    if (!strcmp(which, "all") || !strcmp(which, "search"))
+        benchSearch(maxLength);
+    if (!strcmp(which, "all") || !strcmp(which, "generic"))
+        benchGeneric(maxLength);
+    if (!strcmp(which, "all") || !strcmp(which, "pipeline"))
+        benchPipeline(maxLength);
+    if (!strcmp(which, "all") || !strcmp(which, "range"))
+        benchRange(maxLength);
+    if (!strcmp(which, "all") || !strcmp(which, "mapped"))
+        benchMapped(maxLength);
+    if (!strcmp(which, "all") || !strcmp(which, "select"))
+        benchSelect(maxLength);
+
+    return 0;
+}
+
+// ========================================
+// Benchmark: Merge Sort
+// ========================================
+void benchMergeSort(const int maxLength)
+{
+    printf(YELLOW "--- mergeSort: slice-based baseline vs buffered bottom-up ---\n" RESET);
+    for (long long length = 1000; length <= maxLength; length *= 10)
+    {
+        Vector source = init((int)length);
+        random(&source, (int)length, 0, RAND_MAX);
+
+        Vector v = copy(&source);
+        double start = wallTime();
+        baselineMergeSort(&v);
+        printResult("baseline mergeSort", v.length, wallTime() - start, isSorted(&v));
+        destroy(&v);
+
+        v = copy(&source);
+        start = wallTime();
+        mergeSort(&v);
+        printResult("mergeSort", v.length, wallTime() - start, isSorted(&v));
+        destroy(&v);
+
+        v = copy(&source);
+        int *buffer = (int *)malloc(length * sizeof(int));
+        start = wallTime();
+        mergeSortBuffered(&v, buffer);
+        printResult("mergeSortBuffered", v.length, wallTime() - start, isSorted(&v));
+        free(buffer);
+        destroy(&v);
+
+        destroy(&source);
+        printf("----------------------------------------\n");
+    }
+}
+
+// ========================================
+// Benchmark: Quick Sort
+// ========================================
+void benchQuickSort(const int maxLength)
+{
+    printf(YELLOW "--- quickSort: last-element pivot baseline vs introsort ---\n" RESET);
+    for (long long length = 1000; length <= maxLength; length *= 10)
+    {
+        Vector random_v = init((int)length);
+        random(&random_v, (int)length, 0, RAND_MAX);
+        Vector ascending = init((int)length);
+        Vector few_unique = init((int)length);
+        random(&few_unique, (int)length, 0, 4);
+        for (int i = 0; i < length; i++)
+            append(&ascending, i);
+
+        Vector v = copy(&random_v);
+        double start = wallTime();
+        baselineQuickSort(&v);
+        printResult("baseline random", v.length, wallTime() - start, isSorted(&v));
+        destroy(&v);
+
+        // The baseline is quadratic and overflows the stack on the remaining inputs.
+        const Vector *inputs[] = {&random_v, &ascending, &few_unique};
+        const char *names[] = {"quickSort random", "quickSort ascending", "quickSort 4 unique keys"};
+        for (int k = 0; k < 3; k++)
+        {
+            v = copy(inputs[k]);
+            start = wallTime();
+            quickSort(&v);
+            printResult(names[k], v.length, wallTime() - start, isSorted(&v));
+            destroy(&v);
+        }
+
+        destroy(&random_v);
+        destroy(&ascending);
+        destroy(&few_unique);
+        printf("----------------------------------------\n");
+    }
+}
+
+// ========================================
+// Benchmark: Parallel Sort Scaling
+// ========================================
+void benchParallelSort(const int maxLength)
+{
+    int processors = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    printf(YELLOW "--- parallelSort: throughput per thread count (%d processors online) ---\n" RESET, processors);
+    const char *inputs[2] = {"random", "duplicate-heavy"};
+    for (int input = 0; input < 2; input++)
+    {
+        Vector source = init(maxLength);
+        if (input == 0)
+            random(&source, maxLength, 0, RAND_MAX);
+        else
+            for (int i = 0; i < maxLength; i++)
+                append(&source, i % 4 == 0 ? rand() % 16 : 7); // one dominant key and a small key range
+        printf("  input: %s\n", inputs[input]);
+
+        Vector v = copy(&source);
+        double start = wallTime();
+        quickSort(&v);
+        double serial = wallTime() - start;
+        printResult("quickSort", v.length, serial, isSorted(&v));
+        destroy(&v);
+
+        for (int threads = 1; threads <= processors; threads *= 2)
+        {
+            char name[32];
+            snprintf(name, sizeof(name), "parallelSort x%d", threads);
+            v = copy(&source);
+            start = wallTime();
+            parallelSort(&v, threads);
+            double elapsed = wallTime() - start;
+            printResult(name, v.length, elapsed, isSorted(&v));
+            printf("  %-24s speedup over quickSort: %.2fx\n", "", serial / elapsed);
+            destroy(&v);
+        }
+        destroy(&source);
+    }
+    printf("----------------------------------------\n");
+}
+
+// ========================================
+// Benchmark: Radix Sort
+// ========================================
+void benchRadixSort(const int maxLength)
+{
+    printf(YELLOW "--- radixSort: decimal baseline vs binary LSD ---\n" RESET);
+    for (long long length = 1000; length <= maxLength; length *= 10)
+    {
+        Vector source = init((int)length);
+        random(&source, (int)length, 0, RAND_MAX);
+
+        Vector v = copy(&source);
+        double start = wallTime();
+        baselineRadixSort(&v);
+        printResult("baseline radixSort", v.length, wallTime() - start, isSorted(&v));
+        destroy(&v);
+
+        v = copy(&source);
+        start = wallTime();
+        radixSort(&v);
+        printResult("radixSort", v.length, wallTime() - start, isSorted(&v));
+        destroy(&v);
+
+        // The baseline cannot sort negative keys at all.
+        random(&source, (int)length, -RAND_MAX / 2, RAND_MAX / 2);
+        v = copy(&source);
+        start = wallTime();
+        radixSort(&v);
+        printResult("radixSort signed", v.length, wallTime() - start, isSorted(&v));
+        destroy(&v);
+
+        destroy(&source);
+        printf("----------------------------------------\n");
+    }
+}
+
+// ========================================
+// Benchmark: SIMD Reductions
+// ========================================
+void printBandwidth(const char *name, const long long bytes, const double seconds, const bool correct)
+{
+    printf("  %-24s %10.4f s %8.2f GB/s  %s\n", name, seconds, bytes / seconds / 1e9,
+           correct ? GREEN "ok" RESET : RED "WRONG" RESET);
+}
+
+void benchReductions(const int maxLength)
+{
+    const char *levels[] = {"scalar", "SSE2", "AVX2"};
+    printf(YELLOW "--- reductions: scalar loops vs %s kernels, n=%d ---\n" RESET, levels[__simdLevel__()], maxLength);
+    Vector v = init(maxLength);
+    random(&v, maxLength, -1000, 1000);
+    const int repeats = 20;
+    const long long bytes = (long long)repeats * maxLength * sizeof(int);
+    const int missing = 5000; // outside the value range, so contains() scans everything
+
+    double start = wallTime();
+    int expected = 0, actual = 0;
+    for (int r = 0; r < repeats; r++)
+        expected += baselineSum(&v);
+    printBandwidth("baseline sum", bytes, wallTime() - start, true);
+    start = wallTime();
+    for (int r = 0; r < repeats; r++)
+        actual += sum(&v);
+    printBandwidth("sum", bytes, wallTime() - start, actual == expected);
+    start = wallTime();
+    long long wide = 0;
+    for (int r = 0; r < repeats; r++)
+        wide += sum64(&v);
+    printBandwidth("sum64", bytes, wallTime() - start, (int)(wide / repeats) == expected / repeats);
+
+    start = wallTime();
+    expected = actual = 0;
+    for (int r = 0; r < repeats; r++)
+        expected += baselineProd(&v);
+    printBandwidth("baseline prod", bytes, wallTime() - start, true);
+    start = wallTime();
+    for (int r = 0; r < repeats; r++)
+        actual += prod(&v);
+    printBandwidth("prod", bytes, wallTime() - start, actual == expected);
+
+    start = wallTime();
+    expected = actual = 0;
+    for (int r = 0; r < repeats; r++)
+        expected += baselineMax(&v) + baselineMin(&v);
+    printBandwidth("baseline max + min", 2 * bytes, wallTime() - start, true);
+    start = wallTime();
+    for (int r = 0; r < repeats; r++)
+        actual += max(&v) + min(&v);
+    printBandwidth("max + min", 2 * bytes, wallTime() - start, actual == expected);
+
+    start = wallTime();
+    expected = actual = 0;
+    for (int r = 0; r < repeats; r++)
+        expected += baselineCount(&v, r);
+    printBandwidth("baseline count", bytes, wallTime() - start, true);
+    start = wallTime();
+    for (int r = 0; r < repeats; r++)
+        actual += count(&v, r);
+    printBandwidth("count", bytes, wallTime() - start, actual == expected);
+
+    start = wallTime();
+    expected = actual = 0;
+    for (int r = 0; r < repeats; r++)
+        expected += baselineContains(&v, missing);
+    printBandwidth("baseline contains", bytes, wallTime() - start, true);
+    start = wallTime();
+    for (int r = 0; r < repeats; r++)
+        actual += contains(&v, missing);
+    printBandwidth("contains", bytes, wallTime() - start, actual == expected);
+
+    destroy(&v);
+    printf("----------------------------------------\n");
+}
+
+// ========================================
+// Benchmark: Search Index
+// ========================================
+void benchSearch(const int maxLength)
+{
+    const int lookups = 4000000;
+    printf(YELLOW "--- search: %d lookups on a sorted vector of n=%d ---\n" RESET, lookups, maxLength);
+    Vector v = init(maxLength);
+    for (int i = 0; i < maxLength; i++)
+        append(&v, 2 * i);
+    int *queries = (int *)malloc(lookups * sizeof(int));
+    int *results = (int *)malloc(lookups * sizeof(int));
+    for (int i = 0; i < lookups; i++)
+        queries[i] = (int)(((long long)rand() * RAND_MAX + rand()) % (2LL * maxLength));
+
+    long long expected = 0, actual = 0;
+    double start = wallTime();
+    for (int i = 0; i < lookups; i++)
+        expected += binarySearch(&v, queries[i], 0);
+    printResult("binarySearch", lookups, wallTime() - start, true);
+
+    start = wallTime();
+    for (int i = 0; i < lookups; i++)
+        actual += branchlessSearch(&v, queries[i], 0);
+    printResult("branchlessSearch", lookups, wallTime() - start, actual == expected);
+
+    start = wallTime();
+    SearchIndex index = buildIndex(&v);
+    printf("  %-24s %10.4f s\n", "buildIndex", wallTime() - start);
+
+    actual = 0;
+    start = wallTime();
+    for (int i = 0; i < lookups; i++)
+        actual += indexSearch(&index, queries[i]);
+    printResult("indexSearch", lookups, wallTime() - start, actual == expected);
+
+    actual = 0;
+    start = wallTime();
+    indexSearchBatch(&index, queries, results, lookups);
+    double elapsed = wallTime() - start;
+    for (int i = 0; i < lookups; i++)
+        actual += results[i];
+    printResult("indexSearchBatch", lookups, elapsed, actual == expected);
+
+    destroyIndex(&index);
+    free(queries);
+    free(results);
+    destroy(&v);
+    printf("----------------------------------------\n");
+}
+
+// ========================================
+// Benchmark: Generic Vector
+// ========================================
+void benchGeneric(const int maxLength)
+{
+    printf(YELLOW "--- generic: LongVector_quickSort (inlined comparator) vs qsort ---\n" RESET);
+    for (long long length = 1000; length <= maxLength; length *= 10)
+    {
+        LongVector source = LongVector_init((int)length);
+        for (int i = 0; i < length; i++)
+            LongVector_append(&source, ((long long)rand() << 31) ^ rand());
+
+        LongVector v = LongVector_copy(&source);
+        double start = wallTime();
+        qsort(v.array, v.length, sizeof(long long), compareLongLong);
+        printResult("qsort", v.length, wallTime() - start, true);
+        LongVector expected = v;
+
+        v = LongVector_copy(&source);
+        start = wallTime();
+        LongVector_quickSort(&v);
+        printResult("LongVector_quickSort", v.length, wallTime() - start,
+                    !memcmp(v.array, expected.array, v.length * sizeof(long long)));
+        LongVector_destroy(&v);
+
+        v = LongVector_copy(&source);
+        start = wallTime();
+        LongVector_mergeSort(&v);
+        printResult("LongVector_mergeSort", v.length, wallTime() - start,
+                    !memcmp(v.array, expected.array, v.length * sizeof(long long)));
+        LongVector_destroy(&v);
+
+        LongVector_destroy(&expected);
+        LongVector_destroy(&source);
+    }
+    printf("----------------------------------------\n");
+}
+
+// ========================================
+// Benchmark: Pipeline
+// ========================================
+void benchPipeline(const int maxLength)
+{
+    printf(YELLOW "--- pipeline: map -> filter -> sum, eager vs fused ---\n" RESET);
+    Vector v = init(maxLength);
+    random(&v, maxLength, -1000000, 1000000);
+
+    double start = wallTime();
+    Vector eager = copy(&v);
+    map(&eager, scaleStage);
+    filter(&eager, oddStage);
+    long long expected = sum64(&eager);
+    printResult("eager map/filter/sum", v.length, wallTime() - start, true);
+    destroy(&eager);
+
+    Pipeline pipe = pipeline(&v);
+    pipeMap(&pipe, scaleStage);
+    pipeFilter(&pipe, oddStage);
+    start = wallTime();
+    long long actual = pipeSum(&pipe);
+    printResult("pipeline callbacks", v.length, wallTime() - start, actual == expected);
+
+    Pipeline kernels = pipeline(&v);
+    pipeKernel(&kernels, scaleKernel);
+    pipeKernel(&kernels, oddKernel);
+    start = wallTime();
+    actual = pipeSum(&kernels);
+    printResult("pipeline kernels", v.length, wallTime() - start, actual == expected);
+
+    pipeThreads(&kernels, 0);
+    start = wallTime();
+    actual = pipeSum(&kernels);
+    printResult("pipeline kernels (mt)", v.length, wallTime() - start, actual == expected);
+
+    destroy(&v);
+    printf("----------------------------------------\n");
+}
+
+// ========================================
+// Benchmark: Range Insert/Erase
+// ========================================
+bool areEqual(const Vector *a, const Vector *b)
+{
+    return a->length == b->length && !memcmp(a->array, b->array, a->length * sizeof(int));
+}
+
+void benchRange(const int maxLength)
+{
+    const int batch = 1000;
+    const int rounds = 100;
+    int length = maxLength / 100;
+    printf(YELLOW "--- range: %d batches of %d elements in the middle of n=%d ---\n" RESET, rounds, batch, length);
+    int *block = (int *)malloc(batch * sizeof(int));
+    for (int i = 0; i < batch; i++)
+        block[i] = i;
+    Vector source = init(length);
+    random(&source, length, 0, 1000);
+
+    Vector looped = copy(&source);
+    double start = wallTime();
+    for (int r = 0; r < rounds; r++)
+    {
+        int at = looped.length / 2;
+        for (int i = 0; i < batch; i++)
+            insert(&looped, block[i], at + i);
+    }
+    printResult("insert loop", rounds * batch, wallTime() - start, true);
+
+    Vector ranged = copy(&source);
+    start = wallTime();
+    for (int r = 0; r < rounds; r++)
+        insertRange(&ranged, block, batch, ranged.length / 2);
+    printResult("insertRange", rounds * batch, wallTime() - start, areEqual(&ranged, &looped));
+
+    start = wallTime();
+    for (int r = 0; r < rounds; r++)
+    {
+        int at = looped.length / 2;
+        for (int i = 0; i < batch; i++)
+            discard(&looped, at);
+    }
+    printResult("discard loop", rounds * batch, wallTime() - start, looped.length == length);
+
+    start = wallTime();
+    for (int r = 0; r < rounds; r++)
+        eraseRange(&ranged, ranged.length / 2, ranged.length / 2 + batch);
+    printResult("eraseRange", rounds * batch, wallTime() - start, areEqual(&ranged, &looped));
+
+    destroy(&source);
+    destroy(&looped);
+    destroy(&ranged);
+    free(block);
+    printf("----------------------------------------\n");
+}
+
+// ========================================
+// Benchmark: Mapped Vector
+// ========================================
+void benchMapped(const int maxLength)
+{
+    const char *csvPath = "bench_Vector.csv";
+    const char *mappedPath = "bench_Vector.mapped";
+    printf(YELLOW "--- mapped: reload n=%d from CSV vs reopen a mapped file ---\n" RESET, maxLength);
+    Vector v = init(maxLength);
+    random(&v, maxLength, 0, RAND_MAX);
+    long long expected = sum64(&v);
+
+    FILE *csv = fopen(csvPath, "w");
+    for (int i = 0; i < v.length; i++)
+        fprintf(csv, "%d\n", v.array[i]);
+    fclose(csv);
+
+    double start = wallTime();
+    Vector loaded = init(maxLength);
+    csv = fopen(csvPath, "r");
+    int value;
+    while (fscanf(csv, "%d", &value) == 1)
+        append(&loaded, value);
+    fclose(csv);
+    printResult("CSV reload", loaded.length, wallTime() - start, sum64(&loaded) == expected);
+    destroy(&loaded);
+
+    remove(mappedPath);
+    start = wallTime();
+    MappedVector mapped = openMapped(mappedPath, 1024);
+    for (int i = 0; i < v.length; i++)
+        appendMapped(&mapped, v.array[i]);
+    closeMapped(&mapped);
+    printResult("appendMapped + close", v.length, wallTime() - start, true);
+
+    start = wallTime();
+    mapped = openMapped(mappedPath, 1);
+    printf("  %-24s %10.6f s\n", "openMapped (reopen)", wallTime() - start);
+    start = wallTime();
+    long long actual = sum64(&mapped.vector);
+    printResult("sum64 on first touch", mapped.vector.length, wallTime() - start, actual == expected);
+    closeMapped(&mapped);
+
+    remove(csvPath);
+    remove(mappedPath);
+    destroy(&v);
+    printf("----------------------------------------\n");
+}
+
+// ========================================
+// Benchmark: Selection
+// ========================================
+void benchSelect(const int maxLength)
+{
+    const int k = 100;
+    printf(YELLOW "--- select: median, p99 and top-%d of n=%d vs a full quickSort ---\n" RESET, k, maxLength);
+    Vector source = init(maxLength);
+    random(&source, maxLength, 0, RAND_MAX);
+
+    Vector sorted = copy(&source);
+    double start = wallTime();
+    quickSort(&sorted);
+    printResult("quickSort (baseline)", sorted.length, wallTime() - start, isSorted(&sorted));
+
+    Vector v = copy(&source);
+    start = wallTime();
+    nthElement(&v, v.length / 2);
+    printResult("nthElement median", v.length, wallTime() - start, v.array[v.length / 2] == sorted.array[v.length / 2]);
+
+    int p99 = (int)(v.length * 0.99);
+    start = wallTime();
+    nthElement(&v, p99);
+    printResult("nthElement p99", v.length, wallTime() - start, v.array[p99] == sorted.array[p99]);
+    destroy(&v);
+
+    v = copy(&source);
+    start = wallTime();
+    partialSort(&v, k);
+    printResult("partialSort k=100", v.length, wallTime() - start, !memcmp(v.array, sorted.array, k * sizeof(int)));
+    destroy(&v);
+
+    start = wallTime();
+    Vector top = topK(&source, k);
+    bool correct = true;
+    for (int i = 0; i < k; i++)
+        correct = correct && top.array[i] == sorted.array[sorted.length - 1 - i];
+    printResult("topK k=100", source.length, wallTime() - start, correct);
+
+    destroy(&top);
+    destroy(&sorted);
+    destroy(&source);
+    printf("----------------------------------------\n");
+}
@@ -0,0 +1,453 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "adt_GenericVector.h"
+
+#define GREEN "\x1b[32m"
+#define RED "\x1b[31m"
+#define YELLOW "\x1b[33m"
+#define BLUE "\x1b[34m"
+#define RESET "\x1b[0m"
+
+typedef struct
+{
+    int key;
+    double weight;
+} Edge;
+
+#define EDGE_LESS(a, b) ((a).key < (b).key)
+#define EDGE_KEY(e) ((e).key)
+
+DEFINE_VECTOR(LongVector, long long)
+DEFINE_VECTOR(DoubleVector, double)
+DEFINE_VECTOR_CMP(EdgeVector, Edge, EDGE_LESS)
+DEFINE_VECTOR_INTERPOLATION(LongVector, long long, VECTOR_KEY)
+DEFINE_VECTOR_INTERPOLATION(EdgeVector, Edge, EDGE_KEY)
+DEFINE_VECTOR_ARITHMETIC(LongVector, long long)
+DEFINE_VECTOR_ARITHMETIC(DoubleVector, double)
+
+// Function prototypes for test groups
+void runAllTests();
+void testLongVector();
+void testDoubleVector();
+void testEdgeVector();
+
+// Helper functions for testing
+void printLongVectorForTest(const LongVector *v)
+{
+    printf("[ ");
+    for (int i = 0; i < v->length; i++)
+    {
+        printf("%lld ", v->array[i]);
+    }
+    printf("] : %d/%d\n", v->length, v->capacity);
+}
+
+bool isLongVectorSorted(const LongVector *v)
+{
+    for (int i = 1; i < v->length; i++)
+    {
+        if (v->array[i - 1] > v->array[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Helper functions for functional tests
+long long triple(long long x)
+{
+    return 3 * x;
+}
+
+bool isPositive(double x)
+{
+    return x > 0.0;
+}
+
+bool isOdd(long long x)
+{
+    return x % 2 != 0;
+}
+
+// Main function to execute tests
+int main()
+{
+    runAllTests();
+    return 0;
+}
+
+void runAllTests()
+{
+    printf(BLUE "========================================\n" RESET);
+    printf(BLUE "    Running Generic Vector Test Suite\n" RESET);
+    printf(BLUE "========================================\n\n" RESET);
+
+    testLongVector();
+    testDoubleVector();
+    testEdgeVector();
+
+    printf(BLUE "========================================\n" RESET);
+    printf(BLUE "        All Tests Finished\n" RESET);
+    printf(BLUE "========================================\n" RESET);
+}
+
+// ========================================
+// Test Group: long long elements
+// ========================================
+void testLongVector()
+{
+    printf(YELLOW "--- LongVector (long long) ---\n" RESET);
+
+    // Test `append()`, `insert()`, `discard()` and `pop()`
+    LongVector v = LongVector_init(2);
+    LongVector_append(&v, 5000000000LL);
+    LongVector_append(&v, -7);
+    LongVector_insert(&v, 42, 1);
+    LongVector_append(&v, 9);
+    long long discarded = LongVector_discard(&v, 0);
+    LongVector_pop(&v, 9);
+    printf("Test: LongVector_append(), _insert(), _discard() and _pop()\n");
+    printf("  Expected: [ 42 -7 ], discarded=5000000000\n");
+    printf("  Actual:   ");
+    printLongVectorForTest(&v);
+    printf("            discarded=%lld\n", discarded);
+    if (v.length == 2 && v.array[0] == 42 && v.array[1] == -7 && discarded == 5000000000LL)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    printf("----------------------------------------\n");
+
+    // Test the sorts against each other on values outside the int range
+    LongVector quick = LongVector_init(10000);
+    for (int i = 0; i < 10000; i++)
+    {
+        LongVector_append(&quick, ((long long)rand() - RAND_MAX / 2) * 1000003LL + i % 7);
+    }
+    LongVector merge = LongVector_copy(&quick);
+    LongVector heap = LongVector_copy(&quick);
+    LongVector_quickSort(&quick);
+    LongVector_mergeSort(&merge);
+    LongVector_heapSort(&heap);
+    bool agree = memcmp(quick.array, merge.array, quick.length * sizeof(long long)) == 0 &&
+                 memcmp(quick.array, heap.array, quick.length * sizeof(long long)) == 0;
+    printf("Test: LongVector_quickSort(), _mergeSort() and _heapSort() on 10000 elements\n");
+    printf("  Expected: sorted=true, agree=true\n");
+    printf("  Actual:   sorted=%s, agree=%s\n", isLongVectorSorted(&quick) ? "true" : "false", agree ? "true" : "false");
+    if (isLongVectorSorted(&quick) && agree)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    printf("----------------------------------------\n");
+
+    // Test `binarySearch()` on the sorted vector
+    long long target = quick.array[5000];
+    int found = LongVector_binarySearch(&quick, target, 0);
+    int missing = LongVector_binarySearch(&quick, quick.array[quick.length - 1] + 1, 0);
+    printf("Test: LongVector_binarySearch()\n");
+    printf("  Expected: first occurrence of %lld, missing=-1\n", target);
+    printf("  Actual:   index=%d, missing=%d\n", found, missing);
+    if (found >= 0 && found <= 5000 && quick.array[found] == target && (found == 0 || quick.array[found - 1] != target) && missing == -1)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    printf("----------------------------------------\n");
+
+    // Test `bubbleSort()` and `selectionSort()` against `quickSort()`, then the other searches
+    LongVector bubble = LongVector_slice(&merge, 0, 2000);
+    LongVector_shuffle(&bubble);
+    LongVector selection = LongVector_copy(&bubble);
+    LongVector reference = LongVector_copy(&bubble);
+    LongVector_bubbleSort(&bubble);
+    LongVector_selectionSort(&selection);
+    LongVector_quickSort(&reference);
+    bool simple_agree = memcmp(bubble.array, reference.array, bubble.length * sizeof(long long)) == 0 &&
+                        memcmp(selection.array, reference.array, selection.length * sizeof(long long)) == 0;
+    int ternary = LongVector_ternarySearch(&quick, target, 0);
+    int jump = LongVector_jumpSearch(&quick, target, 0);
+    int interpolation = LongVector_interpolationSearch(&quick, target, 0);
+    bool searches_found = ternary >= 0 && quick.array[ternary] == target && jump >= 0 && quick.array[jump] == target &&
+                          interpolation >= 0 && quick.array[interpolation] == target;
+    bool searches_missed = LongVector_ternarySearch(&quick, quick.array[quick.length - 1] + 1, 0) == -1 &&
+                           LongVector_jumpSearch(&quick, quick.array[quick.length - 1] + 1, 0) == -1 &&
+                           LongVector_interpolationSearch(&quick, quick.array[quick.length - 1] + 1, 0) == -1;
+    printf("Test: LongVector_bubbleSort(), _selectionSort(), _ternarySearch(), _jumpSearch() and _interpolationSearch()\n");
+    printf("  Expected: agree=true, found=true, missed=true\n");
+    printf("  Actual:   agree=%s, found=%s, missed=%s\n", simple_agree ? "true" : "false", searches_found ? "true" : "false", searches_missed ? "true" : "false");
+    if (simple_agree && searches_found && searches_missed)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    printf("----------------------------------------\n");
+
+    // Test `map()`, `max()` and `min()`
+    LongVector_map(&v, triple);
+    printf("Test: LongVector_map(), _max() and _min()\n");
+    printf("  Expected: max=126, min=-21\n");
+    printf("  Actual:   max=%lld, min=%lld\n", LongVector_max(&v), LongVector_min(&v));
+    if (LongVector_max(&v) == 126 && LongVector_min(&v) == -21)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    printf("----------------------------------------\n");
+
+    // Test `insertRange()`, `eraseRange()`, `eraseIf()`, `popAll()`, `replace()` and `shrinkToFit()`
+    LongVector ranged = LongVector_init(1);
+    long long block[] = {1, 2, 3, 4, 5, 6};
+    LongVector_insertRange(&ranged, block, 6, 0);
+    LongVector_insertRange(&ranged, ranged.array, 2, 3);
+    LongVector_eraseRange(&ranged, 0, 1);
+    int odd = LongVector_eraseIf(&ranged, isOdd);
+    LongVector_replace(&ranged, 8, 2, 1);
+    int twos = LongVector_popAll(&ranged, 2);
+    LongVector_shrinkToFit(&ranged);
+    printf("Test: LongVector_insertRange(), _eraseRange(), _eraseIf(), _popAll(), _replace() and _shrinkToFit()\n");
+    printf("  Expected: [ 8 4 6 ] : 3/3, odd=3, twos=1\n");
+    printf("  Actual:   ");
+    printLongVectorForTest(&ranged);
+    printf("            odd=%d, twos=%d\n", odd, twos);
+    if (ranged.length == 3 && ranged.capacity == 3 && ranged.array[0] == 8 && ranged.array[1] == 4 && ranged.array[2] == 6 && odd == 3 && twos == 1)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    printf("----------------------------------------\n");
+
+    // Test `nthElement()`, `partialSort()` and `topK()` against the sorted copy
+    LongVector selected = LongVector_copy(&merge);
+    LongVector_shuffle(&selected);
+    LongVector_nthElement(&selected, 5000);
+    bool nth_ok = selected.array[5000] == quick.array[5000];
+    for (int i = 0; i < selected.length && nth_ok; i++)
+    {
+        nth_ok = i < 5000 ? selected.array[i] <= selected.array[5000] : selected.array[i] >= selected.array[5000];
+    }
+    LongVector_shuffle(&selected);
+    LongVector_partialSort(&selected, 100);
+    bool partial_ok = memcmp(selected.array, quick.array, 100 * sizeof(long long)) == 0;
+    LongVector top = LongVector_topK(&merge, 50);
+    bool top_ok = top.length == 50;
+    for (int i = 0; i < top.length && top_ok; i++)
+    {
+        top_ok = top.array[i] == quick.array[quick.length - 1 - i];
+    }
+    printf("Test: LongVector_nthElement(), _partialSort() and _topK() on 10000 elements\n");
+    printf("  Expected: nth=true, partial=true, top=true\n");
+    printf("  Actual:   nth=%s, partial=%s, top=%s\n", nth_ok ? "true" : "false", partial_ok ? "true" : "false", top_ok ? "true" : "false");
+    if (nth_ok && partial_ok && top_ok)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    printf("----------------------------------------\n");
+
+    LongVector_destroy(&v);
+    LongVector_destroy(&ranged);
+    LongVector_destroy(&selected);
+    LongVector_destroy(&top);
+    LongVector_destroy(&quick);
+    LongVector_destroy(&merge);
+    LongVector_destroy(&heap);
+    LongVector_destroy(&bubble);
+    LongVector_destroy(&selection);
+    LongVector_destroy(&reference);
+}
+
+// ========================================
+// Test Group: double elements
+// ========================================
+void testDoubleVector()
+{
+    printf(YELLOW "--- DoubleVector (double) ---\n" RESET);
+
+    // Test `populate()`, `filter()`, `count()` and `contains()`
+    double data[] = {-1.5, 2.25, 0.0, 2.25, -3.0, 8.5};
+    DoubleVector v = DoubleVector_populate(data, 6);
+    DoubleVector_filter(&v, isPositive);
+    printf("Test: DoubleVector_filter(), _count() and _contains()\n");
+    printf("  Expected: length=3, count(2.25)=2, contains(-1.5)=false\n");
+    printf("  Actual:   length=%d, count(2.25)=%d, contains(-1.5)=%s\n", v.length, DoubleVector_count(&v, 2.25), DoubleVector_contains(&v, -1.5) ? "true" : "false");
+    if (v.length == 3 && DoubleVector_count(&v, 2.25) == 2 && !DoubleVector_contains(&v, -1.5))
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    printf("----------------------------------------\n");
+
+    // Test `join()`, `slice()` and `reverse()`
+    DoubleVector w = DoubleVector_populate(data, 2);
+    DoubleVector joined = DoubleVector_join(&v, &w);
+    DoubleVector sliced = DoubleVector_slice(&joined, 2, 5);
+    DoubleVector_reverse(&sliced);
+    printf("Test: DoubleVector_join(), _slice() and _reverse()\n");
+    printf("  Expected: [ 2.25 -1.5 8.5 ]\n");
+    printf("  Actual:   [ %g %g %g ] : %d\n", DoubleVector_get(&sliced, 0), DoubleVector_get(&sliced, 1), DoubleVector_get(&sliced, 2), sliced.length);
+    if (sliced.length == 3 && sliced.array[0] == 2.25 && sliced.array[1] == -1.5 && sliced.array[2] == 8.5)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    printf("----------------------------------------\n");
+
+    // Test `sum()`, `prod()`, `any()` and `all()`
+    DoubleVector zeros = DoubleVector_init(4);
+    DoubleVector_fill(&zeros, 3, 0.0);
+    printf("Test: DoubleVector_sum(), _prod(), _any() and _all()\n");
+    printf("  Expected: sum=13, prod=43.0312, any(zeros)=false, all(v)=true\n");
+    printf("  Actual:   sum=%g, prod=%g, any(zeros)=%s, all(v)=%s\n", DoubleVector_sum(&v), DoubleVector_prod(&v), DoubleVector_any(&zeros) ? "true" : "false", DoubleVector_all(&v) ? "true" : "false");
+    if (DoubleVector_sum(&v) == 13.0 && DoubleVector_prod(&v) == 43.03125 && !DoubleVector_any(&zeros) && DoubleVector_all(&v) && !DoubleVector_all(&zeros))
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    printf("----------------------------------------\n");
+
+    DoubleVector_destroy(&v);
+    DoubleVector_destroy(&zeros);
+    DoubleVector_destroy(&w);
+    DoubleVector_destroy(&joined);
+    DoubleVector_destroy(&sliced);
+}
+
+// ========================================
+// Test Group: struct elements with a custom comparator
+// ========================================
+void testEdgeVector()
+{
+    printf(YELLOW "--- EdgeVector (struct, custom comparator) ---\n" RESET);
+
+    // Test that `mergeSort()` is stable and `linearSearch()` matches by key
+    EdgeVector v = EdgeVector_init(4);
+    for (int i = 0; i < 200; i++)
+    {
+        Edge edge = {(i * 37) % 10, (double)i};
+        EdgeVector_append(&v, edge);
+    }
+    EdgeVector_mergeSort(&v);
+    bool stable = true;
+    for (int i = 1; i < v.length; i++)
+    {
+        if (v.array[i - 1].key > v.array[i].key || (v.array[i - 1].key == v.array[i].key && v.array[i - 1].weight > v.array[i].weight))
+        {
+            stable = false;
+        }
+    }
+    Edge probe = {7, 0.0};
+    int index = EdgeVector_linearSearch(&v, probe, 0);
+    printf("Test: EdgeVector_mergeSort() stability and _linearSearch()\n");
+    printf("  Expected: stable=true, first key 7 at index 140\n");
+    printf("  Actual:   stable=%s, first key 7 at index %d\n", stable ? "true" : "false", index);
+    if (stable && index == 140)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    printf("----------------------------------------\n");
+
+    // Test `quickSort()` and `binarySearch()` with the custom comparator
+    EdgeVector_shuffle(&v);
+    EdgeVector_quickSort(&v);
+    bool sorted = true;
+    for (int i = 1; i < v.length; i++)
+    {
+        if (v.array[i - 1].key > v.array[i].key)
+        {
+            sorted = false;
+        }
+    }
+    printf("Test: EdgeVector_quickSort() and _binarySearch()\n");
+    printf("  Expected: sorted=true, key 7 at index 140\n");
+    printf("  Actual:   sorted=%s, key 7 at index %d\n", sorted ? "true" : "false", EdgeVector_binarySearch(&v, probe, 0));
+    if (sorted && EdgeVector_binarySearch(&v, probe, 0) == 140)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    printf("----------------------------------------\n");
+
+    // Test `selectionSort()` and the searches that use the comparator or the key
+    EdgeVector_shuffle(&v);
+    EdgeVector_selectionSort(&v);
+    int ternary = EdgeVector_ternarySearch(&v, probe, 0);
+    int jump = EdgeVector_jumpSearch(&v, probe, 0);
+    int interpolation = EdgeVector_interpolationSearch(&v, probe, 0);
+    printf("Test: EdgeVector_selectionSort(), _ternarySearch(), _jumpSearch() and _interpolationSearch()\n");
+    printf("  Expected: key 7 found by all three\n");
+    printf("  Actual:   ternary=%d, jump=%d, interpolation=%d\n", ternary, jump, interpolation);
+    if (ternary >= 0 && v.array[ternary].key == 7 && jump >= 0 && v.array[jump].key == 7 && interpolation >= 0 && v.array[interpolation].key == 7)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    printf("----------------------------------------\n");
+
+    // Test `topK()` and `popAll()` with the custom comparator
+    EdgeVector top = EdgeVector_topK(&v, 20);
+    int removed = EdgeVector_popAll(&v, probe);
+    bool top_keys = top.length == 20;
+    for (int i = 0; i < top.length && top_keys; i++)
+    {
+        top_keys = top.array[i].key == 9;
+    }
+    printf("Test: EdgeVector_topK() and _popAll()\n");
+    printf("  Expected: 20 edges with key 9, removed=20, contains(key 7)=false\n");
+    printf("  Actual:   top=%s, removed=%d, contains(key 7)=%s\n", top_keys ? "true" : "false", removed, EdgeVector_contains(&v, probe) ? "true" : "false");
+    if (top_keys && removed == 20 && !EdgeVector_contains(&v, probe))
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    printf("----------------------------------------\n");
+
+    EdgeVector_destroy(&top);
+    EdgeVector_destroy(&v);
+}
@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#define VECTOR_THREADS
+#define VECTOR_MMAP
 #include "adt_Vector.h"
 
 #define GREEN "\x1b[32m"
@@ -66,6 +68,9 @@ bool isEven(int x)
     return x % 2 == 0;
 }
 
+PIPE_MAP_KERNEL(squareKernel, x, x * x)
+PIPE_FILTER_KERNEL(isEvenKernel, x, x % 2 == 0)
+
 // Main function to execute tests
 int main()
 {
@@ -213,6 +218,65 @@ void testCoreManagement()
     }
     printf("----------------------------------------\n");
 
+    // Test `openMapped()`, `appendMapped()` and `closeMapped()`, then reopen the file
+    const char *path = "test_Vector.mapped";
+    remove(path);
+    MappedVector mapped = openMapped(path, 4);
+    for (int i = 0; i < 100000; i++)
+    {
+        appendMapped(&mapped, (i * 7919) % 100003);
+    }
+    quickSort(&mapped.vector);
+    closeMapped(&mapped);
+    MappedVector reopened = openMapped(path, 1);
+    bool mapped_sorted = true;
+    for (int i = 1; i < reopened.vector.length; i++)
+    {
+        mapped_sorted = mapped_sorted && reopened.vector.array[i - 1] <= reopened.vector.array[i];
+    }
+    int mapped_index = branchlessSearch(&reopened.vector, 7919, 0);
+    printf("Test: openMapped(), appendMapped(), closeMapped() and reopening\n");
+    printf("  Expected: length=100000, sorted=true, 7919 found\n");
+    printf("  Actual:   length=%d, sorted=%s, 7919 %s\n", reopened.vector.length, mapped_sorted ? "true" : "false", mapped_index >= 0 ? "found" : "missing");
+    if (reopened.vector.length == 100000 && mapped_sorted && mapped_index >= 0 && reopened.vector.array[mapped_index] == 7919)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    closeMapped(&reopened);
+    remove(path);
+    printf("----------------------------------------\n");
+
+    // Test `appendMapped()` on a file whose header records zero capacity
+    FILE *empty_file = fopen(path, "wb");
+    unsigned char empty_header[MAPPED_VECTOR_HEADER] = {0};
+    unsigned int empty_magic = MAPPED_VECTOR_MAGIC;
+    memcpy(empty_header, &empty_magic, sizeof(empty_magic));
+    fwrite(empty_header, 1, sizeof(empty_header), empty_file);
+    fclose(empty_file);
+    MappedVector empty = openMapped(path, 1);
+    for (int i = 0; i < 3; i++)
+    {
+        appendMapped(&empty, i + 1);
+    }
+    printf("Test: appendMapped() on a zero-capacity file\n");
+    printf("  Expected: length=3, capacity=4, [1, 2, 3]\n");
+    printf("  Actual:   length=%d, capacity=%d, [%d, %d, %d]\n", empty.vector.length, empty.vector.capacity, empty.vector.array[0], empty.vector.array[1], empty.vector.array[2]);
+    if (empty.vector.length == 3 && empty.vector.capacity == 4 && empty.vector.array[0] == 1 && empty.vector.array[2] == 3)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    closeMapped(&empty);
+    remove(path);
+    printf("----------------------------------------\n");
+
     destroy(&v1);
 }
 
@@ -326,6 +390,63 @@ void testElementManipulation()
     }
     printf("----------------------------------------\n");
 
+    // Test `insertRange()`, including a block taken from the vector itself
+    printf("Test: insertRange()\n");
+    int block[] = {1, 2, 3};
+    insertRange(&v, block, 3, 1);
+    insertRange(&v, v.array, 2, v.length);
+    int expected_insert_data[] = {20, 1, 2, 3, 100, 40, 50, 20, 1};
+    Vector expected_insert = populate(expected_insert_data, 9);
+    printf("  Expected: [ 20 1 2 3 100 40 50 20 1 ]\n");
+    printf("  Actual:   ");
+    printVectorForTest(&v);
+    if (areVectorsEqual(&v, &expected_insert))
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    destroy(&expected_insert);
+    printf("----------------------------------------\n");
+
+    // Test `eraseRange()`, `popAll()` and `eraseIf()`
+    printf("Test: eraseRange(), popAll() and eraseIf()\n");
+    eraseRange(&v, 1, 4);
+    int popped = popAll(&v, 20);
+    int erased = eraseIf(&v, isEven);
+    printf("  Expected: [ 1 ], popAll removed 2, eraseIf removed 3\n");
+    printf("  Actual:   popAll removed %d, eraseIf removed %d, ", popped, erased);
+    printVectorForTest(&v);
+    if (v.length == 1 && v.array[0] == 1 && popped == 2 && erased == 3)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    printf("----------------------------------------\n");
+
+    // Test `reserve()` and `shrinkToFit()`
+    printf("Test: reserve() and shrinkToFit()\n");
+    reserve(&v, 1000);
+    int reserved_capacity = v.capacity;
+    shrinkToFit(&v);
+    printf("  Expected: capacity 1000 after reserve, 1 after shrinkToFit, [ 1 ]\n");
+    printf("  Actual:   capacity %d after reserve, %d after shrinkToFit, ", reserved_capacity, v.capacity);
+    printVectorForTest(&v);
+    if (reserved_capacity == 1000 && v.capacity == 1 && v.length == 1 && v.array[0] == 1)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    printf("----------------------------------------\n");
+
     destroy(&v);
 }
 
@@ -516,6 +637,50 @@ void testSearchAlgorithms()
     }
     printf("----------------------------------------\n");
 
+    // Test `branchlessSearch()` on a sorted vector
+    printf("Test: branchlessSearch()\n");
+    printf("  Searching for 20 in sorted vector. Expected index: 3\n");
+    int actual_branchless_search = branchlessSearch(&sorted_v, 20, 0);
+    printf("  Actual index: %d\n", actual_branchless_search);
+    if (actual_branchless_search == 3 && branchlessSearch(&sorted_v, 21, 0) == -1)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    printf("----------------------------------------\n");
+
+    // Test `buildIndex()`, `indexSearch()` and `indexSearchBatch()` with duplicates
+    Vector dup_v = populate((int[]){1, 3, 3, 3, 7, 9, 9, 12}, 8);
+    SearchIndex search_index = buildIndex(&dup_v);
+    int queries[] = {3, 9, 12, 1, 4, 0, 13};
+    int expected_results[] = {1, 5, 7, 0, -1, -1, -1};
+    int batch_results[7];
+    indexSearchBatch(&search_index, queries, batch_results, 7);
+    bool index_correct = true;
+    for (int i = 0; i < 7; i++)
+        if (indexSearch(&search_index, queries[i]) != expected_results[i] || batch_results[i] != expected_results[i])
+            index_correct = false;
+    printf("Test: buildIndex(), indexSearch() and indexSearchBatch()\n");
+    printf("  Searching for 3, 9, 12, 1, 4, 0, 13. Expected indices: 1 5 7 0 -1 -1 -1\n");
+    printf("  Actual indices: ");
+    for (int i = 0; i < 7; i++)
+        printf("%d ", batch_results[i]);
+    printf("\n");
+    if (index_correct)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    destroyIndex(&search_index);
+    destroy(&dup_v);
+    printf("----------------------------------------\n");
+
     destroy(&sorted_v);
     destroy(&unsorted_v);
 }
@@ -625,6 +790,35 @@ void testSortingAlgorithms()
     destroy(&v_radix);
     printf("----------------------------------------\n");
 
+    // Test `radixSort()` with negative keys on both digit widths
+    bool radix_sorted = true;
+    int radix_lengths[] = {1000, 200000};
+    for (int k = 0; k < 2; k++)
+    {
+        Vector v_signed = init(radix_lengths[k]);
+        random(&v_signed, radix_lengths[k], -1000000, 1000000);
+        append(&v_signed, -2147483647 - 1);
+        append(&v_signed, 2147483647);
+        Vector v_signed_expected = copy(&v_signed);
+        quickSort(&v_signed_expected);
+        radixSort(&v_signed);
+        radix_sorted = radix_sorted && areVectorsEqual(&v_signed, &v_signed_expected);
+        destroy(&v_signed);
+        destroy(&v_signed_expected);
+    }
+    printf("Test: radixSort() with negative keys\n");
+    printf("  Expected: 1000 and 200000 signed elements sorted, same as quickSort()\n");
+    printf("  Actual:   %s\n", radix_sorted ? "same as quickSort()" : "differs from quickSort()");
+    if (radix_sorted)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    printf("----------------------------------------\n");
+
     // Test `mergeSort()`
     Vector v_merge = populate(unsorted_data, 5);
     mergeSort(&v_merge);
@@ -644,6 +838,29 @@ void testSortingAlgorithms()
     destroy(&v_merge);
     printf("----------------------------------------\n");
 
+    // Test `mergeSortBuffered()` on runs longer than the insertion sort cutoff
+    Vector v_large = init(1000);
+    random(&v_large, 1000, -500, 500);
+    Vector v_large_expected = copy(&v_large);
+    heapSort(&v_large_expected);
+    int *scratch = (int *)malloc(v_large.length * sizeof(int));
+    mergeSortBuffered(&v_large, scratch);
+    printf("Test: mergeSortBuffered()\n");
+    printf("  Expected: 1000 random elements sorted with a caller-supplied buffer\n");
+    printf("  Actual:   %s\n", areVectorsEqual(&v_large, &v_large_expected) ? "sorted" : "not sorted");
+    if (areVectorsEqual(&v_large, &v_large_expected))
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    free(scratch);
+    destroy(&v_large);
+    destroy(&v_large_expected);
+    printf("----------------------------------------\n");
+
     // Test `quickSort()`
     Vector v_quick = populate(unsorted_data, 5);
     quickSort(&v_quick);
@@ -663,6 +880,85 @@ void testSortingAlgorithms()
     destroy(&v_quick);
     printf("----------------------------------------\n");
 
+    // Test `quickSort()` on inputs that used to go quadratic
+    int adversarial_length = 100000;
+    Vector v_ascending = init(adversarial_length);
+    Vector v_descending = init(adversarial_length);
+    Vector v_equal = init(adversarial_length);
+    for (int i = 0; i < adversarial_length; i++)
+    {
+        append(&v_ascending, i);
+        append(&v_descending, adversarial_length - i);
+    }
+    fill(&v_equal, adversarial_length, 7);
+    quickSort(&v_ascending);
+    quickSort(&v_descending);
+    quickSort(&v_equal);
+    bool adversarial_sorted = true;
+    for (int i = 1; i < adversarial_length; i++)
+        if (v_ascending.array[i - 1] > v_ascending.array[i] || v_descending.array[i - 1] > v_descending.array[i] || v_equal.array[i] != 7)
+            adversarial_sorted = false;
+    printf("Test: quickSort() on sorted, reversed and all-equal input\n");
+    printf("  Expected: %d elements of each sorted without stack overflow\n", adversarial_length);
+    printf("  Actual:   %s\n", adversarial_sorted ? "sorted" : "not sorted");
+    if (adversarial_sorted)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    destroy(&v_ascending);
+    destroy(&v_descending);
+    destroy(&v_equal);
+    printf("----------------------------------------\n");
+
+    // Test `parallelSort()` against `quickSort()`
+    Vector v_parallel = init(300000);
+    random(&v_parallel, 300000, -1000000, 1000000);
+    Vector v_parallel_expected = copy(&v_parallel);
+    quickSort(&v_parallel_expected);
+    parallelSort(&v_parallel, 4);
+    printf("Test: parallelSort()\n");
+    printf("  Expected: 300000 random elements sorted on 4 threads, same as quickSort()\n");
+    printf("  Actual:   %s\n", areVectorsEqual(&v_parallel, &v_parallel_expected) ? "same as quickSort()" : "differs from quickSort()");
+    if (areVectorsEqual(&v_parallel, &v_parallel_expected))
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    destroy(&v_parallel);
+    destroy(&v_parallel_expected);
+    printf("----------------------------------------\n");
+
+    // Test `parallelSort()` on duplicate-heavy input: a dominant value plus a small key range
+    Vector v_duplicates = init(300000);
+    for (int i = 0; i < 300000; i++)
+    {
+        append(&v_duplicates, i % 4 == 0 ? rand() % 5 : 42);
+    }
+    Vector v_duplicates_expected = copy(&v_duplicates);
+    quickSort(&v_duplicates_expected);
+    parallelSort(&v_duplicates, 4);
+    printf("Test: parallelSort() with duplicate keys\n");
+    printf("  Expected: 75%% of elements equal to 42, the rest in [0, 5), same as quickSort()\n");
+    printf("  Actual:   %s\n", areVectorsEqual(&v_duplicates, &v_duplicates_expected) ? "same as quickSort()" : "differs from quickSort()");
+    if (areVectorsEqual(&v_duplicates, &v_duplicates_expected))
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    destroy(&v_duplicates);
+    destroy(&v_duplicates_expected);
+    printf("----------------------------------------\n");
+
     // Test `heapSort()`
     Vector v_heap = populate(unsorted_data, 5);
     heapSort(&v_heap);
@@ -682,6 +978,79 @@ void testSortingAlgorithms()
     destroy(&v_heap);
     printf("----------------------------------------\n");
 
+    // Test selection on a duplicate-heavy vector against a fully sorted copy
+    Vector v_select_source = init(50000);
+    random(&v_select_source, 50000, -5000, 5000);
+    Vector v_select_sorted = copy(&v_select_source);
+    quickSort(&v_select_sorted);
+
+    // Test `nthElement()`
+    Vector v_nth = copy(&v_select_source);
+    int nth = 12345;
+    nthElement(&v_nth, nth);
+    bool nth_split = true;
+    for (int i = 0; i < v_nth.length; i++)
+    {
+        nth_split = nth_split && (i < nth ? v_nth.array[i] <= v_nth.array[nth] : v_nth.array[i] >= v_nth.array[nth]);
+    }
+    printf("Test: nthElement()\n");
+    printf("  Expected: element %d = %d, split around it\n", nth, v_select_sorted.array[nth]);
+    printf("  Actual:   element %d = %d, split=%s\n", nth, v_nth.array[nth], nth_split ? "true" : "false");
+    if (v_nth.array[nth] == v_select_sorted.array[nth] && nth_split)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    destroy(&v_nth);
+    printf("----------------------------------------\n");
+
+    // Test `partialSort()`
+    Vector v_partial = copy(&v_select_source);
+    partialSort(&v_partial, 100);
+    Vector v_partial_prefix = slice(&v_partial, 0, 100);
+    Vector v_sorted_prefix = slice(&v_select_sorted, 0, 100);
+    printf("Test: partialSort() with k=100\n");
+    printf("  Expected: first 100 match the sorted vector\n");
+    printf("  Actual:   first 100 %s the sorted vector\n", areVectorsEqual(&v_partial_prefix, &v_sorted_prefix) ? "match" : "differ from");
+    if (areVectorsEqual(&v_partial_prefix, &v_sorted_prefix))
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    destroy(&v_partial);
+    destroy(&v_partial_prefix);
+    destroy(&v_sorted_prefix);
+    printf("----------------------------------------\n");
+
+    // Test `topK()`
+    Vector v_top = topK(&v_select_source, 10);
+    Vector v_expected_top = slice(&v_select_sorted, v_select_sorted.length - 10, v_select_sorted.length);
+    reverse(&v_expected_top);
+    printf("Test: topK() with k=10\n");
+    printf("  Expected: ");
+    printVectorForTest(&v_expected_top);
+    printf("  Actual:   ");
+    printVectorForTest(&v_top);
+    if (areVectorsEqual(&v_top, &v_expected_top))
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    destroy(&v_top);
+    destroy(&v_expected_top);
+    destroy(&v_select_source);
+    destroy(&v_select_sorted);
+    printf("----------------------------------------\n");
+
     destroy(&expected_v);
 }
 
@@ -794,5 +1163,121 @@ void testFunctionalProgrammingInspired()
     destroy(&v_count_contains);
     printf("----------------------------------------\n");
 
+    // Test reductions on a vector long enough to take the SIMD paths
+    Vector v_reduce = init(1003);
+    random(&v_reduce, 1003, -100, 100);
+    set(&v_reduce, 2000000000, 1001);
+    set(&v_reduce, 2000000000, 1002);
+    long long expected_sum64 = 0;
+    int expected_max = v_reduce.array[0], expected_min = v_reduce.array[0], expected_count = 0;
+    for (int i = 0; i < v_reduce.length; i++)
+    {
+        expected_sum64 += v_reduce.array[i];
+        expected_max = v_reduce.array[i] > expected_max ? v_reduce.array[i] : expected_max;
+        expected_min = v_reduce.array[i] < expected_min ? v_reduce.array[i] : expected_min;
+        expected_count += v_reduce.array[i] == v_reduce.array[500];
+    }
+    printf("Test: sum64(), max(), min(), count() and contains() on 1003 elements\n");
+    printf("  Expected: sum64=%lld, max=%d, min=%d, count=%d, contains=true\n", expected_sum64, expected_max, expected_min, expected_count);
+    printf("  Actual:   sum64=%lld, max=%d, min=%d, count=%d, contains=%s\n", sum64(&v_reduce), max(&v_reduce), min(&v_reduce), count(&v_reduce, v_reduce.array[500]), contains(&v_reduce, v_reduce.array[1000]) ? "true" : "false");
+    if (sum64(&v_reduce) == expected_sum64 && max(&v_reduce) == expected_max && min(&v_reduce) == expected_min && count(&v_reduce, v_reduce.array[500]) == expected_count && contains(&v_reduce, v_reduce.array[1000]))
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    destroy(&v_reduce);
+    printf("----------------------------------------\n");
+
+    // Test `sum()` and `prod()` against a scalar loop on lengths that leave a SIMD tail, with values that overflow
+    bool reductions_agree = true;
+    int mismatch_length = -1;
+    for (int length = 1; length <= 1003 && reductions_agree; length += length < 70 ? 1 : 311)
+    {
+        Vector v_wrap = init(length);
+        for (int i = 0; i < length; i++)
+            append(&v_wrap, i % 5 == 4 ? INT_MAX - i : (i % 2 ? -3 - 2 * i : 2 * i + 1)); // odd factors keep the product non-zero
+        unsigned int expected_wrapped_sum = 0, expected_wrapped_prod = 1;
+        for (int i = 0; i < length; i++)
+        {
+            expected_wrapped_sum += (unsigned int)v_wrap.array[i];
+            expected_wrapped_prod *= (unsigned int)v_wrap.array[i];
+        }
+        reductions_agree = sum(&v_wrap) == (int)expected_wrapped_sum && prod(&v_wrap) == (int)expected_wrapped_prod &&
+                           __sumScalar__(v_wrap.array, length) == (int)expected_wrapped_sum && __prodScalar__(v_wrap.array, length) == (int)expected_wrapped_prod;
+#ifdef VECTOR_SIMD
+        if (__simdLevel__() >= 1)
+            reductions_agree = reductions_agree && __sumSSE2__(v_wrap.array, length) == (int)expected_wrapped_sum && __prodSSE2__(v_wrap.array, length) == (int)expected_wrapped_prod;
+        if (__simdLevel__() == 2)
+            reductions_agree = reductions_agree && __sumAVX2__(v_wrap.array, length) == (int)expected_wrapped_sum && __prodAVX2__(v_wrap.array, length) == (int)expected_wrapped_prod;
+#endif
+        if (!reductions_agree)
+            mismatch_length = length;
+        destroy(&v_wrap);
+    }
+    printf("Test: sum() and prod() on every SIMD path, lengths 1..69 plus longer ragged lengths, with overflow\n");
+    printf("  Expected: every kernel matches the wrapped scalar loop\n");
+    printf("  Actual:   %s\n", reductions_agree ? "all match" : "mismatch");
+    if (reductions_agree)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+        printf("  First mismatching length: %d\n", mismatch_length);
+    }
+    printf("----------------------------------------\n");
+
+    // Test a fused pipeline against the eager map() and filter()
+    Vector v_pipe = init(200000);
+    random(&v_pipe, 200000, -1000, 1000);
+    Vector v_eager = copy(&v_pipe);
+    map(&v_eager, square);
+    filter(&v_eager, isEven);
+    Pipeline pipe = pipeline(&v_pipe);
+    pipeMap(&pipe, square);
+    pipeFilter(&pipe, isEven);
+    Vector v_collected = pipeCollect(&pipe);
+    pipeThreads(&pipe, 4);
+    Vector v_threaded = pipeCollect(&pipe);
+    printf("Test: pipeline() with pipeMap(), pipeFilter() and pipeCollect() on 200000 elements\n");
+    printf("  Expected: length=%d, sum=%lld, same on 4 threads\n", v_eager.length, sum64(&v_eager));
+    printf("  Actual:   length=%d, sum=%lld, threaded length=%d, threaded sum=%lld\n", v_collected.length, pipeSum(&pipe), v_threaded.length, sum64(&v_threaded));
+    if (areVectorsEqual(&v_eager, &v_collected) && areVectorsEqual(&v_eager, &v_threaded) && pipeSum(&pipe) == sum64(&v_eager) && pipeCount(&pipe) == v_eager.length)
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    destroy(&v_collected);
+    destroy(&v_threaded);
+    printf("----------------------------------------\n");
+
+    // Test a pipeline built from inlined chunk kernels
+    Pipeline kernels = pipeline(&v_pipe);
+    pipeKernel(&kernels, squareKernel);
+    pipeKernel(&kernels, isEvenKernel);
+    Vector v_kernels = pipeCollect(&kernels);
+    printf("Test: pipeKernel() with PIPE_MAP_KERNEL and PIPE_FILTER_KERNEL\n");
+    printf("  Expected: length=%d, sum=%lld\n", v_eager.length, sum64(&v_eager));
+    printf("  Actual:   length=%d, sum=%lld\n", v_kernels.length, sum64(&v_kernels));
+    if (areVectorsEqual(&v_eager, &v_kernels))
+    {
+        printf("  Result: " GREEN "Passed\n" RESET);
+    }
+    else
+    {
+        printf("  Result: " RED "Failed\n" RESET);
+    }
+    destroy(&v_kernels);
+    destroy(&v_eager);
+    destroy(&v_pipe);
+    printf("----------------------------------------\n");
+
     destroy(&v);
 }
\ No newline at end of file